@@ -10,6 +10,8 @@ namespace seedengine {
      //TODO: Control actor loading, add ability to write to file
 
     class Actor; // Forward declare Actor
+    class TickAccess; // Forward declare TickAccess
+    class TickScheduler; // Forward declare TickScheduler
 
     /**
      * @brief Properties of an Actor.
@@ -21,6 +23,7 @@ namespace seedengine {
     class ActorProperties {
 
         friend class Actor;
+        friend class TickScheduler;
 
     public:
         /**
@@ -66,6 +69,16 @@ namespace seedengine {
          */
         virtual void update() = 0;
 
+        /**
+         * @brief Declares the data that update() reads and writes.
+         * @details Read once per component type by the #TickScheduler, which runs types that do
+         *          not conflict in parallel. Types that declare nothing run apart from every
+         *          other type.
+         *
+         * @param access The access of this component type.
+         */
+        virtual void declareAccess(TickAccess& access) const {}
+
     protected:
         /**
          * @brief The actor that this component is attached to.
@@ -87,14 +100,16 @@ namespace seedengine {
      */
     class Actor : public Object {
 
+        friend class TickScheduler;
+
     public:
         /**
          * @brief Constructs a new actor.
          *
-         * @param transform The transfrom of this actor.
+         * @param transform The transform of this actor.
          * @param properties The properties of this actor.
          */
-        Actor(const Transform& transfrom = Transform(),
+        Actor(const Transform& transform = Transform(),
             const ActorProperties& properties = ActorProperties());
 
         /**
@@ -111,16 +126,37 @@ namespace seedengine {
          */
         Property<bool> active;
 
+        /**
+         * @brief Returns the transform of this actor before the last tick.
+         *
+         * @return const Transform& The previous transform.
+         */
+        inline const Transform& previousTransform() const { return previous_transform_; }
+        /**
+         * @brief Returns the transform of this actor between the last two ticks, so rendering
+         *        at a different rate than the ticks stays smooth.
+         *
+         * @param alpha How far past the previous tick to place the actor, from 0 to 1.
+         *              Usually the interpolation alpha of the render snapshot.
+         * @return Transform The interpolated transform.
+         */
+        inline Transform interpolatedTransform(float alpha) const {
+            return Transform::interpolate(previous_transform_, transform(), alpha);
+        }
+
         /**
          * @brief Adds a Component of type T to this Actor.
          *
          * @tparam T The Component class to add.
+         * @return T& The added Component.
          */
         template <class T>
-        void addComponent() {
+        T& addComponent() {
             // Ensure that T is a Component
             static_assert(std::is_base_of<Component, T>::value, "T is not of type Component.");
-            components_.push_back(std::make_unique<T>(this));
+            T* component = new T(*this);
+            components_.push_back(std::unique_ptr<Component>(component));
+            return *component;
         }
 
         /**
@@ -133,11 +169,11 @@ namespace seedengine {
          *         none are found.
          */
         template <class T>
-        std::unique_ptr<T> getComponent() {
+        T* getComponent() {
             // Ensure that T is a Component
             static_assert(std::is_base_of<Component, T>::value, "T is not of type Component.");
             for (int i = 0; i < components_.size(); i++) {
-                if (dynamic_cast<std::unique_ptr<T>>(components_.at(i)) != nullptr) return components_.at(i);
+                if (T* component = dynamic_cast<T*>(components_.at(i).get())) return component;
                 else continue;
             }
             return nullptr;
@@ -153,12 +189,12 @@ namespace seedengine {
          *         an empty list if none are found.
          */
         template <class T>
-        std::vector<std::unique_ptr<T>> getComponents() {
+        std::vector<T*> getComponents() {
             // Ensure that T is a Component
             static_assert(std::is_base_of<Component, T>::value, "T is not of type Component.");
-            std::vector<std::unique_ptr<T>> ptrs;
+            std::vector<T*> ptrs;
             for (int i = 0; i < components_.size(); i++) {
-                if (dynamic_cast<std::unique_ptr<T>>(components_.at(i)) != nullptr) ptrs.push_back(components_.at(i));
+                if (T* component = dynamic_cast<T*>(components_.at(i).get())) ptrs.push_back(component);
                 else continue;
             }
             return ptrs;
@@ -181,6 +217,10 @@ namespace seedengine {
          * @brief The components of this actor.
          */
         std::vector<std::unique_ptr<Component>> components_;
+        /**
+         * @brief The transform of this actor before the last tick, stored by the #TickScheduler.
+         */
+        Transform previous_transform_;
 
     private:
 
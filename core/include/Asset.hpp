@@ -2,6 +2,8 @@
 #define SEEDENGINE_INCLUDE_ASSET_H_
 
 #include "Core.hpp"
+#include "Manifest.hpp"
+#include "Profile.hpp"
 
 namespace seedengine {
 
@@ -14,6 +16,28 @@ namespace seedengine {
         template <class AssetType>\
         friend class AssetLibrary;
 
+    /** How much of an asset's data is kept in CPU memory once it has been loaded and uploaded. */
+    enum class ResidencyPolicy : unsigned int {
+        /** The full CPU copy is kept. */
+        KEEP    = 0,
+        /** The CPU copy is discarded after upload. */
+        DISCARD = 1,
+        /** Only a compact CPU copy, such as bounds and a collision proxy, is kept after upload. */
+        COMPACT = 2
+    };
+
+    /**
+     * @brief Converts a configuration string ("keep", "discard" or "compact") to a residency policy.
+     * 
+     * @param name The name of the policy.
+     * @return ResidencyPolicy The policy, or KEEP if the name is not recognized.
+     */
+    inline ResidencyPolicy residencyFromString(const string& name) {
+        if (name == "discard") return ResidencyPolicy::DISCARD;
+        if (name == "compact") return ResidencyPolicy::COMPACT;
+        return ResidencyPolicy::KEEP;
+    }
+
     /**
      * @brief An asset with data type T.
      * @details A data asset that is loaded from the disk on demand. The asset is
@@ -38,18 +62,65 @@ namespace seedengine {
         inline string path() { return path_; }
         
         /**
-         * @brief Gets the data of this asset.
+         * @brief Gets the full CPU copy of this asset's data.
+         * @details If the residency policy has released the CPU copy, it is reloaded from
+         *          the disk and kept until releaseData() is called.
          * 
          * @return The data of this asset.
          */
-        inline T* data() { return data_; }
+        inline T* data() {
+            if (loaded_ && !complete_) reload();
+            return data_;
+        }
+
+        /**
+         * @brief Gets the data of this asset currently held in CPU memory without reloading it.
+         * 
+         * @return The resident data of this asset. This may be a compact copy or nullptr.
+         */
+        inline T* residentData() { return data_; }
 
         /**
          * @brief Is this asset loaded into memory?
          * 
          * @return True if the asset has been loaded.
          */
-        inline bool isLoaded() { return data_ != nullptr; }
+        inline bool isLoaded() const { return loaded_; }
+
+        /**
+         * @brief Gets the CPU residency policy of this asset.
+         * 
+         * @return ResidencyPolicy The residency policy of this asset.
+         */
+        inline ResidencyPolicy residency() const { return residency_; }
+        /**
+         * @brief Sets the CPU residency policy of this asset. The policy is applied
+         *        immediately if the asset is already loaded.
+         * 
+         * @param policy The new residency policy.
+         */
+        inline void setResidency(ResidencyPolicy policy) {
+            residency_ = policy;
+            releaseData();
+        }
+
+        /** Applies the residency policy to a CPU copy restored by data(). */
+        inline void releaseData() {
+            if (loaded_ && complete_ && residency_ != ResidencyPolicy::KEEP) release();
+        }
+
+        /**
+         * @brief Gets the number of bytes of CPU memory held by this asset.
+         * 
+         * @return size_t The number of bytes held.
+         */
+        virtual size_t residentBytes() const { return 0; }
+        /**
+         * @brief Gets the number of bytes of the full CPU copy of this asset.
+         * 
+         * @return size_t The number of bytes of the full copy.
+         */
+        inline size_t fullBytes() const { return loaded_ ? full_bytes_ : 0; }
 
     protected:
 
@@ -61,25 +132,49 @@ namespace seedengine {
          * @brief The data stored in this asset.
          */
         T* data_;
+        /** Is this asset loaded? */
+        bool loaded_ = false;
+        /** Is the full CPU copy of this asset resident? */
+        bool complete_ = false;
+        /** The size of the full CPU copy of this asset in bytes. */
+        size_t full_bytes_ = 0;
+        /** The CPU residency policy of this asset. */
+        ResidencyPolicy residency_ = ResidencyPolicy::KEEP;
 
         /**
          * @brief Construct a new Asset object from data in a file.
+         * @details The existence check is answered by the #AssetManifest when the path is
+         *          covered by it, so the file is not opened until the asset is loaded.
          * 
          * @param path The path to the asset to be loaded.
          */
         Asset(const string& path) : path_(path), data_(nullptr) {
-            std::ifstream test_path(path);
-            if (!test_path) throw std::invalid_argument("Asset path '" + path + "' not found.");
+            if (!AssetManifest::exists(path)) throw std::invalid_argument("Asset path '" + path + "' not found.");
         }
 
         /**
          * @brief Loads this asset into memory.
          */
         virtual void load() = 0;
+        /**
+         * @brief Loads this asset from bytes already read from its file, such as by a
+         *        stream source. Assets that cannot parse from memory read the file instead.
+         *
+         * @param bytes The contents of the file, or empty to read the file.
+         */
+        virtual void load(const std::vector<char>& bytes) { load(); }
         /**
          * @brief Unloads this asset from memory.
          */
         virtual void unload() = 0;
+        /**
+         * @brief Reloads the full CPU copy of this asset without uploading it again.
+         */
+        virtual void reload() {}
+        /**
+         * @brief Releases the CPU copy of this asset according to its residency policy.
+         */
+        virtual void release() {}
 
     };
 
@@ -134,7 +229,9 @@ namespace seedengine {
          */
         template <typename = typename std::enable_if<is_base_of_t<Asset, T>::value>::type>
         static std::shared_ptr<T> prepare(const string& path) {
-            atlas_.insert(std::pair<string, std::shared_ptr<T>>(path, std::shared_ptr<T>(new T(path))));
+            std::shared_ptr<T> asset(new T(path));
+            asset->residency_ = default_residency_;
+            atlas_.insert(std::pair<string, std::shared_ptr<T>>(path, asset));
             return atlas_.at(path);
         }
 
@@ -149,6 +246,7 @@ namespace seedengine {
          */
         template <typename = typename std::enable_if<is_base_of_t<Asset, T>::value>::type>
         static std::shared_ptr<T> load(const string& path) {
+            ENGINE_PROFILE_SCOPE("AssetLibrary::load");
             if (atlas_.find(path) != atlas_.end()) {
                 if (!atlas_.at(path)->isLoaded()) atlas_.at(path)->load();
             }
@@ -158,6 +256,60 @@ namespace seedengine {
             return atlas_.at(path);
         }
 
+        /**
+         * @brief Loads an asset into memory from bytes already read from its file.
+         * @details If the asset is already loaded, nothing happens. If the asset has not yet been
+         *          added to the library, it is prepared and loaded.
+         * 
+         * @param path The path to the asset.
+         * @param bytes The contents of the file, or empty to read the file.
+         * 
+         * @return A pointer to the loaded asset.
+         */
+        template <typename = typename std::enable_if<is_base_of_t<Asset, T>::value>::type>
+        static std::shared_ptr<T> load(const string& path, const std::vector<char>& bytes) {
+            ENGINE_PROFILE_SCOPE("AssetLibrary::load");
+            auto it = atlas_.find(path);
+            std::shared_ptr<T> asset = (it != atlas_.end()) ? it->second : prepare(path);
+            if (!asset->isLoaded()) asset->load(bytes);
+            return asset;
+        }
+
+        /**
+         * @brief Loads an asset from bytes already read from its file without adding it to the library.
+         * @details Only the new asset is touched, so it may be loaded on another thread, such as the
+         *          render thread of a pipelined run. Add it with adopt() on the thread that owns the library.
+         * 
+         * @param path The path to the asset.
+         * @param bytes The contents of the file, or empty to read the file.
+         * 
+         * @return A pointer to the loaded asset.
+         */
+        template <typename = typename std::enable_if<is_base_of_t<Asset, T>::value>::type>
+        static std::shared_ptr<T> loadDetached(const string& path, const std::vector<char>& bytes) {
+            ENGINE_PROFILE_SCOPE("AssetLibrary::load");
+            std::shared_ptr<T> asset(new T(path));
+            asset->residency_ = default_residency_;
+            asset->load(bytes);
+            return asset;
+        }
+
+        /**
+         * @brief Adds an asset loaded by loadDetached() to the library.
+         * @details An asset already loaded under the same path is kept, and the passed asset is dropped.
+         * 
+         * @param asset The asset to add.
+         * 
+         * @return A pointer to the asset in the library.
+         */
+        template <typename = typename std::enable_if<is_base_of_t<Asset, T>::value>::type>
+        static std::shared_ptr<T> adopt(const std::shared_ptr<T>& asset) {
+            auto it = atlas_.find(asset->path_);
+            if (it != atlas_.end() && it->second->isLoaded()) return it->second;
+            atlas_[asset->path_] = asset;
+            return asset;
+        }
+
         /**
          * @brief Unloads an asset from memory.
          * @details Unloads an asset from memory. If the asset is already unloaded, nothing happens.
@@ -199,17 +351,58 @@ namespace seedengine {
             }
         }
 
+        /**
+         * @brief Sets the residency policy given to assets prepared by this library.
+         * 
+         * @param policy The default residency policy.
+         */
+        static inline void setDefaultResidency(ResidencyPolicy policy) {
+            default_residency_ = policy;
+        }
+
+        /**
+         * @brief Gets the number of bytes of CPU memory held by all loaded assets in the library.
+         * 
+         * @return size_t The number of bytes held.
+         */
+        static inline size_t residentBytes() {
+            size_t total = 0;
+            for (auto const& x : atlas_) {
+                if (x.second->isLoaded()) total += x.second->residentBytes();
+            }
+            return total;
+        }
+
+        /**
+         * @brief Gets the number of bytes of CPU memory released by residency policies.
+         * 
+         * @return size_t The number of bytes saved compared to keeping every full CPU copy.
+         */
+        static inline size_t savedBytes() {
+            size_t total = 0;
+            for (auto const& x : atlas_) {
+                size_t full = x.second->fullBytes();
+                size_t resident = x.second->isLoaded() ? x.second->residentBytes() : 0;
+                if (full > resident) total += full - resident;
+            }
+            return total;
+        }
+
     private:
 
         /**
          * @brief A map of all assets in memory to their path reference.
          */
         static std::unordered_map<string, std::shared_ptr<T>> atlas_;
+        /** The residency policy given to newly prepared assets. */
+        static ResidencyPolicy default_residency_;
 
     };
 
     template <class T>
     std::unordered_map<string, std::shared_ptr<T>> AssetLibrary<T>::atlas_ = std::unordered_map<string, std::shared_ptr<T>>();
+    template <class T>
+    ResidencyPolicy AssetLibrary<T>::default_residency_ = ResidencyPolicy::KEEP;
 
 }
 
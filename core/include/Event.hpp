@@ -3,6 +3,13 @@
 
 #include "Core.hpp"
 #include "Input.hpp"
+#include "Memory.hpp"
+#include "Profile.hpp"
+#include "Stats.hpp"
+#include "Timer.hpp"
+
+#include <atomic>
+#include <cassert>
 
 namespace seedengine {
 
@@ -28,6 +35,16 @@ namespace seedengine {
         CONTROLLER    = PERIPHERAL | (PERIPHERAL << 3)
     };
 
+    /** How repeated pushes of an event are combined while it waits in the buffer. */
+    enum class EventCoalescing : unsigned int {
+        /** Every push is queued and run separately. */
+        NONE        = 0,
+        /** A push replaces the pending event of the same kind. */
+        KEEP_LATEST = 1,
+        /** A push is added into the pending event of the same kind with accumulate(). */
+        ACCUMULATE  = 2
+    };
+
     /**
      * @brief An event to be processed by the program.
      * @details
@@ -74,6 +91,18 @@ namespace seedengine {
             return ((static_cast<unsigned int>(getEventType()) & uint_type) == uint_type);
         }
 
+        /**
+         * @brief Can a newer event of the same kind be combined into this one? Event classes
+         *        with a source, such as a window, hide this to only combine events of one source.
+         *
+         * @param other The newer event.
+         * @return true If the events can be combined.
+         */
+        inline bool coalescesWith(const Event& other) const { return true; }
+
+        /** How repeated pushes of this event are combined. Event classes hide this to opt in. */
+        static const EventCoalescing COALESCING = EventCoalescing::NONE;
+
     protected:
 
         /** Has this event been handled? */
@@ -81,24 +110,605 @@ namespace seedengine {
 
     };
 
+    /**
+     * @brief A queue of events stored in a linear arena.
+     * @details Events are constructed in place in fixed-size pages and referenced by a list of
+     *          pointers in push order. Dispatched events are destroyed individually, and the pages
+     *          are rewound in bulk once the queue is empty. Pages and list capacity are kept for
+     *          reuse, so pushing and popping do not allocate once the queue has reached its
+     *          steady-state size.
+     */
+    class EventQueue final {
+
+    public:
+
+        /** The size of each arena page in bytes. */
+        static const size_t PAGE_SIZE = 16 * 1024;
+
+        /** Constructs a new Event Queue. */
+        EventQueue() = default;
+        /** Destroys all queued events and frees the arena. */
+        ~EventQueue();
+
+        EventQueue(const EventQueue&) = delete;
+        EventQueue& operator=(const EventQueue&) = delete;
+
+        /**
+         * @brief Constructs an event at the back of the queue.
+         *
+         * @tparam E The event type to construct.
+         * @tparam Args The variadic parameter pack used to construct the Event.
+         * @param args The arguments used when constructing the Event of type E.
+         * @return E* The queued event. It is valid until it is destroyed.
+         */
+        template <class E, class... Args>
+        E* emplace(Args&&... args) {
+            static_assert(sizeof(E) <= PAGE_SIZE, "Event type is larger than an event arena page.");
+            void* memory = allocate(sizeof(E), alignof(E));
+            E* event = new (memory) E(std::forward<Args>(args)...);
+            events_.push_back(event);
+            return event;
+        }
+
+        /**
+         * @brief Returns the event at a position in the queue.
+         *
+         * @param i The position of the event.
+         * @return Event* The event, or nullptr if it has been destroyed.
+         */
+        inline Event* at(size_t i) const { return events_[i]; }
+
+        /**
+         * @brief Destroys the event at a position in the queue. Its memory is reclaimed by compact().
+         *
+         * @param i The position of the event.
+         */
+        void destroy(size_t i);
+
+        /**
+         * @brief Removes destroyed events from the queue, preserving the order of the rest, and
+         *        rewinds the arena if no events remain.
+         */
+        void compact();
+
+        /** Destroys all events and rewinds the arena. */
+        void clear();
+
+        /**
+         * @brief Returns the number of events in the queue, including destroyed ones not yet compacted.
+         *
+         * @return size_t The number of events.
+         */
+        inline size_t size() const { return events_.size(); }
+        /**
+         * @brief Is this queue empty?
+         *
+         * @return true If no events are queued.
+         */
+        inline bool empty() const { return events_.empty(); }
+        /**
+         * @brief Returns the number of arena pages allocated by this queue.
+         *
+         * @return size_t The number of pages.
+         */
+        inline size_t pages() const { return pages_.size(); }
+        /**
+         * @brief Returns a counter that changes whenever an event in this queue is destroyed or
+         *        the queue is sealed.
+         *
+         * @return uint64_t The generation of the queue.
+         */
+        inline uint64_t generation() const { return generation_; }
+        /**
+         * @brief Starts a new generation, so later pushes are not combined with the queued events,
+         *        such as while they are being run.
+         */
+        inline void seal() { generation_++; }
+
+    private:
+
+        /**
+         * @brief Reserves memory for an event in the arena.
+         *
+         * @param size The size of the event.
+         * @param align The alignment of the event.
+         * @return void* The reserved memory.
+         */
+        void* allocate(size_t size, size_t align);
+
+        /** The arena pages. */
+        TrackedVector<std::unique_ptr<unsigned char[], TrackedDeleter>, MemoryTag::EVENTS> pages_;
+        /** The index of the page being filled. */
+        size_t page_ = 0;
+        /** The offset of the next free byte in the page being filled. */
+        size_t offset_ = 0;
+        /** The queued events in push order. */
+        TrackedVector<Event*, MemoryTag::EVENTS> events_;
+        /** The number of events destroyed by this queue and times it was sealed. */
+        uint64_t generation_ = 0;
+
+    };
+
+    /**
+     * @brief A bounded lock-free queue that carries events from any number of producer threads
+     *        to a single consumer thread.
+     * @details Each cell holds an event constructed in place along with the function used to
+     *          consume it. Producers claim cells with a compare-and-swap on the enqueue position
+     *          and publish them through a per-cell sequence number, so a producer never waits on
+     *          another producer's construction. Only the consumer thread may call drain().
+     */
+    class EventChannel final {
+
+    public:
+
+        /** The number of cells in the channel. Must be a power of two. */
+        static const size_t CAPACITY = 4096;
+        /** The largest event that fits in a cell. */
+        static const size_t CELL_SIZE = 64;
+
+        /** A function that consumes the event stored in a cell and destroys it. */
+        typedef void (*ConsumeFunction)(void*);
+
+        /** Constructs a new, empty Event Channel. */
+        EventChannel();
+
+        EventChannel(const EventChannel&) = delete;
+        EventChannel& operator=(const EventChannel&) = delete;
+
+        /**
+         * @brief Constructs an event in the channel if a cell is free. Safe to call from any thread.
+         *
+         * @tparam E The event type to construct.
+         * @tparam Args The variadic parameter pack used to construct the Event.
+         * @param consume The function the consumer uses to take the event.
+         * @param args The arguments used when constructing the Event of type E.
+         * @return true If the event was queued.
+         * @return false If the channel is full.
+         */
+        template <class E, class... Args>
+        bool tryEmplace(ConsumeFunction consume, Args&&... args) {
+            static_assert(sizeof(E) <= CELL_SIZE, "Event type is larger than an event channel cell.");
+            static_assert(alignof(E) <= alignof(std::max_align_t), "Event type is over-aligned.");
+            Cell* cell = claim();
+            if (cell == nullptr) return false;
+            new (cell->storage) E(std::forward<Args>(args)...);
+            cell->consume = consume;
+            cell->sequence.store(cell->claimed + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Constructs an event in the channel, yielding while the channel is full. Safe to
+         *        call from any thread except the consumer.
+         *
+         * @tparam E The event type to construct.
+         * @tparam Args The variadic parameter pack used to construct the Event.
+         * @param consume The function the consumer uses to take the event.
+         * @param args The arguments used when constructing the Event of type E.
+         */
+        template <class E, class... Args>
+        void emplace(ConsumeFunction consume, Args&&... args) {
+            if (tryEmplace<E>(consume, std::forward<Args>(args)...)) return;
+            waits_.fetch_add(1, std::memory_order_relaxed);
+            while (!tryEmplace<E>(consume, std::forward<Args>(args)...)) std::this_thread::yield();
+        }
+
+        /**
+         * @brief Consumes every published event in order. Only the consumer thread may call this.
+         *
+         * @return size_t The number of events consumed.
+         */
+        size_t drain();
+
+        /**
+         * @brief Returns the number of times a producer found the channel full.
+         *
+         * @return size_t The number of backpressure waits.
+         */
+        inline size_t waits() const { return waits_.load(std::memory_order_relaxed); }
+
+    private:
+
+        /** A single slot of the channel. */
+        struct Cell {
+            /** The position this cell is ready for. Equal to the position + 1 once published. */
+            std::atomic<size_t> sequence;
+            /** The position the cell was claimed for. */
+            size_t claimed;
+            /** The function that consumes the stored event. */
+            ConsumeFunction consume;
+            /** The storage of the event. */
+            alignas(std::max_align_t) unsigned char storage[CELL_SIZE];
+        };
+
+        /**
+         * @brief Claims the next free cell for a producer.
+         *
+         * @return Cell* The claimed cell, or nullptr if the channel is full.
+         */
+        Cell* claim();
+
+        /** The cells of the channel. */
+        std::unique_ptr<Cell[]> cells_;
+        /** The next position to be claimed by a producer. */
+        alignas(64) std::atomic<size_t> enqueue_pos_;
+        /** The next position to be consumed. Only used by the consumer. */
+        alignas(64) size_t dequeue_pos_ = 0;
+        /** The number of times a producer found the channel full. */
+        std::atomic<size_t> waits_;
+
+    };
+
+    /**
+     * @brief A function deligate that recieves an event, stored without heap allocation.
+     * @details The callable is stored inline in a fixed-size buffer, so binding a lambda never
+     *          allocates. Callables that do not fit the buffer fail to compile; capture a pointer
+     *          to larger state instead.
+     */
+    class EventDeligate final {
+
+    public:
+
+        /** The largest callable that can be stored. */
+        static const size_t STORAGE_SIZE = 6 * sizeof(void*);
+
+        /** Constructs an empty Event Deligate. */
+        EventDeligate() {}
+
+        /**
+         * @brief Constructs an Event Deligate holding a callable.
+         *
+         * @tparam F The type of the callable. It must be callable with an Event&.
+         * @param function The callable to store.
+         */
+        template <
+            class F,
+            typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, EventDeligate>::value>::type
+        >
+        EventDeligate(F&& function) {
+            typedef typename std::decay<F>::type Function;
+            static_assert(sizeof(Function) <= STORAGE_SIZE, "Deligate callable is too large to be stored inline.");
+            static_assert(alignof(Function) <= alignof(std::max_align_t), "Deligate callable is over-aligned.");
+            new (storage_) Function(std::forward<F>(function));
+            ops_ = &Operations<Function>::OPS;
+        }
+
+        /**
+         * @brief Copies an Event Deligate.
+         *
+         * @param other The deligate to copy.
+         */
+        EventDeligate(const EventDeligate& other) {
+            if (other.ops_ != nullptr) other.ops_->copy(storage_, other.storage_);
+            ops_ = other.ops_;
+        }
+        /**
+         * @brief Moves an Event Deligate.
+         *
+         * @param other The deligate to move. It is left empty.
+         */
+        EventDeligate(EventDeligate&& other) noexcept {
+            if (other.ops_ != nullptr) other.ops_->move(storage_, other.storage_);
+            ops_ = other.ops_;
+            other.reset();
+        }
+        /** Destroys the stored callable. */
+        ~EventDeligate() { reset(); }
+
+        /**
+         * @brief Replaces this deligate with a copy of another.
+         *
+         * @param other The deligate to copy.
+         * @return EventDeligate& This deligate.
+         */
+        EventDeligate& operator=(const EventDeligate& other) {
+            if (this != &other) {
+                reset();
+                if (other.ops_ != nullptr) other.ops_->copy(storage_, other.storage_);
+                ops_ = other.ops_;
+            }
+            return *this;
+        }
+        /**
+         * @brief Replaces this deligate with another.
+         *
+         * @param other The deligate to move. It is left empty.
+         * @return EventDeligate& This deligate.
+         */
+        EventDeligate& operator=(EventDeligate&& other) noexcept {
+            if (this != &other) {
+                reset();
+                if (other.ops_ != nullptr) other.ops_->move(storage_, other.storage_);
+                ops_ = other.ops_;
+                other.reset();
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Calls the stored callable.
+         *
+         * @param e The event to pass to the callable.
+         */
+        inline void operator()(Event& e) const { ops_->invoke(storage_, e); }
+
+        /**
+         * @brief Does this deligate hold a callable?
+         *
+         * @return true If a callable is stored.
+         */
+        inline explicit operator bool() const { return ops_ != nullptr; }
+
+        /** Destroys the stored callable, leaving this deligate empty. */
+        inline void reset() {
+            if (ops_ != nullptr) ops_->destroy(storage_);
+            ops_ = nullptr;
+        }
+
+    private:
+
+        /** The type-erased operations on a stored callable. */
+        struct Ops {
+            void (*invoke)(const void*, Event&);
+            void (*copy)(void*, const void*);
+            void (*move)(void*, void*);
+            void (*destroy)(void*);
+        };
+
+        /** The operations for a callable of type F. */
+        template <class F>
+        struct Operations {
+            static void invoke(const void* f, Event& e) { (*static_cast<F*>(const_cast<void*>(f)))(e); }
+            static void copy(void* to, const void* from) { new (to) F(*static_cast<const F*>(from)); }
+            static void move(void* to, void* from) { new (to) F(std::move(*static_cast<F*>(from))); }
+            static void destroy(void* f) { static_cast<F*>(f)->~F(); }
+            static const Ops OPS;
+        };
+
+        /** The storage of the callable. */
+        alignas(std::max_align_t) unsigned char storage_[STORAGE_SIZE];
+        /** The operations of the stored callable, or nullptr if empty. */
+        const Ops* ops_ = nullptr;
+
+    };
+
+    template <class F>
+    const EventDeligate::Ops EventDeligate::Operations<F>::OPS = {
+        &EventDeligate::Operations<F>::invoke,
+        &EventDeligate::Operations<F>::copy,
+        &EventDeligate::Operations<F>::move,
+        &EventDeligate::Operations<F>::destroy
+    };
+
+    /**
+     * @brief A handle to a deligate bound with EventDispatcher::subscribe(). The deligate is
+     *        unbound when the handle is destroyed or reset.
+     * @details Handles must not outlive the engine statics, so they should not be declared static.
+     */
+    class EventSubscription final {
+
+        friend class EventDispatcher;
+
+    public:
+
+        /** Constructs an empty Event Subscription. */
+        EventSubscription() {}
+        /**
+         * @brief Takes over the deligate bound to another handle.
+         *
+         * @param other The handle to move. It is left empty.
+         */
+        EventSubscription(EventSubscription&& other) noexcept : event_id_(other.event_id_), token_(other.token_) {
+            other.token_ = 0;
+        }
+        /** Unbinds the deligate. */
+        ~EventSubscription() { reset(); }
+
+        EventSubscription(const EventSubscription&) = delete;
+        EventSubscription& operator=(const EventSubscription&) = delete;
+
+        /**
+         * @brief Unbinds the current deligate and takes over the deligate bound to another handle.
+         *
+         * @param other The handle to move. It is left empty.
+         * @return EventSubscription& This handle.
+         */
+        EventSubscription& operator=(EventSubscription&& other) {
+            if (this != &other) {
+                reset();
+                event_id_ = other.event_id_;
+                token_ = other.token_;
+                other.token_ = 0;
+            }
+            return *this;
+        }
+
+        /** Unbinds the deligate, leaving this handle empty. */
+        void reset();
+
+        /**
+         * @brief Is a deligate bound to this handle?
+         *
+         * @return true If a deligate is bound.
+         */
+        inline bool active() const { return token_ != 0; }
+
+    private:
+
+        /**
+         * @brief Constructs a handle to a bound deligate.
+         *
+         * @param event_id The ID of the event the deligate is bound to.
+         * @param token The unique token of the binding.
+         */
+        EventSubscription(unsigned int event_id, uint64_t token) : event_id_(event_id), token_(token) {}
+
+        /** The ID of the event the deligate is bound to. */
+        unsigned int event_id_ = 0;
+        /** The unique token of the binding, or 0 if empty. */
+        uint64_t token_ = 0;
+
+    };
+
+    /**
+     * @brief Collects the time taken by every deligate call, per event and per subscriber.
+     * @details Calls are only timed when the engine is built with ENGINE_PROFILE_DISPATCH
+     *          enabled. Otherwise the dispatcher never calls into the profiler and dispatch
+     *          costs nothing extra. Calls slower than the budget are counted as slow, and the
+     *          first slow call of each subscriber is logged.
+     */
+    class DispatchProfiler final {
+
+    public:
+
+        /** The timings of an event or a subscriber. */
+        struct Entry {
+            /** The name of the subscriber, empty if it was bound without one. */
+            string name;
+            /** The time taken by each call, in nanoseconds. */
+            util::Histogram times;
+            /** The number of calls slower than the budget. */
+            uint64_t slow_calls = 0;
+        };
+
+        /**
+         * @brief Counts a deligate call.
+         *
+         * @param event_id The ID of the dispatched event.
+         * @param token The token of the deligate binding, or 0 if it has been unbound.
+         * @param nanoseconds The time taken by the call.
+         */
+        static void record(unsigned int event_id, uint64_t token, uint64_t nanoseconds);
+
+        /**
+         * @brief Sets the time a deligate call may take before it is flagged as slow.
+         *
+         * @param nanoseconds The budget, or 0 to flag nothing.
+         */
+        static void setBudget(uint64_t nanoseconds);
+        /**
+         * @brief Returns the time a deligate call may take before it is flagged as slow.
+         *
+         * @return uint64_t The budget in nanoseconds.
+         */
+        static uint64_t budget();
+
+        /**
+         * @brief Names a deligate binding in reports.
+         *
+         * @param token The token of the deligate binding.
+         * @param name The name of the subscriber.
+         */
+        static void name(uint64_t token, const string& name);
+        /**
+         * @brief Removes the name and timings of a deligate binding once it is unbound.
+         *
+         * @param token The token of the deligate binding.
+         */
+        static void forget(uint64_t token);
+
+        /**
+         * @brief Returns the timings of every deligate call made for an event.
+         *
+         * @param event_id The ID of the event.
+         * @return const Entry* The timings, or nullptr if no call was timed.
+         */
+        static const Entry* event(unsigned int event_id);
+        /**
+         * @brief Returns the timings of a deligate binding.
+         *
+         * @param token The token of the deligate binding.
+         * @return const Entry* The timings, or nullptr if no call was timed.
+         */
+        static const Entry* subscriber(uint64_t token);
+
+        /**
+         * @brief Returns the number of calls slower than the budget.
+         *
+         * @return uint64_t The number of slow calls.
+         */
+        static uint64_t slowCalls();
+
+        /**
+         * @brief Writes the timings of every event and subscriber as a table.
+         *
+         * @param out The stream to write to.
+         */
+        static void report(std::ostream& out);
+        /**
+         * @brief Writes the timings of every event and subscriber to a file.
+         *
+         * @param path The path of the report file.
+         * @return true If the report was written.
+         */
+        static bool report(const string& path);
+
+        /** Removes every timing. Subscriber names are kept. */
+        static void clear();
+
+    private:
+
+        /** The timings of each event, indexed by event ID. */
+        static std::vector<std::unique_ptr<Entry>> events;
+        /** The timings of each deligate binding, by token. */
+        static std::unordered_map<uint64_t, Entry> subscribers;
+        /** The slow call budget in nanoseconds. */
+        static uint64_t budget_ns;
+        /** The number of calls slower than the budget. */
+        static uint64_t slow_calls;
+
+    };
+
     /**
      * @brief An event dispatcher for handling event buffering and the distribution of events to deligates.
-     * @details
+     * @details Queued events are partitioned into one buffer per event type, so running a type
+     *          filter only visits the buffers of matching types. Events of the same type are run
+     *          in the order they were pushed. The type of a pushed event is taken from its
+     *          EVENT_ID, which must hold the EventType in the bits above the low four.
+     *
+     *          Events may be pushed from any thread. Events pushed from the dispatch thread go
+     *          straight to their buffer, while events pushed from other threads pass through a
+     *          bounded #EventChannel and join their buffers at the start of the next run.
+     *          Deligates are registered and run on the dispatch thread only.
+     *
+     *          Deligates are stored in a dense table indexed by event ID. Deligates bound or
+     *          unbound while events are being dispatched take effect once dispatch returns.
      */
     class EventDispatcher final {
 
     public:
 
         /** A function deligate that recieves an event. */
-        typedef ::std::function<void(Event&)> EventDeligate;
+        typedef seedengine::EventDeligate EventDeligate;
 
         /**
          * @brief Registers a function delegate to a specific Event ID to bind the actions.
+         *        The deligate stays bound for the lifetime of the program.
          * 
          * @param event_id The ID of the event to bind to.
          * @param deligate The function to bind to the event.
+         * @param name The name of the subscriber in dispatch profiles.
+         */
+        static void registerDeligate(const unsigned int event_id, EventDeligate deligate, const string& name = "");
+
+        /**
+         * @brief Binds a function delegate to a specific Event ID until the returned handle is
+         *        destroyed. Use this when the deligate captures an object that may be destroyed.
+         *
+         * @param event_id The ID of the event to bind to.
+         * @param deligate The function to bind to the event.
+         * @param name The name of the subscriber in dispatch profiles.
+         * @return EventSubscription The handle that keeps the deligate bound.
+         */
+        static EventSubscription subscribe(const unsigned int event_id, EventDeligate deligate, const string& name = "");
+
+        /**
+         * @brief Returns the number of deligates bound to an event.
+         *
+         * @param event_id The ID of the event.
+         * @return size_t The number of bound deligates.
          */
-        static void registerDeligate(const unsigned int event_id, EventDeligate deligate);
+        static size_t deligateCount(const unsigned int event_id);
 
         /**
          * @brief Pushs an event into the event queue. This is a non-blocking event.
@@ -114,19 +724,145 @@ namespace seedengine {
             typename = typename std::enable_if<std::is_base_of<Event, E>::value>::type
         >
         static void push(Args&&... args) {
-            event_buffer.push(std::make_shared<E>(std::forward<Args>(args)...));
+            if (!isDispatchThread()) {
+                // Blocks while the channel is full
+                event_channel.emplace<E>(&EventDispatcher::transfer<E>, std::forward<Args>(args)...);
+                return;
+            }
+            enqueue<E>(std::integral_constant<bool, E::COALESCING != EventCoalescing::NONE>(), std::forward<Args>(args)...);
         }
 
         /**
-         * @brief Removes and returns the next event in the buffer.
-         * 
-         * @return std::shared_ptr<Event> The next event in the buffer.
+         * @brief Pushs an event into the event queue if there is room. This never blocks.
+         *
+         * @tparam E The event type to push.
+         * @tparam Args The variadic parameter pack used to construct the Event.
+         * @tparam typename Conditional compilation based on the base type of E.
+         * @param args The arguments used when constructing the Event of type E.
+         * @return true If the event was queued.
+         * @return false If the event was dropped because the channel from other threads is full.
+         */
+        template <
+            class E,
+            class... Args,
+            typename = typename std::enable_if<std::is_base_of<Event, E>::value>::type
+        >
+        static bool tryPush(Args&&... args) {
+            if (!isDispatchThread()) {
+                return event_channel.tryEmplace<E>(&EventDispatcher::transfer<E>, std::forward<Args>(args)...);
+            }
+            push<E>(std::forward<Args>(args)...);
+            return true;
+        }
+
+        /**
+         * @brief Calls a function on the dispatch thread. The function is called immediately on
+         *        the dispatch thread, and from other threads it is carried through the event
+         *        channel and called when the dispatch thread next runs the events.
+         *
+         * @param function The function to call.
+         */
+        static void post(std::function<void()> function);
+
+        /**
+         * @brief Pushs an event into the event queue once an amount of game time has passed.
+         *        Must be called on the dispatch thread.
+         *
+         * @tparam E The event type to push.
+         * @tparam Args The types of the arguments, stored by value until the event is pushed.
+         * @param seconds The game time to wait.
+         * @param args The arguments used when constructing the Event of type E.
+         * @return TimerId The handle used to cancel the push with Timers::cancel().
+         */
+        template <
+            class E,
+            class... Args,
+            typename = typename std::enable_if<std::is_base_of<Event, E>::value>::type
+        >
+        static TimerId pushAfter(float seconds, Args... args) {
+            return Timers::after(seconds, [args...]() { EventDispatcher::push<E>(args...); });
+        }
+
+        /**
+         * @brief Pushs an event into the event queue at the start of a later frame.
+         *        Must be called on the dispatch thread.
+         *
+         * @tparam E The event type to push.
+         * @tparam Args The types of the arguments, stored by value until the event is pushed.
+         * @param frames The number of frames to wait. 1 pushes the event next frame.
+         * @param args The arguments used when constructing the Event of type E.
+         * @return TimerId The handle used to cancel the push with Timers::cancel().
+         */
+        template <
+            class E,
+            class... Args,
+            typename = typename std::enable_if<std::is_base_of<Event, E>::value>::type
+        >
+        static TimerId pushAfterFrames(unsigned int frames, Args... args) {
+            return Timers::afterFrames(frames, [args...]() { EventDispatcher::push<E>(args...); });
+        }
+
+        /**
+         * @brief Makes the calling thread the dispatch thread. Defaults to the thread that
+         *        initialized the engine statics. Must only be called while no other thread
+         *        pushes events, such as before the engine starts its threads.
+         */
+        static void setDispatchThread();
+        /**
+         * @brief Makes another thread the dispatch thread, such as a thread that will run the
+         *        events once it is started. Must only be called while no other thread pushes events.
+         *
+         * @param id The id of the thread that runs the events.
+         */
+        static void setDispatchThread(std::thread::id id);
+        /**
+         * @brief Is the calling thread the dispatch thread? Only the dispatch thread may force
+         *        events, run the buffers or bind deligates while events are dispatched.
+         *
+         * @return true If the calling thread runs the events.
+         */
+        static inline bool isDispatchThread() {
+            return std::this_thread::get_id() == dispatch_thread.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Returns the number of times a thread waited because the event channel was full.
+         *
+         * @return size_t The number of backpressure waits.
          */
-        static std::shared_ptr<Event> pop();
+        static size_t backpressure();
+
+        /**
+         * @brief Returns the number of pushed events that were combined into a pending event
+         *        instead of being queued.
+         *
+         * @return size_t The number of coalesced events.
+         */
+        static size_t coalesced();
+
+        /**
+         * @brief Returns the number of events waiting in the buffer. Events pushed from other
+         *        threads are counted once a run has collected them.
+         *
+         * @param type_filter The types to count, or 0 for all events.
+         * @return size_t The number of queued events.
+         */
+        static size_t pending(unsigned int type_filter = 0);
+
+        /**
+         * @brief Sets a function that sees every queued event just before its deligates run.
+         *        Forced events are not observed. Used to record event streams.
+         *
+         * @param observer The observing function, or an empty deligate to remove it.
+         */
+        static void setObserver(EventDeligate observer);
 
         /**
          * @brief Forces an event to notify its bound functions without adding
-         *        it to the queue. This is a blocking event.
+         *        it to the queue. This is a blocking event. Must be called on the dispatch thread.
+         * @details The event is constructed on the stack and its deligates are found through
+         *          E::EVENT_ID at compile time, so forcing an event costs one indirect call per
+         *          bound deligate. E must declare its own EVENT_ID.
          * 
          * @tparam E The event type to force.
          * @tparam Args The variadic parameter pack used to construct the Event.
@@ -140,13 +876,11 @@ namespace seedengine {
             typename = typename std::enable_if<std::is_base_of<Event, E>::value>::type
         >
         static void force(Args&&... args) {
-            auto event_ptr = std::make_shared<E>(std::forward<Args>(args)...);
-            // Iterate through all delegates bound to this event
-            for (EventDeligate deligate : deligate_regtistry[event_ptr->getId()])
-            {
-                // Call the function
-                deligate(*event_ptr);
-            }
+            assert(isDispatchThread() && "Events may only be forced on the dispatch thread.");
+            // The deligate list of each event class is resolved once, so no lookup happens per call
+            static DeligateList& deligates = deligatesFor(E::EVENT_ID);
+            E event(std::forward<Args>(args)...);
+            notify(E::EVENT_ID, deligates, event);
         }
 
         /**
@@ -159,10 +893,229 @@ namespace seedengine {
 
     private:
 
-        /** The event buffer queue. */
-        static std::queue<std::shared_ptr<Event>> event_buffer;
-        /** A mapped registry of all events and their bound functions. */
-        static std::map<const unsigned int, std::vector<EventDeligate>> deligate_regtistry;
+        /** The event buffer of a single event type. */
+        struct TypeBuffer {
+            /** The type of every event in this buffer. */
+            unsigned int type;
+            /** The queued events. */
+            std::unique_ptr<EventQueue> events;
+            /** The number of events queued before the current run. */
+            size_t run_size;
+        };
+
+        /** A function carried through the event channel by post(). */
+        struct PostedCall {
+            /** The function to call on the dispatch thread. */
+            std::function<void()> function;
+        };
+
+        /**
+         * @brief Calls a posted function taken from the event channel.
+         *
+         * @param storage The channel storage holding the #PostedCall.
+         */
+        static void call(void* storage);
+
+        /**
+         * @brief Moves an event out of the event channel into its buffer.
+         *
+         * @tparam E The event type.
+         * @param storage The channel storage holding the event.
+         */
+        template <class E>
+        static void transfer(void* storage) {
+            E* event = static_cast<E*>(storage);
+            enqueue<E>(std::integral_constant<bool, E::COALESCING != EventCoalescing::NONE>(), std::move(*event));
+            event->~E();
+        }
+
+        /**
+         * @brief Returns the buffer of an event class. The buffer is resolved once per class.
+         *
+         * @tparam E The event type.
+         * @return EventQueue& The buffer of the event type.
+         */
+        template <class E>
+        static EventQueue& bufferOf() {
+            static EventQueue& buffer = bufferFor(E::EVENT_ID >> 4);
+            return buffer;
+        }
+
+        /**
+         * @brief Adds an event that is never coalesced to its buffer.
+         *
+         * @tparam E The event type.
+         * @param args The arguments used when constructing the Event of type E.
+         */
+        template <class E, class... Args>
+        static void enqueue(std::false_type, Args&&... args) {
+            bufferOf<E>().template emplace<E>(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Adds an event to its buffer, combining it with the pending event of its class
+         *        while that event is still the last one in the buffer, so events never reorder.
+         *
+         * @tparam E The event type.
+         * @param args The arguments used when constructing the Event of type E.
+         */
+        template <class E, class... Args>
+        static void enqueue(std::true_type, Args&&... args) {
+            // The last queued event of this class, valid while nothing in the buffer has been destroyed
+            static E* pending = nullptr;
+            static uint64_t pending_generation = 0;
+            static size_t pending_size = 0;
+            EventQueue& buffer = bufferOf<E>();
+            E event(std::forward<Args>(args)...);
+            if (pending != nullptr && pending_generation == buffer.generation() && pending_size == buffer.size() &&
+                    pending->coalescesWith(event)) {
+                combine(std::integral_constant<EventCoalescing, E::COALESCING>(), *pending, std::move(event));
+                coalesced_events++;
+                return;
+            }
+            pending = buffer.emplace<E>(std::move(event));
+            pending_generation = buffer.generation();
+            pending_size = buffer.size();
+        }
+
+        /**
+         * @brief Replaces a pending event with a newer one.
+         *
+         * @param pending The pending event.
+         * @param event The newer event.
+         */
+        template <class E>
+        static inline void combine(std::integral_constant<EventCoalescing, EventCoalescing::KEEP_LATEST>, E& pending, E&& event) {
+            pending = std::move(event);
+        }
+
+        /**
+         * @brief Adds a newer event into a pending one.
+         *
+         * @param pending The pending event.
+         * @param event The newer event.
+         */
+        template <class E>
+        static inline void combine(std::integral_constant<EventCoalescing, EventCoalescing::ACCUMULATE>, E& pending, E&& event) {
+            pending.accumulate(event);
+        }
+
+        /**
+         * @brief Returns the buffer for events of a type, creating it if needed.
+         *
+         * @param type The event type.
+         * @return EventQueue& The buffer for the type.
+         */
+        static EventQueue& bufferFor(unsigned int type);
+
+        /** The event buffers of each type, in order of creation. */
+        static std::vector<TypeBuffer> event_buffers;
+        /** The channel carrying events pushed from other threads. */
+        static EventChannel event_channel;
+        /** The thread that runs the event buffers. Read by every thread that pushes events. */
+        static std::atomic<std::thread::id> dispatch_thread;
+        /** The number of pushes combined into a pending event. */
+        static size_t coalesced_events;
+        /** The function that sees every queued event before it is run. */
+        static EventDeligate event_observer;
+        friend class EventSubscription;
+
+        /** A deligate bound to an event. */
+        struct DeligateSlot {
+            /** The unique token of the binding, or 0 once unbound. */
+            uint64_t token;
+            /** The bound function. */
+            EventDeligate deligate;
+        };
+
+        /** The deligates bound to a single event. */
+        typedef std::vector<DeligateSlot> DeligateList;
+
+        /** A deligate bound during dispatch, waiting to be added to the table. */
+        struct PendingDeligate {
+            /** The ID of the event to bind to. */
+            unsigned int event_id;
+            /** The deligate to bind. */
+            DeligateSlot slot;
+        };
+
+        /**
+         * @brief Calls every deligate bound to an event.
+         *
+         * @param e The event.
+         */
+        static void notify(Event& e);
+
+        /**
+         * @brief Calls every deligate in a list. Each call is timed when the engine is built
+         *        with ENGINE_PROFILE_DISPATCH.
+         *
+         * @param event_id The ID of the event.
+         * @param deligates The deligates bound to the event.
+         * @param e The event.
+         */
+        static inline void notify(unsigned int event_id, DeligateList& deligates, Event& e) {
+            ENGINE_PROFILE_SCOPE(e.getName());
+            dispatch_depth++;
+            // Bindings made by deligates are deferred, so the list does not change size here
+            for (size_t i = 0; i < deligates.size(); i++) {
+            #if ENGINE_PROFILE_DISPATCH
+                // The deligate may unbind itself, so the token is read before the call
+                uint64_t token = deligates[i].token;
+                if (token == 0) continue;
+                auto start = std::chrono::high_resolution_clock::now();
+                deligates[i].deligate(e);
+                auto end = std::chrono::high_resolution_clock::now();
+                // A deligate that unbound itself is only counted against the event
+                DispatchProfiler::record(event_id, deligates[i].token,
+                    static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+            #else
+                if (deligates[i].token != 0) deligates[i].deligate(e);
+            #endif
+            }
+            dispatch_depth--;
+            if (dispatch_depth == 0 && (deligates_unbound || !pending_deligates.empty())) settleDeligates();
+        }
+
+        /**
+         * @brief Returns the deligate list of an event, creating it if needed. The list stays at
+         *        the same address for the lifetime of the program.
+         *
+         * @param event_id The ID of the event.
+         * @return DeligateList& The deligates bound to the event.
+         */
+        static DeligateList& deligatesFor(const unsigned int event_id);
+
+        /**
+         * @brief Binds a deligate to an event.
+         *
+         * @param event_id The ID of the event to bind to.
+         * @param deligate The function to bind to the event.
+         * @return uint64_t The unique token of the binding.
+         */
+        static uint64_t bind(const unsigned int event_id, EventDeligate&& deligate);
+
+        /**
+         * @brief Unbinds a deligate from an event.
+         *
+         * @param event_id The ID of the event.
+         * @param token The unique token of the binding.
+         */
+        static void unbind(const unsigned int event_id, uint64_t token);
+
+        /** Applies the bindings made during dispatch and removes unbound deligates. */
+        static void settleDeligates();
+
+        /** The deligates bound to each event, indexed by event ID. */
+        static std::vector<std::unique_ptr<DeligateList>> deligate_table;
+        /** The deligates bound during dispatch. */
+        static std::vector<PendingDeligate> pending_deligates;
+        /** The number of dispatches in progress. */
+        static unsigned int dispatch_depth;
+        /** Have deligates been unbound during dispatch? */
+        static bool deligates_unbound;
+        /** The token of the next binding. */
+        static uint64_t next_token;
 
     };
 
@@ -310,17 +1263,27 @@ namespace seedengine {
 
     };
 
+    class RenderSnapshot; // Forward declare RenderSnapshot class
+
     /**
      * @brief An event triggered during the render of a frame.
-     * @details
+     * @details When the program runs pipelined, the render thread pushes this event once it has
+     *          rendered a frame, and it is run on the simulation thread at the start of a later
+     *          frame. The snapshot has been handed back by then, so it is nullptr, and the event
+     *          is tagged with the frame it was rendered in instead.
      */
     class EngineRenderEvent : public EngineEvent {
 
     public:
 
-        /** Constructs a new Engine Render Event. */
-        EngineRenderEvent()
-            : EngineEvent() {}
+        /**
+         * @brief Constructs a new Engine Render Event.
+         * 
+         * @param snapshot The frame state to render, or nullptr.
+         * @param frame The index of the rendered frame.
+         */
+        EngineRenderEvent(const RenderSnapshot* snapshot = nullptr, uint64_t frame = 0)
+            : EngineEvent(), snapshot_(snapshot), frame_(frame) {}
 
         /**
          * @brief Get the name of this Event.
@@ -338,21 +1301,44 @@ namespace seedengine {
         /** The ID number of this event type. */
         static const unsigned int EVENT_ID = (static_cast<unsigned int>(EventType::ENGINE) << 4) | 1;
 
+        /**
+         * @brief Returns the frame state to render.
+         * 
+         * @return const RenderSnapshot* The snapshot of the frame, or nullptr if none was taken.
+         */
+        inline const RenderSnapshot* snapshot() const { return snapshot_; }
+        /**
+         * @brief Returns the index of the rendered frame.
+         * 
+         * @return uint64_t The frame index.
+         */
+        inline uint64_t frame() const { return frame_; }
+
     protected:
 
+        /** The frame state to render. */
+        const RenderSnapshot* snapshot_;
+        /** The index of the rendered frame. */
+        uint64_t frame_;
+
     };
 
     /**
      * @brief An event triggered before rendering a frame.
-     * @details
+     * @details Pushed by the render thread and run on the simulation thread when the program runs
+     *          pipelined, like #EngineRenderEvent.
      */
     class EnginePreRenderEvent : public EngineEvent {
 
     public:
 
-        /** Constructs a new Engine Pre-Render Event. */
-        EnginePreRenderEvent()
-            : EngineEvent() {}
+        /**
+         * @brief Constructs a new Engine Pre-Render Event.
+         * 
+         * @param frame The index of the rendered frame.
+         */
+        EnginePreRenderEvent(uint64_t frame = 0)
+            : EngineEvent(), frame_(frame) {}
 
         /**
          * @brief Get the name of this Event.
@@ -370,21 +1356,36 @@ namespace seedengine {
         /** The ID number of this event type. */
         static const unsigned int EVENT_ID = (static_cast<unsigned int>(EventType::ENGINE) << 4) | 2;
 
+        /**
+         * @brief Returns the index of the rendered frame.
+         * 
+         * @return uint64_t The frame index.
+         */
+        inline uint64_t frame() const { return frame_; }
+
     protected:
 
+        /** The index of the rendered frame. */
+        uint64_t frame_;
+
     };
 
     /**
      * @brief An event triggered after rendering a frame.
-     * @details
+     * @details Pushed by the render thread and run on the simulation thread when the program runs
+     *          pipelined, like #EngineRenderEvent.
      */
     class EnginePostRenderEvent : public EngineEvent {
 
     public:
 
-        /** Constructs a new Engine Post-Render Event. */
-        EnginePostRenderEvent()
-            : EngineEvent() {}
+        /**
+         * @brief Constructs a new Engine Post-Render Event.
+         * 
+         * @param frame The index of the rendered frame.
+         */
+        EnginePostRenderEvent(uint64_t frame = 0)
+            : EngineEvent(), frame_(frame) {}
 
         /**
          * @brief Get the name of this Event.
@@ -402,8 +1403,18 @@ namespace seedengine {
         /** The ID number of this event type. */
         static const unsigned int EVENT_ID = (static_cast<unsigned int>(EventType::ENGINE) << 4) | 3;
 
+        /**
+         * @brief Returns the index of the rendered frame.
+         * 
+         * @return uint64_t The frame index.
+         */
+        inline uint64_t frame() const { return frame_; }
+
     protected:
 
+        /** The index of the rendered frame. */
+        uint64_t frame_;
+
     };
 
     /**
@@ -438,6 +1449,55 @@ namespace seedengine {
 
     };
 
+    /**
+     * @brief An event triggered once the ticks of a frame are done, to copy the state needed
+     *        to render the frame into a snapshot.
+     * @details Deligates submit their meshes and camera to the snapshot. The snapshot is
+     *          rendered after the event, possibly on another thread while the next frame is
+     *          simulated, so it must not point at state the simulation changes.
+     */
+    class EngineSnapshotEvent : public EngineEvent {
+
+    public:
+
+        /**
+         * @brief Constructs a new Engine Snapshot Event.
+         * 
+         * @param snapshot The snapshot to fill.
+         */
+        EngineSnapshotEvent(RenderSnapshot& snapshot)
+            : EngineEvent(), snapshot_(&snapshot) {}
+
+        /**
+         * @brief Get the name of this Event.
+         *
+         * @return const char* The name of this Event.
+         */
+        const char* getName() const { return "Engine Snapshot Event"; }
+        /**
+         * @brief Get the ID of this Event.
+         *
+         * @return const unsigned int The ID of this Event.
+         */
+        const unsigned int getId() const { return EVENT_ID; }
+
+        /**
+         * @brief Returns the snapshot to fill.
+         * 
+         * @return RenderSnapshot& The snapshot of the frame.
+         */
+        inline RenderSnapshot& snapshot() const { return *snapshot_; }
+
+        /** The ID number of this event type. */
+        static const unsigned int EVENT_ID = (static_cast<unsigned int>(EventType::ENGINE) << 4) | 5;
+
+    protected:
+
+        /** The snapshot to fill. */
+        RenderSnapshot* snapshot_;
+
+    };
+
     class Window; // Forward declare Window class
 
     /**
@@ -472,6 +1532,14 @@ namespace seedengine {
          */
         inline Window* window() const { return window_; }
 
+        /**
+         * @brief Can a newer event of the same kind be combined into this one?
+         *
+         * @param other The newer event.
+         * @return true If both events affect the same window.
+         */
+        inline bool coalescesWith(const WindowEvent& other) const { return window_ == other.window_; }
+
     protected:
 
         /** The affected window */
@@ -562,6 +1630,8 @@ namespace seedengine {
 
         /** The ID number of this event type. */
         static const unsigned int EVENT_ID = (static_cast<unsigned int>(EventType::WINDOW) << 4) | 1;
+        /** Only the latest size is kept while the event waits in the buffer. */
+        static const EventCoalescing COALESCING = EventCoalescing::KEEP_LATEST;
 
     protected:
 
@@ -619,6 +1689,8 @@ namespace seedengine {
 
         /** The ID number of this event type. */
         static const unsigned int EVENT_ID = (static_cast<unsigned int>(EventType::WINDOW) << 4) | 2;
+        /** Only the latest position is kept while the event waits in the buffer. */
+        static const EventCoalescing COALESCING = EventCoalescing::KEEP_LATEST;
 
     protected:
 
@@ -1060,6 +2132,8 @@ namespace seedengine {
 
         /** The ID number of this event type. */
         static const unsigned int EVENT_ID = (static_cast<unsigned int>(EventType::MOUSE) << 4);
+        /** Only the latest position is kept while the event waits in the buffer. */
+        static const EventCoalescing COALESCING = EventCoalescing::KEEP_LATEST;
 
     private:
 
@@ -1177,8 +2251,20 @@ namespace seedengine {
          */
         inline float y_offset() const { return y_offset_; }
 
+        /**
+         * @brief Adds the scroll of a newer event into this one.
+         *
+         * @param other The newer event.
+         */
+        inline void accumulate(const MouseScrolledEvent& other) {
+            x_offset_ += other.x_offset_;
+            y_offset_ += other.y_offset_;
+        }
+
         /** The ID number of this event type. */
         static const unsigned int EVENT_ID = (static_cast<unsigned int>(EventType::MOUSE) << 4) | 2;
+        /** Scroll offsets are summed while the event waits in the buffer. */
+        static const EventCoalescing COALESCING = EventCoalescing::ACCUMULATE;
 
     private:
 
@@ -0,0 +1,99 @@
+#ifndef SEEDENGINE_INCLUDE_HEADLESS_H_
+#define SEEDENGINE_INCLUDE_HEADLESS_H_
+
+#include "Core.hpp"
+#include "Snapshot.hpp"
+#include "Stats.hpp"
+
+namespace seedengine {
+
+    /**
+     * @brief Takes the place of the #Renderer when the program runs without a window or graphics.
+     * @details Nothing is drawn. Each rendered snapshot is counted and hashed instead, so two
+     *          headless runs of the same input can be checked for identical results. The hash
+     *          covers the camera and the matrix of every draw in order. While recording, each
+     *          frame is also written to a CSV file with its draw count and hash.
+     */
+    class HeadlessRenderer final {
+
+    public:
+
+        /** Constructs a new Headless Renderer. The program hands it each snapshot through render(). */
+        HeadlessRenderer();
+        /** Stops recording. */
+        ~HeadlessRenderer();
+
+        HeadlessRenderer(const HeadlessRenderer&) = delete;
+        HeadlessRenderer& operator=(const HeadlessRenderer&) = delete;
+
+        /**
+         * @brief Starts writing a line for each rendered frame.
+         *
+         * @param path The path of the CSV file. An existing file is replaced.
+         * @return true If the file was opened.
+         */
+        bool record(const string& path);
+        /** Stops writing frames and closes the file. */
+        void stop();
+
+        /**
+         * @brief Counts and hashes a snapshot in place of drawing it.
+         *
+         * @param snapshot The frame state to render.
+         */
+        void render(const RenderSnapshot& snapshot);
+
+        /**
+         * @brief Returns the hash of a snapshot.
+         *
+         * @param snapshot The snapshot to hash.
+         * @return uint64_t The FNV-1a hash of the camera and draw list.
+         */
+        static uint64_t hash(const RenderSnapshot& snapshot);
+
+        /**
+         * @brief Is a file being written?
+         *
+         * @return true If frames are being recorded.
+         */
+        inline bool isRecording() const { return file_.is_open(); }
+        /**
+         * @brief Returns the number of rendered frames.
+         *
+         * @return uint64_t The number of frames.
+         */
+        inline uint64_t frames() const { return draw_counts_.count(); }
+        /**
+         * @brief Returns the number of draws of each rendered frame.
+         *
+         * @return const util::Histogram& The draw counts.
+         */
+        inline const util::Histogram& drawCounts() const { return draw_counts_; }
+        /**
+         * @brief Returns the hash of every rendered frame combined, in order.
+         *
+         * @return uint64_t The combined hash.
+         */
+        inline uint64_t checksum() const { return checksum_; }
+
+        /**
+         * @brief Returns the rendered frames as a single line of text.
+         *
+         * @return string The formatted statistics.
+         */
+        string summary() const;
+
+    private:
+
+        /** The recorded frames. */
+        std::ofstream file_;
+        /** The number of draws of each frame. */
+        util::Histogram draw_counts_;
+        /** The combined hash of every frame. */
+        uint64_t checksum_;
+
+    };
+
+}
+
+#endif
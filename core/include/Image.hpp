@@ -62,6 +62,13 @@ namespace seedengine {
          */
         inline void setFormat(ImageFormat format) { format_ = format; }
 
+        /**
+         * @brief Gets the number of bytes of pixel data held in CPU memory.
+         * 
+         * @return size_t The number of bytes held.
+         */
+        size_t residentBytes() const override;
+
         #if ENGINE_GRAPHICS_API == ENGINE_GRAPHICS_OPGL
 
             /**
@@ -84,8 +91,31 @@ namespace seedengine {
 
         /** Loads this image into memory. */
         void load();
+        /**
+         * @brief Loads this image from bytes already read from its file.
+         *
+         * @param bytes The contents of the file, or empty to read the file.
+         */
+        void load(const std::vector<char>& bytes) override;
         /** Unloads this image from memory. */
         void unload();
+        /** Reloads the pixel data of this image. */
+        void reload();
+        /**
+         * @brief Frees the pixel data of this image. The engine does not upload images itself, so
+         *        the owner calls releaseData() once the pixels have been consumed. Images have no
+         *        compact copy, so COMPACT behaves as DISCARD.
+         */
+        void release();
+
+        /**
+         * @brief Reads the pixel data of this image from the disk, or decodes it from bytes
+         *        already read.
+         * 
+         * @param bytes The contents of the file, or empty to read the file.
+         * @return true If the image was read.
+         */
+        bool read(const std::vector<char>& bytes = std::vector<char>());
 
         /** The width of this image. */
         unsigned int width_;
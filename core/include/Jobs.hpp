@@ -0,0 +1,241 @@
+#ifndef SEEDENGINE_INCLUDE_JOBS_H_
+#define SEEDENGINE_INCLUDE_JOBS_H_
+
+#include "Core.hpp"
+
+#include <atomic>
+
+namespace seedengine {
+
+    /**
+     * @brief The engine job system: worker threads that run short functions in parallel.
+     * @details Every worker, and the thread that started the job system, owns a #jobs::WorkQueue.
+     *          Jobs are pushed to the queue of the thread that runs them, and idle workers steal
+     *          the oldest jobs from other queues, so large pieces of work spread out while small
+     *          ones stay on the thread that made them. Jobs run from any other thread go through
+     *          a shared queue. Threads waiting on a #jobs::Counter run jobs until it reaches zero,
+     *          so waiting inside a job never blocks a worker.
+     */
+    namespace jobs {
+
+        /** A function run as a job. */
+        typedef std::function<void()> Function;
+        /** A function run over part of a range, from begin to end. */
+        typedef std::function<void(size_t begin, size_t end)> RangeFunction;
+
+        class Scheduler; // Forward declare Scheduler class
+
+        /**
+         * @brief Counts the unfinished jobs of a group, so their owner can wait for them.
+         * @details The counter must outlive every job run with it, which wait() ensures.
+         */
+        class Counter final {
+
+            friend class Scheduler;
+
+        public:
+
+            /** Constructs a new Counter with no pending jobs. */
+            Counter() : pending_(0) {}
+
+            Counter(const Counter&) = delete;
+            Counter& operator=(const Counter&) = delete;
+
+            /**
+             * @brief Returns the number of unfinished jobs.
+             *
+             * @return unsigned int The number of jobs.
+             */
+            inline unsigned int pending() const { return pending_.load(std::memory_order_acquire); }
+            /**
+             * @brief Have all jobs finished?
+             *
+             * @return true If no jobs are pending.
+             */
+            inline bool done() const { return pending() == 0; }
+
+        private:
+
+            /** The number of unfinished jobs. */
+            std::atomic<unsigned int> pending_;
+
+        };
+
+        /** A queued job. */
+        struct Job {
+            /** The function to run. */
+            Function function;
+            /** The counter decreased once the function returns, or nullptr. */
+            Counter* counter;
+        };
+
+        /**
+         * @brief A Chase-Lev work-stealing deque of jobs.
+         * @details The owning thread pushes and pops jobs at the bottom without locking, while
+         *          other threads steal from the top with a single compare and swap. The ring
+         *          of jobs doubles when full. Replaced rings are kept until the queue is
+         *          destroyed, as a thief may still be reading one.
+         */
+        class WorkQueue final {
+
+        public:
+
+            /** The number of jobs the queue holds before growing. */
+            static const size_t INITIAL_CAPACITY = 256;
+
+            /** Constructs a new, empty Work Queue. */
+            WorkQueue();
+            /** Destroys the queue. Jobs still queued are not run. */
+            ~WorkQueue();
+
+            WorkQueue(const WorkQueue&) = delete;
+            WorkQueue& operator=(const WorkQueue&) = delete;
+
+            /**
+             * @brief Adds a job at the bottom. Only called by the owning thread.
+             *
+             * @param job The job to add.
+             */
+            void push(Job* job);
+            /**
+             * @brief Takes the newest job. Only called by the owning thread.
+             *
+             * @return Job* The job, or nullptr if the queue is empty.
+             */
+            Job* pop();
+            /**
+             * @brief Takes the oldest job. May be called by any thread.
+             *
+             * @return Job* The job, or nullptr if the queue is empty or another thread took it first.
+             */
+            Job* steal();
+
+            /**
+             * @brief Returns the number of queued jobs. Only exact on the owning thread.
+             *
+             * @return size_t The number of jobs.
+             */
+            size_t size() const;
+
+        private:
+
+            /** A ring of job slots. */
+            struct Ring {
+                /** The slots. */
+                std::unique_ptr<std::atomic<Job*>[]> slots;
+                /** The number of slots minus one. The number of slots is a power of two. */
+                int64_t mask;
+
+                /**
+                 * @brief Constructs a new Ring.
+                 *
+                 * @param capacity The number of slots, a power of two.
+                 */
+                explicit Ring(size_t capacity);
+
+                /** Reads a slot. */
+                inline Job* get(int64_t index) const { return slots[index & mask].load(std::memory_order_relaxed); }
+                /** Writes a slot. */
+                inline void put(int64_t index, Job* job) { slots[index & mask].store(job, std::memory_order_relaxed); }
+            };
+
+            /** The index thieves take from. */
+            std::atomic<int64_t> top_;
+            /** The index the owner pushes to. */
+            std::atomic<int64_t> bottom_;
+            /** The current ring. */
+            std::atomic<Ring*> ring_;
+            /** Every ring allocated by the queue, freed with it. */
+            std::vector<std::unique_ptr<Ring>> rings_;
+
+        };
+
+        /**
+         * @brief Starts the worker threads. The calling thread becomes the owner of the job system
+         *        and must also be the one to call stop().
+         *
+         * @param workers The number of worker threads. 0 starts one per core besides the calling
+         *                thread, which may be none on a single core.
+         */
+        void start(unsigned int workers = 0);
+
+        /** Stops the worker threads, first running every job still queued. */
+        void stop();
+
+        /**
+         * @brief Is the job system running?
+         *
+         * @return true If start() has been called without stop().
+         */
+        bool running();
+
+        /**
+         * @brief Returns the number of worker threads.
+         *
+         * @return unsigned int The number of workers, not counting the owning thread.
+         */
+        unsigned int workerCount();
+
+        /**
+         * @brief Queues a job with no way to wait for it.
+         *        Runs the function at once if the job system is not running.
+         *
+         * @param function The function to run.
+         */
+        void run(Function function);
+        /**
+         * @brief Queues a job, increasing a counter until it finishes.
+         *        Runs the function at once if the job system is not running.
+         *
+         * @param function The function to run.
+         * @param counter The counter of the job's group.
+         */
+        void run(Function function, Counter& counter);
+
+        /**
+         * @brief Runs queued jobs until a counter reaches zero.
+         *
+         * @param counter The counter to wait on.
+         */
+        void wait(Counter& counter);
+
+        /**
+         * @brief Runs a single queued job on the calling thread, if one can be found.
+         *
+         * @return true If a job was run.
+         */
+        bool help();
+
+        /**
+         * @brief Runs a function over a range of indices in parallel, returning once every index
+         *        has been processed.
+         * @details The range is split in half for as long as other threads take the halves,
+         *          down to the grain size, so the number of jobs follows the number of idle
+         *          threads rather than the size of the range.
+         *
+         * @param begin The first index.
+         * @param end One past the last index.
+         * @param body Processes the indices from its begin up to its end.
+         * @param grain The smallest range split off as a job. 0 chooses one from the size of the
+         *              range and the number of workers.
+         */
+        void parallelFor(size_t begin, size_t end, const RangeFunction& body, size_t grain = 0);
+
+        /**
+         * @brief Returns the number of jobs run since the job system started.
+         *
+         * @return uint64_t The number of jobs.
+         */
+        uint64_t executed();
+        /**
+         * @brief Returns the number of jobs taken from the queue of another thread.
+         *
+         * @return uint64_t The number of stolen jobs.
+         */
+        uint64_t stolen();
+
+    }
+
+}
+
+#endif
@@ -4,6 +4,8 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 
+#include "Memory.hpp"
+
 namespace seedengine {
 
     /*
@@ -41,22 +43,25 @@ namespace seedengine {
     };
 }
 
-#define ENGINE_TRACE(...) seedengine::Log::getEngineLogger()->trace(__VA_ARGS__)
+// Messages count their allocations against the log until the end of the statement
+#define LOG_MEMORY_SCOPE seedengine::MemoryTagScope(seedengine::MemoryTag::LOG)
+
+#define ENGINE_TRACE(...) (LOG_MEMORY_SCOPE, seedengine::Log::getEngineLogger()->trace(__VA_ARGS__))
 #ifdef ENGINE_COMPILE_DEBUG
-    #define ENGINE_DEBUG(...) seedengine::Log::getEngineLogger()->debug(__VA_ARGS__)
+    #define ENGINE_DEBUG(...) (LOG_MEMORY_SCOPE, seedengine::Log::getEngineLogger()->debug(__VA_ARGS__))
 #else
     #define ENGINE_DEBUG(...)
 #endif
-#define ENGINE_INFO(...) seedengine::Log::getEngineLogger()->info(__VA_ARGS__)
-#define ENGINE_WARN(...) seedengine::Log::getEngineLogger()->warn(__VA_ARGS__)
-#define ENGINE_ERROR(...) seedengine::Log::getEngineLogger()->error(__VA_ARGS__)
-#define ENGINE_CRIT(...) seedengine::Log::getEngineLogger()->critical(__VA_ARGS__)
-
-#define CLIENT_TRACE(...) seedengine::Log::getClientLogger()->trace(__VA_ARGS__)
-#define CLIENT_DEBUG(...) seedengine::Log::getClientLogger()->debug(__VA_ARGS__)
-#define CLIENT_INFO(...) seedengine::Log::getClientLogger()->info(__VA_ARGS__)
-#define CLIENT_WARN(...) seedengine::Log::getClientLogger()->warn(__VA_ARGS__)
-#define CLIENT_ERROR(...) seedengine::Log::getClientLogger()->error(__VA_ARGS__)
-#define CLIENT_CRIT(...) seedengine::Log::getClientLogger()->critical(__VA_ARGS__)
+#define ENGINE_INFO(...) (LOG_MEMORY_SCOPE, seedengine::Log::getEngineLogger()->info(__VA_ARGS__))
+#define ENGINE_WARN(...) (LOG_MEMORY_SCOPE, seedengine::Log::getEngineLogger()->warn(__VA_ARGS__))
+#define ENGINE_ERROR(...) (LOG_MEMORY_SCOPE, seedengine::Log::getEngineLogger()->error(__VA_ARGS__))
+#define ENGINE_CRIT(...) (LOG_MEMORY_SCOPE, seedengine::Log::getEngineLogger()->critical(__VA_ARGS__))
+
+#define CLIENT_TRACE(...) (LOG_MEMORY_SCOPE, seedengine::Log::getClientLogger()->trace(__VA_ARGS__))
+#define CLIENT_DEBUG(...) (LOG_MEMORY_SCOPE, seedengine::Log::getClientLogger()->debug(__VA_ARGS__))
+#define CLIENT_INFO(...) (LOG_MEMORY_SCOPE, seedengine::Log::getClientLogger()->info(__VA_ARGS__))
+#define CLIENT_WARN(...) (LOG_MEMORY_SCOPE, seedengine::Log::getClientLogger()->warn(__VA_ARGS__))
+#define CLIENT_ERROR(...) (LOG_MEMORY_SCOPE, seedengine::Log::getClientLogger()->error(__VA_ARGS__))
+#define CLIENT_CRIT(...) (LOG_MEMORY_SCOPE, seedengine::Log::getClientLogger()->critical(__VA_ARGS__))
 
 #endif
\ No newline at end of file
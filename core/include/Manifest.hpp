@@ -0,0 +1,182 @@
+#ifndef SEEDENGINE_INCLUDE_MANIFEST_H_
+#define SEEDENGINE_INCLUDE_MANIFEST_H_
+
+#include "Core.hpp"
+
+#include <atomic>
+
+namespace seedengine {
+
+    /** The type of data stored in an asset file. */
+    enum class AssetType : unsigned int {
+        /** An asset with an unrecognized file extension. */
+        UNKNOWN  = 0,
+        /** An image file such as *.png or *.jpg. */
+        IMAGE    = 1,
+        /** A *.mesh file. */
+        MESH     = 2,
+        /** A *.glsl shader source file. */
+        SHADER   = 3,
+        /** A *.ini configuration file. */
+        CONFIG   = 4,
+        /** A material template file. */
+        MATERIAL = 5
+    };
+
+    /**
+     * @brief The manifest entry of a single asset file.
+     * @details
+     */
+    struct AssetRecord {
+        /** The absolute path to the asset. */
+        string path;
+        /** The size of the asset in bytes. */
+        uint64_t size;
+        /** The FNV-1a hash of the asset contents. Zero if the hash has not been computed. */
+        uint64_t hash;
+        /** The type of the asset. */
+        AssetType type;
+    };
+
+    /**
+     * @brief An in-memory index of every asset file available to the engine.
+     * @details The manifest is either loaded from a file generated by `tools.py manifest`, or built
+     *          by a single directory walk at startup. Once a root directory is covered by the manifest,
+     *          existence and size queries for paths under that root are answered from memory, and the
+     *          filesystem is only touched when asset data is actually read.
+     *
+     *          All queries may be made from any thread, such as by asset loaders on job workers.
+     *
+     * @see #Asset
+     */
+    class AssetManifest final {
+
+    public:
+
+        /**
+         * @brief Loads a manifest file generated by the project tools.
+         * @details Paths in the manifest file are relative to the directory containing it.
+         *
+         * @param manifest_path The path to the manifest file.
+         * @return true If the manifest was loaded.
+         * @return false If the manifest file could not be read.
+         */
+        static bool load(const string& manifest_path);
+
+        /**
+         * @brief Builds manifest entries by walking a directory tree once.
+         * @details Hashes are not computed during a scan. Call hash() to compute them on demand.
+         *
+         * @param root The directory to walk.
+         * @return unsigned int The number of assets added to the manifest.
+         */
+        static unsigned int scan(const string& root);
+
+        /**
+         * @brief Is the path within a directory covered by the manifest?
+         *
+         * @param path The path to check.
+         * @return true If the manifest is authoritative for this path.
+         */
+        static bool covers(const string& path);
+
+        /**
+         * @brief Checks if an asset exists. Covered paths in the manifest are answered from
+         *        memory. All others fall back to opening the file, and covered files found on
+         *        disk are added, so a stale manifest only costs a probe.
+         *
+         * @param path The path to the asset.
+         * @return true If the asset exists.
+         */
+        static bool exists(const string& path);
+
+        /**
+         * @brief Returns the manifest entry for an asset. Entries are never moved, so the entry
+         *        stays valid until clear() is called. Read its hash through
+         *        hash(), which may fill it in from another thread.
+         *
+         * @param path The path to the asset.
+         * @return const AssetRecord* The entry, or nullptr if the asset is not in the manifest.
+         */
+        static const AssetRecord* find(const string& path);
+
+        /**
+         * @brief Returns the size of an asset in bytes.
+         *
+         * @param path The path to the asset.
+         * @return uint64_t The size of the asset, or zero if it is not in the manifest.
+         */
+        static uint64_t size(const string& path);
+
+        /**
+         * @brief Returns the content hash of an asset, reading the file if the hash is not yet known.
+         *
+         * @param path The path to the asset.
+         * @return uint64_t The hash of the asset, or zero if it is not in the manifest.
+         */
+        static uint64_t hash(const string& path);
+
+        /**
+         * @brief Returns the number of assets in the manifest.
+         *
+         * @return size_t The number of assets in the manifest.
+         */
+        static size_t count();
+
+        /**
+         * @brief Returns the number of filesystem probes answered from memory.
+         *
+         * @return unsigned long The number of filesystem probes avoided.
+         */
+        static unsigned long probesAvoided();
+
+        /** Removes all entries and covered roots from the manifest. */
+        static void clear();
+
+        /**
+         * @brief Determines the asset type of a path from its extension.
+         *
+         * @param path The path to check.
+         * @return AssetType The type of asset.
+         */
+        static AssetType typeOf(const string& path);
+
+        /**
+         * @brief Computes the 64 bit FNV-1a hash of a file.
+         *
+         * @param path The path to the file.
+         * @return uint64_t The hash of the file.
+         */
+        static uint64_t hashFile(const string& path);
+
+    private:
+
+        /**
+         * @brief Is the path within a directory covered by the manifest? The mutex must be held.
+         *
+         * @param path The path to check.
+         * @return true If the manifest is authoritative for this path.
+         */
+        static bool coversLocked(const string& path);
+
+        /**
+         * @brief Adds a directory to the list of roots covered by the manifest. The mutex must be held.
+         *
+         * @param root The directory to add.
+         */
+        static void addRoot(const string& root);
+
+        /** A mutex guarding the entries and covered roots. */
+        static std::mutex mu_;
+        /** A map of all manifest entries to their absolute paths. */
+        static std::unordered_map<string, AssetRecord> records_;
+        /** The directories the manifest is authoritative for. Each ends with a separator. */
+        static std::vector<string> roots_;
+        /** The number of filesystem probes answered from memory. */
+        static std::atomic<unsigned long> probes_avoided_;
+
+    };
+
+}
+
+#endif
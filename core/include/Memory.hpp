@@ -0,0 +1,263 @@
+#ifndef SEEDENGINE_INCLUDE_MEMORY_H_
+#define SEEDENGINE_INCLUDE_MEMORY_H_
+
+// Included by Log.hpp, so this only depends on the standard library
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace seedengine {
+
+    /** The subsystem an allocation is counted against. */
+    enum class MemoryTag : uint8_t {
+        UNTAGGED,
+        MESH,
+        IMAGE,
+        EVENTS,
+        SCENE,
+        RENDER,
+        LOG
+    };
+
+    /** The memory counted against a #MemoryTag. */
+    struct MemoryUsage {
+        /** The number of bytes allocated and not yet freed. */
+        uint64_t live_bytes;
+        /** The most bytes that were live at once. */
+        uint64_t peak_bytes;
+        /** The number of allocations not yet freed. */
+        uint64_t live_allocations;
+        /** The total number of allocations. */
+        uint64_t allocations;
+        /** The number of allocations in the last ended frame. */
+        uint64_t frame_allocations;
+    };
+
+    /**
+     * @brief Counts the live bytes, peak bytes and allocations per frame of each subsystem.
+     * @details Memory is counted when it is allocated through the tracker, such as by a
+     *          #TrackedAllocator or, when the engine is built with ENGINE_TRACK_MEMORY, by the
+     *          global operator new, which counts against the tag of the innermost
+     *          #MemoryTagScope of the thread. Counting takes a few relaxed atomic operations and
+     *          no lock, so allocations from any thread may be counted. Frames are ended and
+     *          limits are set from a single controlling thread.
+     */
+    class MemoryTracker final {
+
+    public:
+
+        /** The number of tags. */
+        static const size_t TAGS = 7;
+        /** The frame limit of tags that may allocate freely. */
+        static const uint64_t NO_LIMIT = ~0ull;
+
+        /**
+         * @brief Allocates memory counted against a tag, aligned for any type.
+         *
+         * @param size The number of bytes.
+         * @param tag The tag the bytes are counted against.
+         * @return void* The memory, or nullptr if it could not be allocated.
+         */
+        static void* allocate(size_t size, MemoryTag tag);
+        /**
+         * @brief Resizes memory from allocate(), keeping its contents, like realloc().
+         *
+         * @param memory The memory to resize, or nullptr to allocate.
+         * @param size The new number of bytes.
+         * @param tag The tag the new bytes are counted against.
+         * @return void* The resized memory, or nullptr if it could not be resized, in which
+         *               case the old memory is untouched.
+         */
+        static void* reallocate(void* memory, size_t size, MemoryTag tag);
+        /**
+         * @brief Frees memory from allocate().
+         *
+         * @param memory The memory to free, or nullptr.
+         */
+        static void deallocate(void* memory);
+
+        /**
+         * @brief Ends a frame, checking the allocations of each tag against its limit.
+         *
+         * @return true If no tag allocated more than its limit during the frame.
+         */
+        static bool endFrame();
+        /**
+         * @brief Limits the allocations of a tag per frame. Frames over the limit are logged
+         *        and counted as violations, so steady state can be held to zero allocations.
+         *
+         * @param tag The tag to limit.
+         * @param limit The number of allocations allowed per frame, or NO_LIMIT.
+         */
+        static void setFrameLimit(MemoryTag tag, uint64_t limit);
+        /**
+         * @brief Limits the allocations of every tag per frame.
+         *
+         * @param limit The number of allocations allowed per frame, or NO_LIMIT.
+         */
+        static void setFrameLimit(uint64_t limit);
+        /**
+         * @brief Returns the number of frames that went over a limit.
+         *
+         * @return uint64_t The number of frames.
+         */
+        static uint64_t violations();
+
+        /**
+         * @brief Returns the memory counted against a tag.
+         *
+         * @param tag The tag.
+         * @return MemoryUsage The memory of the tag.
+         */
+        static MemoryUsage usage(MemoryTag tag);
+        /**
+         * @brief Returns the memory counted against every tag. The peak is the sum of the
+         *        peaks of each tag.
+         *
+         * @return MemoryUsage The memory of every tag.
+         */
+        static MemoryUsage total();
+        /**
+         * @brief Returns the number of allocations of a tag in the frame so far.
+         *
+         * @param tag The tag.
+         * @return uint64_t The number of allocations.
+         */
+        static uint64_t frameAllocations(MemoryTag tag);
+        /** Lowers the peak of each tag to its live bytes. */
+        static void resetPeaks();
+
+        /**
+         * @brief Are the global operator new and delete counted?
+         *
+         * @return true If the engine was built with ENGINE_TRACK_MEMORY.
+         */
+        static bool isHooked();
+        /**
+         * @brief Returns the name of a tag, such as "Assets/Mesh".
+         *
+         * @param tag The tag.
+         * @return const char* The name of the tag.
+         */
+        static const char* tagName(MemoryTag tag);
+
+        /**
+         * @brief Writes the memory of each tag that has allocated.
+         *
+         * @param out The stream to write to.
+         */
+        static void report(std::ostream& out);
+        /**
+         * @brief Returns a one line summary of the live and peak bytes of each tag.
+         *
+         * @return std::string The summary.
+         */
+        static std::string summary();
+
+    };
+
+    /**
+     * @brief Counts allocations of the global operator new on this thread against a tag, for
+     *        as long as it exists. Only has an effect when built with ENGINE_TRACK_MEMORY.
+     */
+    class MemoryTagScope final {
+
+    public:
+
+        /**
+         * @brief Enters a tag.
+         *
+         * @param tag The tag to count allocations against.
+         */
+        explicit MemoryTagScope(MemoryTag tag) : previous_(current_) { current_ = tag; }
+        /** Returns to the tag before it. */
+        ~MemoryTagScope() { current_ = previous_; }
+
+        MemoryTagScope(const MemoryTagScope&) = delete;
+        MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+        /**
+         * @brief Returns the tag allocations of this thread are counted against.
+         *
+         * @return MemoryTag The tag of the innermost scope.
+         */
+        static inline MemoryTag current() { return current_; }
+
+    private:
+
+        /** The tag before this scope. */
+        MemoryTag previous_;
+        /** The tag of the innermost scope of each thread. */
+        static thread_local MemoryTag current_;
+
+    };
+
+    /**
+     * @brief A standard allocator that counts its memory against a tag.
+     *
+     * @tparam T The type allocated.
+     * @tparam Tag The tag the memory is counted against.
+     */
+    template <class T, MemoryTag Tag>
+    class TrackedAllocator {
+
+    public:
+
+        typedef T value_type;
+
+        /** The allocator of another type with the same tag. */
+        template <class U>
+        struct rebind {
+            typedef TrackedAllocator<U, Tag> other;
+        };
+
+        TrackedAllocator() = default;
+        template <class U>
+        TrackedAllocator(const TrackedAllocator<U, Tag>&) {}
+
+        /**
+         * @brief Allocates memory for a number of values.
+         *
+         * @param count The number of values.
+         * @return T* The memory.
+         */
+        T* allocate(size_t count) {
+            static_assert(alignof(T) <= alignof(std::max_align_t), "Tracked types may not be over-aligned.");
+            void* memory = MemoryTracker::allocate(count * sizeof(T), Tag);
+            if (memory == nullptr) throw std::bad_alloc();
+            return static_cast<T*>(memory);
+        }
+
+        /**
+         * @brief Frees memory from allocate().
+         *
+         * @param memory The memory.
+         */
+        void deallocate(T* memory, size_t) {
+            MemoryTracker::deallocate(memory);
+        }
+
+    };
+
+    template <class T, class U, MemoryTag Tag>
+    inline bool operator==(const TrackedAllocator<T, Tag>&, const TrackedAllocator<U, Tag>&) { return true; }
+    template <class T, class U, MemoryTag Tag>
+    inline bool operator!=(const TrackedAllocator<T, Tag>&, const TrackedAllocator<U, Tag>&) { return false; }
+
+    /** A vector with its memory counted against a tag. */
+    template <class T, MemoryTag Tag>
+    using TrackedVector = std::vector<T, TrackedAllocator<T, Tag>>;
+
+    /** Frees memory from MemoryTracker::allocate(), such as for a std::unique_ptr. */
+    struct TrackedDeleter {
+        void operator()(void* memory) const { MemoryTracker::deallocate(memory); }
+    };
+
+}
+
+#endif
@@ -4,6 +4,7 @@
 #include "Core.hpp"
 #include "Parser.hpp"
 #include "Asset.hpp"
+#include "Memory.hpp"
 
 namespace seedengine {
 
@@ -21,13 +22,13 @@ namespace seedengine {
      */
     struct mesh_data {
 
-        std::vector<float> positions;
-        std::vector<float> normals;
-        std::vector<float> uvs;
-        std::vector<float> colors;
-        std::vector<float> bone_weights;
-        std::vector<float> morphs;
-        std::vector<uint32_t> indices;
+        TrackedVector<float, MemoryTag::MESH> positions;
+        TrackedVector<float, MemoryTag::MESH> normals;
+        TrackedVector<float, MemoryTag::MESH> uvs;
+        TrackedVector<float, MemoryTag::MESH> colors;
+        TrackedVector<float, MemoryTag::MESH> bone_weights;
+        TrackedVector<float, MemoryTag::MESH> morphs;
+        TrackedVector<uint32_t, MemoryTag::MESH> indices;
 
         uint8_t uvs_per_vertex;
         uint8_t colors_per_vertex;
@@ -86,6 +87,32 @@ namespace seedengine {
 
     public:
 
+        /**
+         * @brief Gets the number of indices drawn for this mesh.
+         * 
+         * @return uint32_t The number of indices.
+         */
+        inline uint32_t indexCount() const { return index_count_; }
+        /**
+         * @brief Gets the minimum corner of the bounding box of this mesh.
+         * 
+         * @return glm::vec3 The minimum corner of the bounding box.
+         */
+        inline glm::vec3 boundsMin() const { return bounds_min_; }
+        /**
+         * @brief Gets the maximum corner of the bounding box of this mesh.
+         * 
+         * @return glm::vec3 The maximum corner of the bounding box.
+         */
+        inline glm::vec3 boundsMax() const { return bounds_max_; }
+
+        /**
+         * @brief Gets the number of bytes of mesh data held in CPU memory.
+         * 
+         * @return size_t The number of bytes held.
+         */
+        size_t residentBytes() const override;
+
     protected:
 
         /**
@@ -97,8 +124,28 @@ namespace seedengine {
 
         /** Loads this mesh into memory. */
         void load();
+        /**
+         * @brief Loads this mesh from bytes already read from its file.
+         *
+         * @param bytes The contents of the file, or empty to read the file.
+         */
+        void load(const std::vector<char>& bytes) override;
         /** Unloads this mesh from memory. */
         void unload();
+        /** Reloads the full CPU copy of this mesh. */
+        void reload();
+        /**
+         * @brief Releases the CPU copy of this mesh. COMPACT keeps the positions and indices
+         *        as a collision proxy, DISCARD frees everything.
+         */
+        void release();
+
+        /** The number of indices drawn for this mesh. */
+        uint32_t index_count_ = 0;
+        /** The minimum corner of the bounding box of this mesh. */
+        glm::vec3 bounds_min_ = glm::vec3(0.0f, 0.0f, 0.0f);
+        /** The maximum corner of the bounding box of this mesh. */
+        glm::vec3 bounds_max_ = glm::vec3(0.0f, 0.0f, 0.0f);
 
         // Check for OpenGL
         #if ENGINE_GRAPHICS_API == ENGINE_GRAPHICS_OPGL
@@ -117,7 +164,7 @@ namespace seedengine {
              * @param size The size of the data elements.
              * @param data The data to bind.
              */
-            void opglCreateVertexBuffer(uint32_t location, uint32_t size, std::vector<float> data) {
+            void opglCreateVertexBuffer(uint32_t location, uint32_t size, const TrackedVector<float, MemoryTag::MESH>& data) {
                 GLuint buffer;
                 glGenBuffers(1, &buffer);
                 glBindBuffer(GL_ARRAY_BUFFER, buffer);
@@ -140,7 +187,7 @@ namespace seedengine {
              * 
              * @param data The data to bind.
              */
-            void opglCreateIndicesBuffer(std::vector<uint32_t> data) {
+            void opglCreateIndicesBuffer(const TrackedVector<uint32_t, MemoryTag::MESH>& data) {
                 glGenBuffers(1, &indices_buffer_);
                 glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices_buffer_);
                 glBufferData(
@@ -179,10 +226,11 @@ namespace seedengine {
          *
          * @param path The path to the mesh to be loaded.
          * @param out The data stored within the passed file.
+         * @param bytes The contents of the file if already read, or nullptr to read the file.
          * @return true If the mesh data was able to be extracted.
          * @return false If the mesh data was not able to be extracted.
          */
-        static bool parse(const string& path, mesh_data* out);
+        static bool parse(const string& path, mesh_data* out, const std::vector<char>* bytes = nullptr);
 
     };
 
@@ -2,6 +2,7 @@
 #define SEEDENGINE_INCLUDE_OBJECT_H_
 
 #include "Core.hpp"
+#include "Timer.hpp"
 
 namespace seedengine {
 
@@ -68,14 +69,19 @@ namespace seedengine {
         // Static Functions
 
         /**
-         * @brief Calls the destructor on the passed Object.
+         * @brief Calls the destructor on the passed Object. Delayed destruction is scheduled
+         *        with #Timers, so the Object must not be deleted by anything else meanwhile.
+         * @details May be called from any thread. Off the dispatch thread, such as from a
+         *          component update on a job worker, a delayed destruction is posted to the
+         *          dispatch thread and scheduled when it next runs the events. It then has no
+         *          handle and cannot be cancelled.
          * 
          * @param obj The Object to destroy.
-         * @param delay The delay before destroying the Object. Defaults to 0.
+         * @param delay The game time in seconds before destroying the Object. Defaults to 0.
+         * @return TimerId The handle used to cancel a delayed destruction, or 0 if the Object
+         *         was destroyed immediately or the destruction was posted to the dispatch thread.
          */
-        static void Destroy(Object* obj, float delay = 0.0f) {
-            delete obj;
-        }
+        static TimerId Destroy(Object* obj, float delay = 0.0f);
 
     protected:
 
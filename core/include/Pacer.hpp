@@ -0,0 +1,135 @@
+#ifndef SEEDENGINE_INCLUDE_PACER_H_
+#define SEEDENGINE_INCLUDE_PACER_H_
+
+#include "Core.hpp"
+#include "Stats.hpp"
+#include "Time.hpp"
+
+namespace seedengine {
+
+    /**
+     * @brief Waits for frame deadlines without keeping a core busy.
+     * @details The pacer sleeps until shortly before the deadline, then yields in a short spin
+     *          until the deadline passes. OS sleeps often wake a little late, and the spin
+     *          margin absorbs that. A sleep that wakes past its deadline widens the margin to
+     *          cover the oversleep, up to MAX_SPIN_NS, and sleeps that wake on time narrow it
+     *          back toward the configured margin, so one late wake up does not cost CPU time
+     *          for the rest of the run. On Windows the pacer raises the system timer resolution
+     *          to 1 ms from its first sleep until it is destroyed. Every wait records how far
+     *          past the deadline it woke and the interval between frames, so pacing can be
+     *          compared with a plain busy wait.
+     *          Times are nanoseconds on the Time::nowNS() clock.
+     */
+    class FramePacer final {
+
+    public:
+
+        /** The default time before a deadline at which sleeping stops and spinning starts. */
+        static const int64_t DEFAULT_SPIN_NS = 1000000;
+        /** The widest margin the pacer grows to after waking late. */
+        static const int64_t MAX_SPIN_NS = 4000000;
+
+        /**
+         * @brief Constructs a new Frame Pacer.
+         *
+         * @param spin_ns The time before a deadline at which sleeping stops.
+         */
+        explicit FramePacer(int64_t spin_ns = DEFAULT_SPIN_NS);
+        /** Restores the system timer resolution if the pacer raised it. */
+        ~FramePacer();
+
+        FramePacer(const FramePacer&) = delete;
+        FramePacer& operator=(const FramePacer&) = delete;
+
+        /**
+         * @brief Waits until a deadline, returning at once if it has passed.
+         *
+         * @param deadline_ns The time to wake at.
+         * @return int64_t How late the wait returned, in nanoseconds.
+         */
+        int64_t waitUntil(int64_t deadline_ns);
+
+        /**
+         * @brief Sets the time before a deadline at which sleeping stops and spinning starts.
+         *        Larger margins wake more precisely on coarse OS timers but use more CPU time.
+         *        Late wake ups widen the margin for a while, and it then decays back to this one.
+         *
+         * @param spin_ns The spin margin in nanoseconds.
+         */
+        inline void setSpinMargin(int64_t spin_ns) { spin_ns_ = base_spin_ns_ = spin_ns > 0 ? spin_ns : 0; }
+        /**
+         * @brief Returns the current time before a deadline at which sleeping stops.
+         *
+         * @return int64_t The spin margin in nanoseconds.
+         */
+        inline int64_t spinMargin() const { return spin_ns_; }
+
+        /**
+         * @brief Returns how late each wait returned.
+         *
+         * @return const util::Histogram& The pacing errors in nanoseconds.
+         */
+        inline const util::Histogram& errors() const { return errors_; }
+        /**
+         * @brief Returns the time between the ends of consecutive waits.
+         *
+         * @return const util::Histogram& The frame intervals in nanoseconds.
+         */
+        inline const util::Histogram& intervals() const { return intervals_; }
+        /**
+         * @brief Returns the standard deviation of the frame intervals.
+         *
+         * @return double The standard deviation in nanoseconds.
+         */
+        double intervalDeviation() const;
+        /**
+         * @brief Returns the total time spent asleep.
+         *
+         * @return int64_t The sleep time in nanoseconds.
+         */
+        inline int64_t sleptNS() const { return slept_ns_; }
+        /**
+         * @brief Returns the total time spent spinning.
+         *
+         * @return int64_t The spin time in nanoseconds.
+         */
+        inline int64_t spunNS() const { return spun_ns_; }
+
+        /**
+         * @brief Returns the pacing statistics as a single line of text.
+         *
+         * @return string The formatted statistics.
+         */
+        string summary() const;
+
+        /** Clears the pacing statistics. */
+        void reset();
+
+    private:
+
+        /** The current spin margin. */
+        int64_t spin_ns_;
+        /** The configured spin margin the current one decays back to. */
+        int64_t base_spin_ns_;
+        /** Has the pacer raised the system timer resolution? */
+        bool timer_period_ = false;
+        /** How late each wait returned. */
+        util::Histogram errors_;
+        /** The time between the ends of consecutive waits. */
+        util::Histogram intervals_;
+        /** The end of the last wait, or -1 before the first. */
+        int64_t last_wake_ns_ = -1;
+        /** The mean frame interval, updated incrementally. */
+        double interval_mean_ = 0.0;
+        /** The sum of squared differences from the mean frame interval. */
+        double interval_m2_ = 0.0;
+        /** The total time spent asleep. */
+        int64_t slept_ns_ = 0;
+        /** The total time spent spinning. */
+        int64_t spun_ns_ = 0;
+
+    };
+
+}
+
+#endif
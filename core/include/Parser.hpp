@@ -3,6 +3,11 @@
 
 #include "Core.hpp"
 
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstring>
+
 namespace seedengine {
     namespace util {
 
@@ -31,21 +36,376 @@ namespace seedengine {
             std::ifstream file_;
         };
 
+        /** The type of a value stored in an .ini file. */
+        enum class ConfigType : unsigned char {
+            NONE   = 0,
+            INT    = 1,
+            FLOAT  = 2,
+            BOOL   = 3,
+            STRING = 4
+        };
+
+        /** A single value stored in an .ini file. */
+        struct ConfigEntry {
+            /** The combined interned (section, key) id of this entry. Zero if the slot is empty. */
+            uint64_t id = 0;
+            /** The type of this entry. */
+            ConfigType type = ConfigType::NONE;
+            /** The value of this entry if it is an integer. */
+            int int_value = 0;
+            /** The value of this entry if it is a float. */
+            float float_value = 0.0f;
+            /** The value of this entry if it is a boolean. */
+            bool bool_value = false;
+            /** The value of this entry if it is a string. */
+            string string_value;
+        };
+
+        /**
+         * @brief A flat open addressing hash table of .ini values keyed by interned ids.
+         * @details Tables are built once by a parser and are immutable once published.
+         */
+        class ConfigTable final {
+
+        public:
+
+            /**
+             * @brief Constructs a new empty Config Table.
+             * 
+             * @param capacity The number of entries to reserve space for.
+             */
+            explicit ConfigTable(size_t capacity = 8);
+
+            /**
+             * @brief Finds or adds the entry with the passed id.
+             * 
+             * @param id The combined (section, key) id of the entry.
+             * @return ConfigEntry& The entry.
+             */
+            ConfigEntry& insert(uint64_t id);
+
+            /**
+             * @brief Finds the entry with the passed id.
+             * 
+             * @param id The combined (section, key) id of the entry.
+             * @return const ConfigEntry* The entry, or nullptr if it does not exist or the id is zero.
+             */
+            const ConfigEntry* find(uint64_t id) const;
+
+            /**
+             * @brief Returns the number of entries in this table.
+             * 
+             * @return size_t The number of entries.
+             */
+            inline size_t size() const { return count_; }
+
+            /**
+             * @brief Returns all slots of this table, including empty slots with an id of zero.
+             * 
+             * @return const std::vector<ConfigEntry>& The slots of this table.
+             */
+            inline const std::vector<ConfigEntry>& slots() const { return slots_; }
+
+            /** The generation of this table. Each table published by a parser has a new generation. */
+            unsigned int generation = 0;
+
+        private:
+
+            /**
+             * @brief Mixes the bits of an id into a slot index.
+             * 
+             * @param id The id to hash.
+             * @return size_t The hashed id.
+             */
+            static size_t hash(uint64_t id);
+
+            /** Doubles the number of slots in this table. */
+            void grow();
+
+            /** The slots of this table. The size is always a power of two. */
+            std::vector<ConfigEntry> slots_;
+            /** The number of occupied slots. */
+            size_t count_ = 0;
+
+        };
+
+        /**
+         * @brief A value in a compiled config blob. Entries are stored sorted by hash.
+         * @details All fields are little endian. Names are stored in the pool as
+         *          "section\0key\0" and string values as raw bytes.
+         */
+        struct ConfigBlobEntry {
+            /** The FNV-1a hash of "section\0key". */
+            uint64_t hash;
+            /** The offset of the names of this entry in the pool. */
+            uint32_t name;
+            /** The #ConfigType of this entry. */
+            uint32_t type;
+            /** The bits of an int, float or bool value, or the offset of a string value in the pool. */
+            uint32_t value;
+            /** The length of a string value. */
+            uint32_t length;
+        };
+
+        /**
+         * @brief A compiled .ini file mapped into memory and read in place.
+         * @details The blob holds a header, a key table sorted by hash and a pool of names and
+         *          string values. Blobs are written by compile() or `tools.py config`, and
+         *          lookups are a binary search over the mapped key table.
+         */
+        class ConfigBlob final {
+
+        public:
+
+            /** The magic number at the start of every blob, "SCFG". */
+            static const uint32_t MAGIC = 0x47464353;
+            /** The format version of blobs written by this build. */
+            static const uint32_t VERSION = 1;
+
+            /** Constructs a new closed Config Blob. */
+            ConfigBlob() = default;
+            /** Unmaps the blob. */
+            ~ConfigBlob();
+
+            ConfigBlob(const ConfigBlob&) = delete;
+            ConfigBlob& operator=(const ConfigBlob&) = delete;
+
+            /**
+             * @brief Maps a compiled blob into memory and validates its header and entries.
+             * @details Every name and string value must lie inside the pool and the key table
+             *          must be sorted by hash, otherwise the blob is rejected.
+             * 
+             * @param path The path to the blob.
+             * @return true If the blob was mapped and is valid.
+             */
+            bool open(const string& path);
+            /** Unmaps the blob. */
+            void close();
+
+            /**
+             * @brief Is a blob mapped?
+             * 
+             * @return true If a valid blob is mapped.
+             */
+            inline bool isOpen() const { return entries_ != nullptr; }
+            /**
+             * @brief Returns the number of values in the blob.
+             * 
+             * @return size_t The number of values.
+             */
+            inline size_t size() const { return count_; }
+            /** @return const ConfigBlobEntry* The first entry of the key table. */
+            inline const ConfigBlobEntry* begin() const { return entries_; }
+            /** @return const ConfigBlobEntry* One past the last entry of the key table. */
+            inline const ConfigBlobEntry* end() const { return entries_ + count_; }
+
+            /**
+             * @brief Finds a value in the blob.
+             * 
+             * @param section The section of the value.
+             * @param key The key of the value.
+             * @return const ConfigBlobEntry* The entry, or nullptr if it does not exist.
+             */
+            const ConfigBlobEntry* find(const string& section, const string& key) const;
+
+            /** @return const char* The null terminated section name of an entry. */
+            inline const char* section(const ConfigBlobEntry& entry) const { return pool_ + entry.name; }
+            /** @return const char* The null terminated key name of an entry. */
+            inline const char* key(const ConfigBlobEntry& entry) const {
+                return pool_ + entry.name + std::strlen(pool_ + entry.name) + 1;
+            }
+            /**
+             * @brief Reads the value of an entry into a config entry.
+             * 
+             * @param entry The blob entry.
+             * @param out The entry to write the type and value to.
+             */
+            void read(const ConfigBlobEntry& entry, ConfigEntry& out) const;
+
+            /**
+             * @brief Hashes a section and key name.
+             * 
+             * @param section The section name.
+             * @param key The key name.
+             * @return uint64_t The FNV-1a hash of "section\0key".
+             */
+            static uint64_t hash(const string& section, const string& key);
+
+            /**
+             * @brief Writes a table to a compiled blob.
+             * 
+             * @param path The path of the blob to write.
+             * @param table The table to write.
+             * @return true If the blob was written.
+             */
+            static bool write(const string& path, const ConfigTable& table);
+
+        private:
+
+            /**
+             * @brief Checks that the names and string value of an entry lie inside the pool.
+             * 
+             * @param entry The entry to check.
+             * @return true If the entry may be read.
+             */
+            bool valid(const ConfigBlobEntry& entry) const;
+
+            /** The start of the mapped file. */
+            const char* data_ = nullptr;
+            /** The length of the mapped file. */
+            size_t length_ = 0;
+            /** The key table. */
+            const ConfigBlobEntry* entries_ = nullptr;
+            /** The number of entries in the key table. */
+            size_t count_ = 0;
+            /** The pool of names and string values. */
+            const char* pool_ = nullptr;
+            /** The size of the pool. */
+            size_t pool_size_ = 0;
+
+            #ifdef _WIN32
+                /** The file mapping handle. */
+                HANDLE mapping_ = NULL;
+            #endif
+
+        };
+
+        template <class T>
+        class ConfigValue;
+
         /**
          * @brief A parser for .ini files.
-         * @details
+         * @details The file is parsed lazily on first access by a single pass over its contents.
+         *          Values are stored in a flat hash table keyed by interned section and key ids.
+         *          Hot code should hold a #ConfigValue handle, which caches the value and only
+         *          looks it up again when the parser publishes a new table.
+         * 
+         *          The file can be watched for changes. Each reload publishes a new immutable table
+         *          through an atomic pointer, so reads never lock. Subscribers are notified of changed
+         *          values when dispatchChanges() is called at a frame boundary. Every read holds a
+         *          #Reader, and replaced tables are only freed by dispatchChanges() while no read is
+         *          in progress, so reads may be made from any thread.
          */
         class IniParser final : public Parser {
 
         public:
+
+            /**
+             * @brief Holds the current table for the length of a read, so a reload does not free it meanwhile.
+             * @details Readers count themselves in and out with a single atomic counter, and retired
+             *          tables are freed while the counter is zero. A reader should not be held across
+             *          frame boundaries, or retired tables are kept until it is released.
+             */
+            class Reader final {
+
+            public:
+
+                /**
+                 * @brief Starts a read of the current table, parsing the file if it has not been read yet.
+                 * 
+                 * @param parser The parser to read.
+                 */
+                explicit Reader(const IniParser& parser) : parser_(&parser) {
+                    // Count in before loading the table, so a table retired after the load is not freed
+                    parser_->readers_.fetch_add(1);
+                    try {
+                        table_ = &parser_->current();
+                    }
+                    catch (...) {
+                        parser_->readers_.fetch_sub(1);
+                        throw;
+                    }
+                }
+                /** Starts another read of the same table. */
+                Reader(const Reader& other) : parser_(other.parser_), table_(other.table_) {
+                    parser_->readers_.fetch_add(1);
+                }
+                Reader& operator=(const Reader&) = delete;
+                /** Ends the read. */
+                ~Reader() { parser_->readers_.fetch_sub(1); }
+
+                /** Returns the table being read. */
+                inline const ConfigTable& operator*() const { return *table_; }
+                /** Returns the table being read. */
+                inline const ConfigTable* operator->() const { return table_; }
+
+            private:
+
+                /** The parser being read. */
+                const IniParser* parser_;
+                /** The table being read. */
+                const ConfigTable* table_;
+
+            };
+
+            /** A function called at a frame boundary when a subscribed value has changed. */
+            typedef std::function<void()> ChangeCallback;
+
             /** Removed default INI Parser constructor. */
             IniParser() = delete;
             /**
-             * @brief Constructs a new INI Parser.
+             * @brief Constructs a new INI Parser. The file is not read until a value is requested.
              * 
              * @param filepath The path of the file to parse.
              */
             IniParser(string filepath);
+            /** Stops watching the file and destroys this INI Parser and its parsed data. */
+            ~IniParser();
+
+            /**
+             * @brief Parses the file again if it has changed on the disk and publishes the new values.
+             * 
+             * @return true If a new table was published.
+             */
+            bool reload();
+            /**
+             * @brief Parses another file in place of the current one and publishes its values.
+             *        Subscribers are notified of the differences at the next dispatchChanges().
+             *        Must not be called while the file is watched.
+             * 
+             * @param filepath The path of the file to parse.
+             */
+            void reopen(const string& filepath);
+            /**
+             * @brief Returns the path of the parsed file.
+             * 
+             * @return const string& The path of the parsed file.
+             */
+            inline const string& filepath() const { return filepath_; }
+
+            /**
+             * @brief Starts a background thread that reloads the file when it changes.
+             * 
+             * @param interval_ms The time between checks for changes in milliseconds.
+             */
+            void watch(unsigned int interval_ms);
+            /** Stops the background thread started by watch(). */
+            void unwatch();
+
+            /**
+             * @brief Subscribes to changes of a value.
+             * 
+             * @param section The section of the value.
+             * @param key The key of the value.
+             * @param callback The function called when the value changes, is added or is removed.
+             * @return unsigned int The id of the subscription.
+             */
+            unsigned int subscribe(const string& section, const string& key, ChangeCallback callback);
+            /**
+             * @brief Removes a subscription.
+             * 
+             * @param id The id returned by subscribe().
+             */
+            void unsubscribe(unsigned int id);
+
+            /**
+             * @brief Notifies subscribers of all values changed since the last call and frees
+             *        retired tables if no read is in progress. Must be called from the dispatch thread at a frame boundary,
+             *        which is the simulation thread of a pipelined run.
+             * 
+             * @return unsigned int The number of callbacks called.
+             */
+            unsigned int dispatchChanges();
 
             /**
              * @brief Gets the value associated with the section and key provided.
@@ -117,41 +477,322 @@ namespace seedengine {
              */
             string getString(const string& section, const string& key) const;
 
+            /**
+             * @brief Returns a typed handle to the value associated with the section and key provided.
+             * 
+             * @tparam T The type of the value. One of int, float, bool or string.
+             * @param section The section of the .ini file to check.
+             * @param key The key associated with the value to get.
+             * @return ConfigValue<T> A handle that caches the requested value.
+             */
+            template <class T>
+            ConfigValue<T> value(const string& section, const string& key) const {
+                return ConfigValue<T>(*this, id(section, key));
+            }
+
+            /**
+             * @brief Checks if a value exists for the section and key provided.
+             * 
+             * @param section The section of the .ini file to check.
+             * @param key The key to check.
+             * @return true If the value exists.
+             */
+            bool has(const string& section, const string& key) const;
+
+            /**
+             * @brief Gets the value with the passed id, converting integers to floats if needed.
+             * 
+             * @param id The combined (section, key) id of the value.
+             * @param out A reference that is passed the requested value.
+             * @return true If the value exists with a compatible type.
+             */
+            bool find(uint64_t id, int&    out) const;
+            /** @copydoc find(uint64_t, int&) const */
+            bool find(uint64_t id, float&  out) const;
+            /** @copydoc find(uint64_t, int&) const */
+            bool find(uint64_t id, bool&   out) const;
+            /** @copydoc find(uint64_t, int&) const */
+            bool find(uint64_t id, string& out) const;
+
+            /**
+             * @brief Compiles the parsed values into a binary blob.
+             * @details The blob is preferred over the text file by parsers created later, for as
+             *          long as it is newer than the text file.
+             * 
+             * @param blob_path The path of the blob to write. Defaults to the path of the text file with ".bin" appended.
+             * @return true If the blob was written.
+             */
+            bool compile(const string& blob_path = "") const;
+
+            /**
+             * @brief Was the current table loaded from a compiled blob?
+             * 
+             * @return true If the values came from a compiled blob.
+             */
+            inline bool isCompiled() const { return compiled_; }
+
+            /**
+             * @brief Starts a read of the parsed table, parsing the file if it has not been read yet.
+             * @details The table stays valid for as long as the returned reader is held.
+             * 
+             * @return Reader The read of the current table.
+             */
+            Reader table() const;
+
+            /**
+             * @brief Returns the generation of the current table without touching the table.
+             * 
+             * @return unsigned int The generation of the current table, or zero if the file has not been read.
+             */
+            inline unsigned int generation() const { return generation_.load(std::memory_order_acquire); }
+
+            /**
+             * @brief Interns a section or key name. Only parsing, subscribing and creating value
+             *        handles intern names, so lookups of absent keys do not grow the table.
+             * 
+             * @param name The name to intern.
+             * @return uint32_t The unique non-zero id of the name.
+             */
+            static uint32_t intern(const string& name);
+            /**
+             * @brief Finds the id of a name without interning it. Never locks.
+             * 
+             * @param name The name to find.
+             * @return uint32_t The id of the name, or zero if it has not been interned.
+             */
+            static uint32_t lookup(const string& name);
+            /**
+             * @brief Returns the name of an interned id.
+             * 
+             * @param id The interned id.
+             * @return string The name, or an empty string if the id is unknown.
+             */
+            static string nameOf(uint32_t id);
+            /**
+             * @brief Returns the combined id of a section and key.
+             * 
+             * @param section The section name.
+             * @param key The key name.
+             * @return uint64_t The combined id.
+             */
+            static inline uint64_t id(const string& section, const string& key) {
+                return (static_cast<uint64_t>(intern(section)) << 32) | intern(key);
+            }
+            /**
+             * @brief Finds the combined id of a section and key without interning either.
+             * 
+             * @param section The section name.
+             * @param key The key name.
+             * @return uint64_t The combined id, or zero if either name has not been interned.
+             */
+            static inline uint64_t lookup(const string& section, const string& key) {
+                uint32_t section_id = lookup(section), key_id = lookup(key);
+                return (section_id == 0 || key_id == 0) ? 0 : (static_cast<uint64_t>(section_id) << 32) | key_id;
+            }
+
             /** Prints the contents of this .ini file to the console. */
             void print() const override;
 
         protected:
 
             /**
-             * @brief Parses the file at filepath.
+             * @brief Parses the file at filepath, or loads its compiled blob if the blob is newer.
              * 
              * @param filepath The path of the file to parse.
+             * @return ConfigTable* The parsed table. Never nullptr, empty if the file could not be read.
+             */
+            ConfigTable* parse(string filepath);
+
+            /**
+             * @brief Loads a table from a compiled blob.
+             * 
+             * @param blob_path The path to the blob.
+             * @return ConfigTable* The loaded table, or nullptr if the blob is invalid.
              */
-            void parse(string filepath);
+            ConfigTable* load(const string& blob_path);
 
         private:
 
-            typedef std::map<string, const int> ints;
-            typedef std::map<string, const float> floats;
-            typedef std::map<string, const string> strings;
-            typedef std::map<string, const bool> bools;
-
-            /** A section of an .ini file. */
-            struct section {
-                ints int_data;
-                floats float_data;
-                strings string_data;
-                bools bool_data;
+            /**
+             * @brief Gets the entry with the passed id, throwing if it does not exist.
+             * 
+             * @param reader The read of the table holding the entry.
+             * @param section The section of the .ini file to check.
+             * @param key The key associated with the value to get.
+             * @param type The expected type of the value.
+             * @return const ConfigEntry& The requested entry, valid while the reader is held.
+             */
+            const ConfigEntry& at(const Reader& reader, const string& section, const string& key, ConfigType type) const;
+
+            /**
+             * @brief Returns the current table, parsing the file if it has not been read yet. Only
+             *        called by #Reader, which keeps the table from being freed.
+             * 
+             * @return const ConfigTable& The current table.
+             */
+            const ConfigTable& current() const;
+
+            /**
+             * @brief Checks the modification time and size of the file and records them.
+             * 
+             * @return true If either has changed since the last check.
+             */
+            bool stampChanged() const;
+            /**
+             * @brief Makes a parsed table current and retires the one it replaces. The parse
+             *        mutex must be held.
+             * 
+             * @param parsed The table to publish.
+             */
+            void publish(ConfigTable* parsed);
+
+            /** The function executed by the watcher thread. */
+            void watchLoop(unsigned int interval_ms);
+
+            /** A subscription to changes of a value. */
+            struct Subscription {
+                /** The id of this subscription. */
+                unsigned int id;
+                /** The combined (section, key) id of the value. */
+                uint64_t value_id;
+                /** The function to call when the value changes. */
+                ChangeCallback callback;
             };
 
-            typedef std::map<string, section> ini_data;
+            /** The path of the parsed file. */
+            string filepath_;
+            /** Was the current table loaded from a compiled blob? */
+            std::atomic<bool> compiled_;
+            /** The current table. Null until the file is first read. */
+            mutable std::atomic<const ConfigTable*> table_;
+            /** The generation of the current table, published after the table. */
+            mutable std::atomic<unsigned int> generation_;
+            /** A mutex guarding parsing and the retired tables. */
+            mutable std::mutex parse_mu_;
+            /** The modification time of the file when it was last checked. */
+            mutable int64_t stamp_time_ = -1;
+            /** The size of the file when it was last checked. */
+            mutable int64_t stamp_size_ = -1;
+            /** The number of reads in progress. */
+            mutable std::atomic<unsigned int> readers_;
+            /** Replaced tables waiting for the reads that may hold them to end. */
+            std::vector<const ConfigTable*> retired_;
+            /** The table subscribers were last notified of. */
+            const ConfigTable* dispatched_ = nullptr;
+            /** All active subscriptions. */
+            std::vector<Subscription> subscriptions_;
+            /** The id of the next subscription. */
+            unsigned int next_subscription_ = 1;
+
+            /** The watcher thread. */
+            std::thread watcher_;
+            /** A mutex guarding the watcher flag. */
+            std::mutex watch_mu_;
+            /** Wakes the watcher thread when it should stop. */
+            std::condition_variable watch_cv_;
+            /** Should the watcher thread keep running? */
+            bool watching_ = false;
 
-            /** The data contained within the parsed file. */
-            ini_data parsed_data;
+        };
+
+        /**
+         * @brief A typed handle to a value in an .ini file.
+         * @details The value is cached in the handle. Reading it costs a single comparison
+         *          against the atomic generation of the parser, and the value is only looked
+         *          up again when a new table is published.
+         * 
+         *          The cache is not synchronized, so a handle is read by one thread at a time.
+         *          Threads reading the same value each hold their own handle, and a handle is
+         *          only handed to another thread through a synchronizing step such as starting
+         *          or joining that thread. Debug builds assert that reads do not overlap. The
+         *          handle holds no table between reads, so reloads may free retired tables.
+         * 
+         * @tparam T The type of the value. One of int, float, bool or string.
+         */
+        template <class T>
+        class ConfigValue final {
+
+        public:
+
+            /**
+             * @brief Constructs a new Config Value handle.
+             * 
+             * @param parser The parser holding the value.
+             * @param id The combined (section, key) id of the value.
+             */
+            ConfigValue(const IniParser& parser, uint64_t id) : parser_(&parser), id_(id), reading_(false) {
+                refresh();
+            }
+
+            /**
+             * @brief Copies a Config Value handle. The copy may be read by another thread.
+             * 
+             * @param other The handle to copy.
+             */
+            ConfigValue(const ConfigValue& other) : parser_(other.parser_), id_(other.id_),
+                    generation_(other.generation_), value_(other.value_), reading_(false) {
+
+            }
+
+            ConfigValue& operator=(const ConfigValue& other) {
+                parser_ = other.parser_;
+                id_ = other.id_;
+                generation_ = other.generation_;
+                value_ = other.value_;
+                return *this;
+            }
+
+            /**
+             * @brief Returns the cached value, refreshing it if the parser has new data.
+             *        Must not be called by two threads at once.
+             * 
+             * @return const T& The value.
+             */
+            inline const T& get() const {
+            #ifndef NDEBUG
+                assert(!reading_.exchange(true, std::memory_order_acquire) && "A config value handle was read by two threads at once.");
+            #endif
+                if (generation_ != parser_->generation()) refresh();
+            #ifndef NDEBUG
+                reading_.store(false, std::memory_order_release);
+            #endif
+                return value_;
+            }
+
+            /** @copydoc get() const */
+            inline operator const T&() const { return get(); }
+
+        private:
+
+            /** Looks up the value in the current table of the parser. */
+            void refresh() const {
+                // Read the generation first, so a table published during the lookup is read again
+                parser_->table();
+                unsigned int generation = parser_->generation();
+                if (!parser_->find(id_, value_)) {
+                #ifndef NDEBUG
+                    reading_.store(false, std::memory_order_release);
+                #endif
+                    throw std::out_of_range("Config value '" + IniParser::nameOf(static_cast<uint32_t>(id_ >> 32)) +
+                        "." + IniParser::nameOf(static_cast<uint32_t>(id_)) + "' not found.");
+                }
+                generation_ = generation;
+            }
+
+            /** The parser holding the value. */
+            const IniParser* parser_;
+            /** The combined (section, key) id of the value. */
+            uint64_t id_;
+            /** The generation of the table the value was read from. */
+            mutable unsigned int generation_ = 0;
+            /** The cached value. */
+            mutable T value_ = T();
+            /** Is a thread reading this handle? Only set in debug builds. */
+            mutable std::atomic<bool> reading_;
 
         };
 
-        /** The values stored in defaults.ini. */
+        /** The values stored in defaults.ini. Parsed on first access. */
         extern IniParser DEFAULTS;
 
 
@@ -172,6 +813,14 @@ namespace seedengine {
              * @param byte_order The byte order used in the file to parse.
              */
             BinaryParser(string filepath);
+            /**
+             * @brief Constructs a new Binary Parser over bytes already read from a file.
+             *
+             * @param filepath The path the bytes were read from.
+             * @param data The bytes to parse, which must outlive the parser.
+             * @param size The number of bytes.
+             */
+            BinaryParser(string filepath, const char* data, size_t size);
 
             virtual ~BinaryParser() = default;
 
@@ -237,10 +886,21 @@ namespace seedengine {
 
         private:
 
+            /**
+             * @brief Copies bytes from the file or memory being parsed.
+             *
+             * @param start The point in the file to copy from.
+             * @param out The buffer to copy to.
+             * @param size The number of bytes to copy.
+             */
+            void read(const std::streampos& start, char* out, std::streamoff size);
+
             /** The position in the parsed file. */
             std::streampos pos_;
             /** The length of the binary file. */
             std::streampos length_;
+            /** The bytes being parsed, or nullptr when parsing the file itself. */
+            const char* memory_ = nullptr;
 
         };
     }
@@ -0,0 +1,187 @@
+#ifndef SEEDENGINE_INCLUDE_PROFILE_H_
+#define SEEDENGINE_INCLUDE_PROFILE_H_
+
+#include "Core.hpp"
+#include "Time.hpp"
+
+#include <atomic>
+
+#if ENGINE_PROFILE
+    #define ENGINE_PROFILE_CONCAT_IMPL(a, b) a##b
+    #define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_IMPL(a, b)
+    /**
+     * @brief Times the rest of the enclosing scope while the profiler is capturing.
+     *        The name must outlive the capture, such as a string literal.
+     */
+    #define ENGINE_PROFILE_SCOPE(name) seedengine::ProfileScope ENGINE_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+    /** Times the rest of the enclosing function while the profiler is capturing. */
+    #define ENGINE_PROFILE_FUNCTION() ENGINE_PROFILE_SCOPE(__func__)
+#else
+    #define ENGINE_PROFILE_SCOPE(name)
+    #define ENGINE_PROFILE_FUNCTION()
+#endif
+
+namespace seedengine {
+
+    /** A timed scope, as recorded by the #Profiler. */
+    struct ProfileEvent {
+        /** The name of the scope. */
+        const char* name;
+        /** The time the scope was entered, on the Time::nowNS() clock. */
+        int64_t start_ns;
+        /** The time the scope was left. */
+        int64_t end_ns;
+        /** The number of timed scopes it was nested in. */
+        uint32_t depth;
+    };
+
+    class ProfileBuffer; // Forward declare ProfileBuffer class
+
+    /**
+     * @brief Captures timed scopes from every thread, for viewing as a trace.
+     * @details Scopes are marked with ENGINE_PROFILE_SCOPE(), which only records anything when
+     *          the engine is built with ENGINE_PROFILE enabled, and is empty otherwise. Each
+     *          thread appends to a buffer of its own, so recording a scope takes no lock and
+     *          never allocates; a thread only takes a lock the first time it records in a
+     *          capture. A buffer that fills up counts the scopes it drops instead of growing.
+     *          Captures are written in the Chrome trace event format, which chrome://tracing
+     *          and Perfetto both open, with nested scopes stacked on each thread.
+     *          Captures are started, stopped and read from a single controlling thread.
+     */
+    class Profiler final {
+
+        friend class ProfileScope;
+
+    public:
+
+        /** The default number of scopes each thread keeps per capture. */
+        static const size_t DEFAULT_CAPACITY = 1 << 16;
+
+        /**
+         * @brief Starts a capture, discarding the last one.
+         *
+         * @param capacity The number of scopes each thread keeps. Only applies to threads
+         *                 that have not recorded in an earlier capture.
+         */
+        static void start(size_t capacity = DEFAULT_CAPACITY);
+        /** Stops the capture. Scopes still open are dropped. */
+        static void stop();
+        /**
+         * @brief Is a capture running?
+         *
+         * @return true If scopes are being recorded.
+         */
+        static inline bool isCapturing() { return capturing_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Names the calling thread in captures.
+         *
+         * @param name The name of the thread.
+         */
+        static void setThreadName(const string& name);
+
+        /**
+         * @brief Records a scope on the calling thread, if a capture is running.
+         *
+         * @param name The name of the scope, which must outlive the capture.
+         * @param start_ns The time the scope was entered.
+         * @param end_ns The time the scope was left.
+         * @param depth The number of scopes it was nested in.
+         */
+        static void record(const char* name, int64_t start_ns, int64_t end_ns, uint32_t depth = 0);
+
+        /**
+         * @brief Returns every scope of the last capture, ordered by thread and end time.
+         *
+         * @return std::vector<ProfileEvent> The recorded scopes.
+         */
+        static std::vector<ProfileEvent> events();
+        /**
+         * @brief Returns the number of scopes recorded in the last capture.
+         *
+         * @return uint64_t The number of scopes.
+         */
+        static uint64_t recorded();
+        /**
+         * @brief Returns the number of scopes dropped in the last capture because a thread's
+         *        buffer was full.
+         *
+         * @return uint64_t The number of dropped scopes.
+         */
+        static uint64_t dropped();
+
+        /**
+         * @brief Writes the last capture as a Chrome trace.
+         *
+         * @param out The stream to write the JSON to.
+         */
+        static void writeTrace(std::ostream& out);
+        /**
+         * @brief Writes the last capture to a Chrome trace file.
+         *
+         * @param path The path of the JSON file. An existing file is replaced.
+         * @return true If the file was written.
+         */
+        static bool writeTrace(const string& path);
+        /**
+         * @brief Writes the total, count and mean time of each scope name, indented by how
+         *        deeply it is nested and ordered by total time.
+         *
+         * @param out The stream to write to.
+         */
+        static void report(std::ostream& out);
+
+    private:
+
+        /**
+         * @brief Returns the buffer of the calling thread, creating it on first use.
+         *
+         * @return ProfileBuffer& The buffer of the thread.
+         */
+        static ProfileBuffer& buffer();
+
+        /** Is a capture running? */
+        static std::atomic<bool> capturing_;
+        /** The number of the current capture, so buffers know when to start over. */
+        static std::atomic<uint32_t> capture_;
+        /** The depth of the open scopes of each thread. */
+        static thread_local uint32_t depth_;
+
+    };
+
+    /** Records the time between its construction and destruction as a #ProfileEvent. */
+    class ProfileScope final {
+
+    public:
+
+        /**
+         * @brief Enters a scope.
+         *
+         * @param name The name of the scope, which must outlive the capture.
+         */
+        explicit ProfileScope(const char* name)
+            : name_(name), start_ns_(Profiler::isCapturing() ? Time::nowNS() : -1) {
+            if (start_ns_ >= 0) Profiler::depth_++;
+        }
+        /** Leaves the scope, recording it. */
+        ~ProfileScope() {
+            if (start_ns_ < 0) return;
+            Profiler::depth_--;
+            Profiler::record(name_, start_ns_, Time::nowNS(), Profiler::depth_);
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+
+        /** The name of the scope. */
+        const char* name_;
+        /** The time the scope was entered, or -1 if no capture was running. */
+        int64_t start_ns_;
+
+    };
+
+}
+
+#endif
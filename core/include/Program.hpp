@@ -3,10 +3,22 @@
 
 #include "Core.hpp"
 #include "Time.hpp"
+#include "Jobs.hpp"
+#include "Memory.hpp"
+#include "Stats.hpp"
+#include "Profile.hpp"
+#include "Pacer.hpp"
 #include "Parser.hpp"
 #include "Event.hpp"
+#include "Headless.hpp"
+#include "Record.hpp"
 #include "Window.hpp"
 #include "Renderer.hpp"
+#include "Snapshot.hpp"
+#include "Streamer.hpp"
+#include "Tick.hpp"
+
+#include <condition_variable>
 
 namespace seedengine {
 
@@ -21,12 +33,14 @@ namespace seedengine {
             /** Program destructor. */
             virtual ~Program();
 
-            /** Target Frames per Second. */
-            const float TARGET_FPS = util::DEFAULTS.getFloat("Engine", "target_fps");
-            /** Target Updates per Second. */
-            const float TARGET_UPS = util::DEFAULTS.getFloat("Engine", "target_ups");
-            /** Max Updates per Frame. */
-            const int MAX_UPF = util::DEFAULTS.getInt("Engine", "max_updates_per_frame");
+            /** Target Frames per Second. Reloaded when defaults.ini changes. */
+            const util::ConfigValue<float> TARGET_FPS = util::DEFAULTS.value<float>("Engine", "target_fps");
+            /** Target Updates per Second. Reloaded when defaults.ini changes. */
+            const util::ConfigValue<float> TARGET_UPS = util::DEFAULTS.value<float>("Engine", "target_ups");
+            /** Max Updates per Frame. Reloaded when defaults.ini changes. */
+            const util::ConfigValue<int> MAX_UPF = util::DEFAULTS.value<int>("Engine", "max_updates_per_frame");
+            /** Real time in ms the updates of a frame may take. Reloaded when defaults.ini changes. */
+            const util::ConfigValue<float> UPDATE_BUDGET = util::DEFAULTS.value<float>("Engine", "update_budget_ms");
 
             /**
              * @brief Runs the program logic. Should be launched on a new thread.
@@ -86,6 +100,85 @@ namespace seedengine {
                 return game_state_;
             }
 
+            /**
+             * @brief Returns the asset streamer of this program. Streamed assets are scheduled
+             *        once per frame by the simulation, and uploaded by the thread that renders
+             *        between its frames.
+             * 
+             * @return AssetStreamer& The asset streamer of this program.
+             */
+            inline AssetStreamer& getStreamer() {
+                return streamer_;
+            }
+
+            /**
+             * @brief Returns the frame pacer of this program, which holds the pacing statistics
+             *        of frames limited by vsync.
+             * 
+             * @return const FramePacer& The frame pacer of this program.
+             */
+            inline const FramePacer& getPacer() const {
+                return pacer_;
+            }
+
+            /**
+             * @brief Returns the tick scheduler of this program. Actors added to it have their
+             *        components updated on every tick, after the tick event.
+             * 
+             * @return TickScheduler& The tick scheduler of this program.
+             */
+            inline TickScheduler& getTickScheduler() {
+                return tick_scheduler_;
+            }
+
+            /**
+             * @brief Returns the frame stats of this program: the rolling frame, tick, render and
+             *        swap times, and the number of hitches. May be read from any thread.
+             * 
+             * @return const FrameStats& The frame stats of this program.
+             */
+            inline const FrameStats& getStats() const {
+                return stats_;
+            }
+
+            /**
+             * @brief Returns the frame rate over the rolling window of the frame stats.
+             * 
+             * @return float The current frames per second.
+             */
+            inline float getFPS() const {
+                return static_cast<float>(stats_.fps());
+            }
+
+            /**
+             * @brief Returns the fixed timestep of this program, which holds the interpolation
+             *        alpha of the last frame and the number of dropped updates.
+             * 
+             * @return const FixedTimestep& The fixed timestep of this program.
+             */
+            inline const FixedTimestep& getTimestep() const {
+                return timestep_;
+            }
+
+            /**
+             * @brief Returns the frame exchange of this program, which holds the latency and
+             *        throughput of the frames rendered in either loop mode.
+             * 
+             * @return const FrameExchange& The frame exchange of this program.
+             */
+            inline const FrameExchange& getFrameExchange() const {
+                return exchange_;
+            }
+
+            /**
+             * @brief Is the program running without a window or graphics?
+             * 
+             * @return true If headless is set in defaults.ini for the current run.
+             */
+            inline bool isHeadless() const {
+                return headless_;
+            }
+
             /**
              * @brief Should the program abort?
              * 
@@ -111,6 +204,8 @@ namespace seedengine {
 
             /** A mutex to lock program functions for thread safety */
             mutable std::mutex mu;
+            /** Signalled when a game is loaded or the program is asked to stop. */
+            std::condition_variable game_loaded_;
 
             /**
              * @brief The game loaded into this program. Will be nullptr if none has been loaded.
@@ -125,25 +220,53 @@ namespace seedengine {
              */
             int* game_state_ = nullptr; //TODO: replace int* with actual game state class
 
-            /** Internal flag that instructs the program to abort. */
-            bool abort_flag_ = false;
+            /** Internal flag that instructs the program to abort. Read by the simulation and render threads. */
+            std::atomic<bool> abort_flag_ { false };
             /** Stores the required error code upon abort. */
             int abort_code_ = 0;
 
-            /** Internal flag that instructs the program to exit. */
-            bool exit_flag_ = false;
+            /** Internal flag that instructs the program to exit. Read by the simulation and render threads. */
+            std::atomic<bool> exit_flag_ { false };
             /** Stores the required exit code upon exit. */
             int exit_code_ = 0;
 
+            /** Is the program running without a window? */
+            bool headless_ = false;
+
             /** The current frames per second of this instance. */
             float current_fps_ = TARGET_FPS;
             /** The current updates per second of this instance. */
             float current_ups_ = TARGET_UPS;
 
+            /** The rolling frame time statistics. */
+            FrameStats stats_;
+
+            /** Waits out the rest of each frame when vsync is enabled. */
+            FramePacer pacer_;
+
+            /** Updates the components of the actors in the game. */
+            TickScheduler tick_scheduler_;
+
+            /** Splits the time of each frame into fixed updates. */
+            FixedTimestep timestep_;
+
+            /** Hands the render snapshot of each frame from the simulation to the renderer. */
+            FrameExchange exchange_;
+
             /** The dedicated renderer of this program. */
             Renderer renderer_;
             //TODO: Move renderer into window or viewport class
 
+            /** The source streamed assets are read from. */
+            FileStreamSource stream_source_;
+            /** The scheduler for streamed assets. */
+            AssetStreamer streamer_ { &stream_source_,
+                static_cast<uint64_t>(util::DEFAULTS.getInt("Streaming", "max_io_bytes")),
+                static_cast<uint64_t>(util::DEFAULTS.getInt("Streaming", "max_upload_bytes_per_frame")) };
+
+            /** Binds onClose() to the window close event while this program exists. */
+            EventSubscription close_subscription_;
+
             /**
              * @brief The event binding to be called when the window is closed.
              * 
@@ -0,0 +1,295 @@
+#ifndef SEEDENGINE_INCLUDE_RECORD_H_
+#define SEEDENGINE_INCLUDE_RECORD_H_
+
+#include "Core.hpp"
+#include "Event.hpp"
+#include "Serial.hpp"
+#include "Stats.hpp"
+
+namespace seedengine {
+
+    /**
+     * @brief The functions that save and restore the fields of an event class.
+     * @details Codecs for the input and window events of the engine are built in. Client events
+     *          are recorded once a codec is registered with EventRecorder::registerCodec().
+     */
+    struct EventCodec {
+        /** Writes the fields of an event. */
+        typedef void (*WriteFunction)(const Event& e, util::BinaryWriter& out);
+        /** Reads the fields written by a WriteFunction and pushes an equal event. */
+        typedef bool (*ReplayFunction)(util::BinaryReader& in, Window* window);
+
+        /** Writes the fields of an event. */
+        WriteFunction write = nullptr;
+        /** Reads the fields of an event and pushes it. */
+        ReplayFunction replay = nullptr;
+    };
+
+    /**
+     * @brief Records every queued event run by the #EventDispatcher into a compact binary log.
+     * @details Each event is stored with the frame it ran in, the time since recording started
+     *          and the fields written by its #EventCodec. Frames and times are stored as deltas
+     *          from the previous event, so a typical input event takes under a dozen bytes.
+     *          Forced events are not recorded, as the engine forces them itself every frame.
+     *          Only one recorder may be recording at a time.
+     */
+    class EventRecorder final {
+
+    public:
+
+        /** The bytes that start every event log. */
+        static const uint32_t MAGIC = 0x54564553;
+        /** The version of the log format. */
+        static const uint32_t VERSION = 1;
+        /** The number of buffered bytes that triggers a write to the file. */
+        static const size_t FLUSH_SIZE = 64 * 1024;
+
+        /**
+         * @brief Registers the codec used to record and replay an event.
+         *
+         * @param event_id The ID of the event.
+         * @param codec The functions that save and restore the event.
+         */
+        static void registerCodec(unsigned int event_id, EventCodec codec);
+        /**
+         * @brief Registers the codec used to record and replay an event class.
+         *
+         * @tparam E The event type.
+         * @param write Writes the fields of an event.
+         * @param replay Reads the fields of an event and pushes it.
+         */
+        template <class E>
+        static void registerCodec(EventCodec::WriteFunction write, EventCodec::ReplayFunction replay) {
+            EventCodec codec;
+            codec.write = write;
+            codec.replay = replay;
+            registerCodec(E::EVENT_ID, codec);
+        }
+        /**
+         * @brief Returns the codec of an event.
+         *
+         * @param event_id The ID of the event.
+         * @return const EventCodec* The codec, or nullptr if the event cannot be recorded.
+         */
+        static const EventCodec* codecFor(unsigned int event_id);
+
+        /** Constructs a new, idle Event Recorder. */
+        EventRecorder() = default;
+        /** Stops recording. */
+        ~EventRecorder();
+
+        EventRecorder(const EventRecorder&) = delete;
+        EventRecorder& operator=(const EventRecorder&) = delete;
+
+        /**
+         * @brief Starts recording the events run by the dispatcher.
+         *
+         * @param path The path of the log file. An existing file is replaced.
+         * @return true If the file was opened.
+         */
+        bool start(const string& path);
+        /** Stops recording, writing the number of recorded frames and closing the file. */
+        void stop();
+
+        /** Marks the end of a frame. Call once per frame, after the events have been run. */
+        void nextFrame();
+
+        /**
+         * @brief Is this recorder recording?
+         *
+         * @return true If events are being recorded.
+         */
+        inline bool isRecording() const { return file_.is_open(); }
+        /**
+         * @brief Returns the index of the frame being recorded.
+         *
+         * @return uint64_t The frame index.
+         */
+        inline uint64_t frame() const { return frame_; }
+        /**
+         * @brief Returns the number of recorded events.
+         *
+         * @return size_t The number of recorded events.
+         */
+        inline size_t recorded() const { return recorded_; }
+        /**
+         * @brief Returns the number of events skipped because they have no codec.
+         *
+         * @return size_t The number of skipped events.
+         */
+        inline size_t skipped() const { return skipped_; }
+
+    private:
+
+        /**
+         * @brief Writes an event to the log.
+         *
+         * @param e The event being run.
+         */
+        void record(const Event& e);
+
+        /** Writes the buffered bytes to the file. */
+        void flush();
+
+        /** The log file. */
+        std::ofstream file_;
+        /** The bytes waiting to be written to the file. */
+        util::BinaryWriter buffer_;
+        /** The fields of the event being recorded. */
+        util::BinaryWriter payload_;
+        /** The time recording started. */
+        std::chrono::steady_clock::time_point start_;
+        /** The index of the frame being recorded. */
+        uint64_t frame_ = 0;
+        /** The frame of the last written record. */
+        uint64_t last_frame_ = 0;
+        /** The time of the last written record, in microseconds. */
+        uint64_t last_time_ = 0;
+        /** The number of recorded events. */
+        size_t recorded_ = 0;
+        /** The number of events without a codec. */
+        size_t skipped_ = 0;
+
+    };
+
+    /** The frame times measured while replaying an event log. */
+    struct ReplayStats {
+        /** The number of replayed frames. */
+        uint64_t frames = 0;
+        /** The number of replayed events. */
+        uint64_t events = 0;
+        /** The total time of every frame, in milliseconds. */
+        double total_ms = 0.0;
+        /** The mean frame time, in milliseconds. */
+        double mean_ms = 0.0;
+        /** The median frame time, in milliseconds. */
+        double p50_ms = 0.0;
+        /** The 99th percentile frame time, in milliseconds. */
+        double p99_ms = 0.0;
+        /** The longest frame time, in milliseconds. */
+        double max_ms = 0.0;
+
+        /**
+         * @brief Returns the statistics as a single line of text.
+         *
+         * @return string The formatted statistics.
+         */
+        string summary() const;
+    };
+
+    /**
+     * @brief Feeds the events of a recorded log back into the #EventDispatcher at the frame
+     *        boundaries they were recorded at, timing each replayed frame.
+     * @details Events are pushed on the calling thread, which should be the dispatch thread. As
+     *          the same events are pushed in the same order every time, the frame times of two
+     *          builds replaying one log can be compared directly.
+     */
+    class EventReplay final {
+
+    public:
+
+        /** The function that runs a single frame of the program. */
+        typedef std::function<void(uint64_t frame)> FrameFunction;
+
+        /** Constructs a new, empty Event Replay. */
+        EventReplay() = default;
+
+        /**
+         * @brief Loads an event log written by an #EventRecorder.
+         *
+         * @param path The path of the log file.
+         * @return true If the log was loaded.
+         */
+        bool load(const string& path);
+
+        /**
+         * @brief Sets the window passed to replayed window events.
+         *
+         * @param window The window, or nullptr.
+         */
+        inline void setWindow(Window* window) { window_ = window; }
+
+        /**
+         * @brief Pushes the events recorded for the next frame and starts timing it.
+         *
+         * @return true If a frame was started, false once every frame has been replayed.
+         */
+        bool beginFrame();
+        /** Stops timing the current frame. */
+        void endFrame();
+
+        /**
+         * @brief Replays every remaining frame.
+         *
+         * @param frame Runs a frame, usually by running the dispatcher and ticking the program.
+         * @return ReplayStats The frame times of the replay.
+         */
+        ReplayStats run(const FrameFunction& frame);
+
+        /** Starts the replay over from the first frame, clearing the frame times. */
+        void rewind();
+
+        /**
+         * @brief Returns the frame times measured so far.
+         *
+         * @return ReplayStats The frame times.
+         */
+        ReplayStats stats() const;
+
+        /**
+         * @brief Returns the number of recorded frames.
+         *
+         * @return uint64_t The number of frames.
+         */
+        inline uint64_t frames() const { return frames_; }
+        /**
+         * @brief Returns the number of recorded events.
+         *
+         * @return size_t The number of events.
+         */
+        inline size_t events() const { return records_.size(); }
+        /**
+         * @brief Returns the index of the next frame to replay.
+         *
+         * @return uint64_t The frame index.
+         */
+        inline uint64_t frame() const { return frame_; }
+
+    private:
+
+        /** A recorded event. */
+        struct Record {
+            /** The frame the event ran in. */
+            uint64_t frame;
+            /** The ID of the event. */
+            unsigned int event_id;
+            /** The offset of the event fields in the log. */
+            size_t offset;
+            /** The size of the event fields. */
+            size_t size;
+        };
+
+        /** The bytes of the log. */
+        std::vector<uint8_t> data_;
+        /** The recorded events, in order. */
+        std::vector<Record> records_;
+        /** The number of recorded frames. */
+        uint64_t frames_ = 0;
+        /** The index of the next frame to replay. */
+        uint64_t frame_ = 0;
+        /** The index of the next event to replay. */
+        size_t cursor_ = 0;
+        /** The number of replayed events. */
+        uint64_t replayed_ = 0;
+        /** The window passed to window events. */
+        Window* window_ = nullptr;
+        /** The time the current frame started. */
+        std::chrono::steady_clock::time_point frame_start_;
+        /** The time taken by each frame, in nanoseconds. */
+        util::Histogram frame_times_;
+
+    };
+
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include "Transform.hpp"
 #include "Shader.hpp"
 #include "Camera.hpp"
+#include "Snapshot.hpp"
 
 namespace seedengine {
 
@@ -92,7 +93,9 @@ namespace seedengine {
 
     /**
      * @brief A renderer that should be bound to a specific window.
-     * @details
+     * @details The program calls prepare() and render() on the thread that owns the graphics
+     *          context, handing over the snapshot of each frame directly, so rendering never
+     *          goes through the event dispatcher.
      */
     class Renderer final {
         
@@ -105,12 +108,32 @@ namespace seedengine {
          */
         Renderer(RenderOptions options = RenderOptions());
 
+        Renderer(const Renderer&) = delete;
+        Renderer& operator=(const Renderer&) = delete;
+
+        /** Prepares for the next rendering pass. */
+        void prepare();
+
         /**
          * @brief Renders out the current render queue
          * 
-         * @param e A reference to the event used to trigger this render pass.
+         * @param snapshot The frame state to render, or nullptr to draw no meshes.
          */
-        void render(EngineRenderEvent& e);
+        void render(const RenderSnapshot* snapshot);
+
+        /**
+         * @brief Enables or disables this renderer. A disabled renderer makes no graphics calls,
+         *        so it may exist without a graphics context.
+         * 
+         * @param enabled Should this renderer draw?
+         */
+        inline void setEnabled(bool enabled) { enabled_ = enabled; }
+        /**
+         * @brief Is this renderer enabled?
+         * 
+         * @return true If this renderer draws.
+         */
+        inline bool isEnabled() const { return enabled_; }
 
     private:
         //TODO: Create render queue.
@@ -128,13 +151,11 @@ namespace seedengine {
         bool backface_culling_ = false;
         /** Is depth testing enabled? */
         bool depth_test_ = true;
+        /** Does this renderer draw? */
+        bool enabled_ = true;
 
-        /**
-         * @brief Prepares for the next rendering pass.
-         * 
-         * @param e A reference to the event used to trigger this render preperation.
-         */
-        void prepare(EnginePreRenderEvent& e);
+        /** The frame state being rendered, set for the length of render(). */
+        const RenderSnapshot* snapshot_ = nullptr;
 
         /**
          * @brief Sets the clear color for the renderer. This should be black
@@ -170,6 +191,13 @@ namespace seedengine {
         /** Disables depth testing. */
         void disableDepthTest();
 
+        /**
+         * @brief Draws a mesh with the bound shader.
+         * 
+         * @param mesh The mesh to draw.
+         */
+        void drawMesh(const Mesh& mesh);
+
         /** Renders an unlit framebuffer. */
         void unlitRender();
         /**
@@ -0,0 +1,406 @@
+#ifndef SEEDENGINE_INCLUDE_SERIAL_H_
+#define SEEDENGINE_INCLUDE_SERIAL_H_
+
+#include "Core.hpp"
+
+namespace seedengine {
+
+    // Custom Serialization Macros
+
+    /**
+     * @brief The standard body to include in all #Serial specializations.
+     *
+     * @param version The current version of the field layout. Increase it whenever a field is added.
+     */
+    #define ENGINE_SERIAL_BODY(version) \
+        static const bool DESCRIBED = true;\
+        static const uint32_t VERSION = version;
+
+    /**
+     * @brief The field description of type T.
+     * @details Types without a description that are trivially copyable are serialized with a
+     *          single memcpy, and arrays of them with a single memcpy for the whole array. Types
+     *          that need a stable layout across versions, or that hold derived state, specialize
+     *          this template with #ENGINE_SERIAL_BODY and a fields() function that visits every
+     *          field with the version it was added in:
+     *
+     *          template <> struct Serial<Color> {
+     *              ENGINE_SERIAL_BODY(2)
+     *              template <class V> static void fields(V& v, Color& c) {
+     *                  v.field(1, c.r); v.field(1, c.g); v.field(1, c.b);
+     *                  v.field(2, c.a);
+     *              }
+     *          };
+     *
+     *          Visitors expose a static IS_READER flag so fields() can apply values read through
+     *          temporaries with setters. Described values are written with their version and size,
+     *          so streams written by older versions leave new fields at their defaults, and streams
+     *          written by newer versions skip the fields they do not know.
+     *
+     * @tparam T The type being described.
+     */
+    template <class T>
+    struct Serial {
+        static const bool DESCRIBED = false;
+    };
+
+    namespace util {
+
+        class BinaryWriter;
+        class BinaryReader;
+
+        /**
+         * @brief Can type T be copied into a stream with memcpy?
+         *
+         * @tparam T The type to check.
+         */
+        template <class T>
+        struct is_bulk_serializable : std::integral_constant<bool,
+            !Serial<T>::DESCRIBED && std::is_trivially_copyable<T>::value> {};
+
+        /**
+         * @brief A stream that writes values into a growing byte buffer.
+         * @details Bulk values are written in host byte order. Bits written with writeBits() are
+         *          packed into bytes, and any byte aligned write pads the pending bits to a byte.
+         */
+        class BinaryWriter final {
+
+        public:
+
+            /** The visitor passed to Serial<T>::fields() when writing. */
+            struct Visitor {
+                static const bool IS_READER = false;
+                BinaryWriter& writer;
+                template <class F>
+                inline void field(uint32_t since, const F& value) { writer.write(value); }
+                inline void bits(uint32_t since, uint32_t value, unsigned int count) { writer.writeBits(value, count); }
+            };
+
+            /** Constructs a new Binary Writer. */
+            BinaryWriter() = default;
+
+            /**
+             * @brief Writes raw bytes.
+             *
+             * @param data The bytes to write.
+             * @param size The number of bytes.
+             */
+            void writeBytes(const void* data, size_t size);
+
+            /**
+             * @brief Writes an unsigned integer using 7 bits per byte.
+             *
+             * @param value The value to write.
+             */
+            void writeVarint(uint64_t value);
+            /**
+             * @brief Writes a signed integer with zigzag encoding, so small negative values stay small.
+             *
+             * @param value The value to write.
+             */
+            void writeSignedVarint(int64_t value);
+
+            /**
+             * @brief Writes the low bits of a value.
+             *
+             * @param value The value to write.
+             * @param count The number of bits to write, at most 32.
+             */
+            void writeBits(uint32_t value, unsigned int count);
+            /** Pads any pending bits to a full byte. */
+            void alignBits();
+
+            /**
+             * @brief Writes a string as its length followed by its characters.
+             *
+             * @param value The string to write.
+             */
+            void write(const string& value);
+
+            /**
+             * @brief Writes a value with memcpy.
+             *
+             * @param value The value to write.
+             */
+            template <class T>
+            typename std::enable_if<is_bulk_serializable<T>::value>::type write(const T& value) {
+                writeBytes(&value, sizeof(T));
+            }
+
+            /**
+             * @brief Writes a described value with its version and size.
+             *
+             * @param value The value to write.
+             */
+            template <class T>
+            typename std::enable_if<Serial<T>::DESCRIBED>::type write(const T& value) {
+                alignBits();
+                writeVarint(Serial<T>::VERSION);
+                // Reserve the size, patched once the fields are written
+                size_t size_at = buffer_.size();
+                uint32_t size = 0;
+                writeBytes(&size, sizeof(size));
+                Visitor visitor = { *this };
+                Serial<T>::fields(visitor, const_cast<T&>(value));
+                alignBits();
+                size = static_cast<uint32_t>(buffer_.size() - size_at - sizeof(size));
+                std::memcpy(&buffer_[size_at], &size, sizeof(size));
+            }
+
+            /**
+             * @brief Writes a list of values. Lists of bulk values are written with a single memcpy.
+             *
+             * @param values The values to write.
+             */
+            template <class T>
+            void write(const std::vector<T>& values) {
+                writeVarint(values.size());
+                writeArray(values.data(), values.size());
+            }
+
+            /**
+             * @brief Returns the written bytes, padding any pending bits.
+             *
+             * @return const std::vector<uint8_t>& The written bytes.
+             */
+            const std::vector<uint8_t>& data() {
+                alignBits();
+                return buffer_;
+            }
+
+            /**
+             * @brief Returns the number of bytes written.
+             *
+             * @return size_t The number of bytes written, excluding pending bits.
+             */
+            inline size_t size() const { return buffer_.size(); }
+
+            /**
+             * @brief Removes all written bytes, keeping the allocated capacity.
+             */
+            inline void clear() {
+                buffer_.clear();
+                bit_buffer_ = 0;
+                bit_count_ = 0;
+            }
+
+        private:
+
+            template <class T>
+            typename std::enable_if<is_bulk_serializable<T>::value>::type writeArray(const T* values, size_t count) {
+                writeBytes(values, sizeof(T) * count);
+            }
+
+            template <class T>
+            typename std::enable_if<!is_bulk_serializable<T>::value>::type writeArray(const T* values, size_t count) {
+                for (size_t i = 0; i < count; i++) write(values[i]);
+            }
+
+            /** The written bytes. */
+            std::vector<uint8_t> buffer_;
+            /** Bits waiting to be written. */
+            uint64_t bit_buffer_ = 0;
+            /** The number of bits waiting to be written. */
+            unsigned int bit_count_ = 0;
+
+        };
+
+        /**
+         * @brief A stream that reads values written by a #BinaryWriter.
+         * @details Reads past the end of the data fail and leave the reader in a failed state.
+         *          Every read returns false once the reader has failed.
+         */
+        class BinaryReader final {
+
+        public:
+
+            /** The visitor passed to Serial<T>::fields() when reading. */
+            struct Visitor {
+                static const bool IS_READER = true;
+                BinaryReader& reader;
+                uint32_t version;
+                template <class F>
+                inline void field(uint32_t since, F& value) { if (since <= version) reader.read(value); }
+                inline void bits(uint32_t since, uint32_t& value, unsigned int count) {
+                    if (since <= version) reader.readBits(value, count);
+                }
+                inline void bits(uint32_t since, bool& value, unsigned int count) {
+                    uint32_t bit = value ? 1 : 0;
+                    bits(since, bit, count);
+                    value = bit != 0;
+                }
+            };
+
+            /**
+             * @brief Constructs a new Binary Reader.
+             *
+             * @param data The bytes to read. They must outlive the reader.
+             * @param size The number of bytes.
+             */
+            BinaryReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+            /**
+             * @brief Constructs a new Binary Reader.
+             *
+             * @param data The bytes to read. They must outlive the reader.
+             */
+            explicit BinaryReader(const std::vector<uint8_t>& data) : data_(data.data()), size_(data.size()) {}
+
+            /**
+             * @brief Reads raw bytes.
+             *
+             * @param out The location to copy the bytes to.
+             * @param size The number of bytes.
+             * @return true If the bytes were read.
+             */
+            bool readBytes(void* out, size_t size);
+            /**
+             * @brief Skips raw bytes without reading them.
+             *
+             * @param size The number of bytes.
+             * @return true If the bytes were skipped.
+             */
+            bool skipBytes(size_t size);
+
+            /**
+             * @brief Reads an unsigned integer written by writeVarint().
+             *
+             * @param out The value read.
+             * @return true If the value was read.
+             */
+            bool readVarint(uint64_t& out);
+            /**
+             * @brief Reads a signed integer written by writeSignedVarint().
+             *
+             * @param out The value read.
+             * @return true If the value was read.
+             */
+            bool readSignedVarint(int64_t& out);
+
+            /**
+             * @brief Reads bits written by writeBits().
+             *
+             * @param out The value read.
+             * @param count The number of bits to read, at most 32.
+             * @return true If the bits were read.
+             */
+            bool readBits(uint32_t& out, unsigned int count);
+            /** Skips any bits remaining in a partially read byte. */
+            void alignBits();
+
+            /**
+             * @brief Reads a string.
+             *
+             * @param out The string read.
+             * @return true If the string was read.
+             */
+            bool read(string& out);
+
+            /**
+             * @brief Reads a value with memcpy.
+             *
+             * @param out The value read.
+             * @return true If the value was read.
+             */
+            template <class T>
+            typename std::enable_if<is_bulk_serializable<T>::value, bool>::type read(T& out) {
+                return readBytes(&out, sizeof(T));
+            }
+
+            /**
+             * @brief Reads a described value, skipping fields added by newer versions.
+             *
+             * @param out The value read. Fields missing from older versions keep their value.
+             * @return true If the value was read.
+             */
+            template <class T>
+            typename std::enable_if<Serial<T>::DESCRIBED, bool>::type read(T& out) {
+                alignBits();
+                uint64_t version;
+                uint32_t size;
+                if (!readVarint(version) || !readBytes(&size, sizeof(size))) return false;
+                size_t end = pos_ + size;
+                if (end > size_) return fail();
+                Visitor visitor = { *this, static_cast<uint32_t>(version) };
+                Serial<T>::fields(visitor, out);
+                alignBits();
+                if (failed_ || pos_ > end) return fail();
+                pos_ = end;
+                return true;
+            }
+
+            /**
+             * @brief Reads a list of values. Lists of bulk values are read with a single memcpy.
+             * @details Counts larger than the remaining bytes could hold fail before any memory
+             *          is allocated. Every value takes at least one byte.
+             *
+             * @param out The values read.
+             * @return true If the values were read.
+             */
+            template <class T>
+            bool read(std::vector<T>& out) {
+                uint64_t count;
+                if (!readVarint(count)) return false;
+                size_t remaining = size_ - pos_;
+                if (count > (is_bulk_serializable<T>::value ? remaining / sizeof(T) : remaining)) return fail();
+                out.resize(static_cast<size_t>(count));
+                return readArray(out.data(), out.size());
+            }
+
+            /**
+             * @brief Has every read succeeded so far?
+             *
+             * @return true If no read has failed.
+             */
+            inline bool good() const { return !failed_; }
+            /**
+             * @brief Returns the number of bytes read.
+             *
+             * @return size_t The read position.
+             */
+            inline size_t position() const { return pos_; }
+
+        private:
+
+            /**
+             * @brief Marks this reader as failed.
+             *
+             * @return false Always.
+             */
+            inline bool fail() {
+                failed_ = true;
+                return false;
+            }
+
+            template <class T>
+            typename std::enable_if<is_bulk_serializable<T>::value, bool>::type readArray(T* values, size_t count) {
+                return readBytes(values, sizeof(T) * count);
+            }
+
+            template <class T>
+            typename std::enable_if<!is_bulk_serializable<T>::value, bool>::type readArray(T* values, size_t count) {
+                for (size_t i = 0; i < count; i++) {
+                    if (!read(values[i])) return false;
+                }
+                return true;
+            }
+
+            /** The bytes being read. */
+            const uint8_t* data_;
+            /** The number of bytes. */
+            size_t size_;
+            /** The read position. */
+            size_t pos_ = 0;
+            /** Bits read from the data but not yet returned. */
+            uint64_t bit_buffer_ = 0;
+            /** The number of bits in the bit buffer. */
+            unsigned int bit_count_ = 0;
+            /** Has a read failed? */
+            bool failed_ = false;
+
+        };
+
+    }
+
+}
+
+#endif
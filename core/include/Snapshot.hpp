@@ -0,0 +1,334 @@
+#ifndef SEEDENGINE_INCLUDE_SNAPSHOT_H_
+#define SEEDENGINE_INCLUDE_SNAPSHOT_H_
+
+#include "Core.hpp"
+#include "Camera.hpp"
+#include "Memory.hpp"
+#include "Mesh.hpp"
+#include "Stats.hpp"
+#include "Time.hpp"
+
+#include <condition_variable>
+
+namespace seedengine {
+
+    /** A mesh to draw, placed in the world by a model matrix. */
+    struct DrawItem {
+        /** The mesh to draw. */
+        const Mesh* mesh;
+        /** The transformation matrix of the mesh. */
+        glm::mat4 model;
+    };
+
+    /**
+     * @brief Everything the renderer needs to draw one frame, copied out of the simulation.
+     * @details A snapshot is filled by the simulation once its ticks are done, and is only read
+     *          by the renderer after that, so rendering never touches live actors. Meshes are
+     *          referenced by pointer, and must stay loaded for two frames after being submitted.
+     */
+    class RenderSnapshot final {
+
+        friend class FrameExchange;
+
+    public:
+
+        /** Constructs a new, empty Render Snapshot. */
+        RenderSnapshot() = default;
+
+        RenderSnapshot(const RenderSnapshot&) = delete;
+        RenderSnapshot& operator=(const RenderSnapshot&) = delete;
+
+        /**
+         * @brief Sets the view of the frame from a camera.
+         *
+         * @param camera The camera to view the frame from.
+         */
+        void setCamera(const Camera& camera);
+        /**
+         * @brief Sets the view of the frame.
+         *
+         * @param view The view matrix.
+         * @param projection The projection matrix.
+         * @param position The position of the viewer.
+         */
+        void setCamera(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& position);
+
+        /**
+         * @brief Adds a mesh to the draw list.
+         *
+         * @param mesh The mesh to draw.
+         * @param model The transformation matrix of the mesh.
+         */
+        inline void submit(const Mesh* mesh, const glm::mat4& model) {
+            draws_.push_back(DrawItem{ mesh, model });
+        }
+        /**
+         * @brief Adds a mesh to the draw list.
+         *
+         * @param mesh The mesh to draw.
+         * @param transform The transform of the mesh.
+         */
+        inline void submit(const Mesh* mesh, const Transform& transform) {
+            submit(mesh, transform.getTransformationMatrix());
+        }
+        /**
+         * @brief Adds a mesh to the draw list, placed between its last two fixed update states
+         *        by the interpolation alpha of the frame.
+         *
+         * @param mesh The mesh to draw.
+         * @param previous The transform of the mesh before the last update.
+         * @param current The transform of the mesh after the last update.
+         */
+        inline void submit(const Mesh* mesh, const Transform& previous, const Transform& current) {
+            submit(mesh, Transform::interpolate(previous, current, alpha_));
+        }
+
+        /**
+         * @brief Sets how far the frame is between the last fixed update and the next one.
+         *
+         * @param alpha The leftover simulation time divided by the update interval, from 0 to 1.
+         */
+        inline void setAlpha(float alpha) { alpha_ = alpha; }
+
+        /** Empties the draw list and resets the view, keeping the memory of the list. */
+        void clear();
+
+        /**
+         * @brief Returns the draw list.
+         *
+         * @return const TrackedVector<DrawItem, MemoryTag::RENDER>& The meshes to draw, in submission order.
+         */
+        inline const TrackedVector<DrawItem, MemoryTag::RENDER>& draws() const { return draws_; }
+        /**
+         * @brief Returns the number of meshes to draw.
+         *
+         * @return size_t The size of the draw list.
+         */
+        inline size_t drawCount() const { return draws_.size(); }
+        /**
+         * @brief Has a view been set for this frame?
+         *
+         * @return true If setCamera() was called since the snapshot was cleared.
+         */
+        inline bool hasCamera() const { return has_camera_; }
+        /**
+         * @brief Returns the view matrix of the frame.
+         *
+         * @return const glm::mat4& The view matrix.
+         */
+        inline const glm::mat4& view() const { return view_; }
+        /**
+         * @brief Returns the projection matrix of the frame.
+         *
+         * @return const glm::mat4& The projection matrix.
+         */
+        inline const glm::mat4& projection() const { return projection_; }
+        /**
+         * @brief Returns the position of the viewer.
+         *
+         * @return const glm::vec3& The position of the viewer.
+         */
+        inline const glm::vec3& cameraPosition() const { return camera_position_; }
+        /**
+         * @brief Returns how far the frame is between the last fixed update and the next one.
+         *
+         * @return float The interpolation alpha, 1 if none was set.
+         */
+        inline float alpha() const { return alpha_; }
+
+        /**
+         * @brief Returns the index of the frame this snapshot was taken in.
+         *
+         * @return uint64_t The frame index.
+         */
+        inline uint64_t frame() const { return frame_; }
+        /**
+         * @brief Returns the time the simulation of this frame started.
+         *
+         * @return int64_t The time on the Time::nowNS() clock.
+         */
+        inline int64_t simulationStartNS() const { return simulation_start_ns_; }
+
+    private:
+
+        /** The meshes to draw. */
+        TrackedVector<DrawItem, MemoryTag::RENDER> draws_;
+        /** The view matrix. */
+        glm::mat4 view_ = glm::mat4(1.0f);
+        /** The projection matrix. */
+        glm::mat4 projection_ = glm::mat4(1.0f);
+        /** The position of the viewer. */
+        glm::vec3 camera_position_ = glm::vec3(0.0f);
+        /** Has a view been set? */
+        bool has_camera_ = false;
+        /** The interpolation alpha of the frame. */
+        float alpha_ = 1.0f;
+        /** The index of the frame. */
+        uint64_t frame_ = 0;
+        /** The time the simulation of the frame started. */
+        int64_t simulation_start_ns_ = 0;
+
+    };
+
+    /**
+     * @brief Hands render snapshots from the simulation to the renderer through two buffers.
+     * @details The simulation fills the back snapshot while the renderer reads the front one.
+     *          publish() is the sync point: it waits until the renderer is done with the front
+     *          snapshot, then swaps the two. With the simulation and renderer on separate
+     *          threads, the simulation of frame N+1 overlaps the rendering of frame N. On a single
+     *          thread, calling publish(), acquire() and release() in turn runs every frame
+     *          serially, with the same measurements.
+     *          Latency is the time from the start of a frame's simulation to the end of its
+     *          rendering, and throughput is the number of frames rendered per second.
+     */
+    class FrameExchange final {
+
+    public:
+
+        /** Constructs a new Frame Exchange. */
+        FrameExchange() = default;
+
+        FrameExchange(const FrameExchange&) = delete;
+        FrameExchange& operator=(const FrameExchange&) = delete;
+
+        /**
+         * @brief Starts the simulation of the next frame. Called by the simulation.
+         *
+         * @return RenderSnapshot& The cleared back snapshot, to be filled for the frame.
+         */
+        RenderSnapshot& begin();
+
+        /**
+         * @brief Hands the back snapshot to the renderer, waiting until the renderer is done
+         *        with the front snapshot. Called by the simulation.
+         *
+         * @return true If the snapshot was published, false if the exchange was closed.
+         */
+        bool publish();
+
+        /**
+         * @brief Waits for a published snapshot. Called by the renderer.
+         *
+         * @return const RenderSnapshot* The snapshot to render, or nullptr once the exchange is
+         *         closed and every published snapshot has been acquired.
+         */
+        const RenderSnapshot* acquire();
+
+        /** Marks the acquired snapshot as rendered. Called by the renderer. */
+        void release();
+
+        /** Wakes both sides. Later publishes fail, and acquire() only returns snapshots published before closing. */
+        void close();
+        /** Reopens a closed exchange and clears its measurements. */
+        void reset();
+
+        /**
+         * @brief Has the exchange been closed?
+         *
+         * @return true If close() was called.
+         */
+        bool isClosed() const;
+
+        /**
+         * @brief Returns the time from the start of each frame's simulation to the end of its
+         *        rendering.
+         *
+         * @return const util::Histogram& The frame latencies in nanoseconds.
+         */
+        inline const util::Histogram& latency() const { return latency_; }
+        /**
+         * @brief Returns the time between the ends of consecutive renders.
+         *
+         * @return const util::Histogram& The frame intervals in nanoseconds.
+         */
+        inline const util::Histogram& intervals() const { return intervals_; }
+        /**
+         * @brief Returns the time each frame spent in simulation, from begin() to publish().
+         *
+         * @return const util::Histogram& The simulation times in nanoseconds.
+         */
+        inline const util::Histogram& simulationTimes() const { return simulation_; }
+        /**
+         * @brief Returns the time each frame spent rendering, from acquire() to release().
+         *
+         * @return const util::Histogram& The render times in nanoseconds.
+         */
+        inline const util::Histogram& renderTimes() const { return render_; }
+        /**
+         * @brief Returns the total time the simulation waited for the renderer.
+         *
+         * @return int64_t The wait time in nanoseconds.
+         */
+        inline int64_t publishWaitNS() const { return publish_wait_ns_; }
+        /**
+         * @brief Returns the total time the renderer waited for the simulation.
+         *
+         * @return int64_t The wait time in nanoseconds.
+         */
+        inline int64_t acquireWaitNS() const { return acquire_wait_ns_; }
+        /**
+         * @brief Returns the number of rendered frames.
+         *
+         * @return uint64_t The number of frames.
+         */
+        inline uint64_t rendered() const { return latency_.count(); }
+
+        /**
+         * @brief Returns the number of frames rendered per second, from the first render to
+         *        the last.
+         *
+         * @return double The throughput in frames per second, or 0 before two renders.
+         */
+        double throughput() const;
+
+        /**
+         * @brief Returns the pipeline statistics as a single line of text.
+         *
+         * @return string The formatted statistics.
+         */
+        string summary() const;
+
+    private:
+
+        /** The two snapshots. */
+        RenderSnapshot buffers_[2];
+        /** The index of the back snapshot. */
+        unsigned int back_ = 0;
+        /** Has a snapshot been published that the renderer has not acquired? */
+        bool ready_ = false;
+        /** Is the renderer reading the front snapshot? */
+        bool reading_ = false;
+        /** Has the exchange been closed? */
+        bool closed_ = false;
+        /** The index of the next frame. */
+        uint64_t next_frame_ = 0;
+
+        /** Guards the state shared by the two sides. */
+        mutable std::mutex mu_;
+        /** Signalled when a snapshot is published or released. */
+        std::condition_variable changed_;
+
+        /** The time the current render started. */
+        int64_t render_start_ns_ = 0;
+        /** The end of the first render, or -1 before it. */
+        int64_t first_release_ns_ = -1;
+        /** The end of the last render, or -1 before it. */
+        int64_t last_release_ns_ = -1;
+        /** The frame latencies. */
+        util::Histogram latency_;
+        /** The time between renders. */
+        util::Histogram intervals_;
+        /** The simulation times. */
+        util::Histogram simulation_;
+        /** The render times. */
+        util::Histogram render_;
+        /** The total time the simulation waited. */
+        int64_t publish_wait_ns_ = 0;
+        /** The total time the renderer waited. */
+        int64_t acquire_wait_ns_ = 0;
+
+    };
+
+}
+
+#endif
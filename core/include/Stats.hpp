@@ -0,0 +1,402 @@
+#ifndef SEEDENGINE_INCLUDE_STATS_H_
+#define SEEDENGINE_INCLUDE_STATS_H_
+
+#include "Core.hpp"
+
+namespace seedengine {
+
+    namespace util {
+
+        /**
+         * @brief A histogram of durations with a fixed memory footprint.
+         * @details Values are counted in log-linear buckets: each power of two is split into
+         *          32 buckets, so percentiles are within about 3% of the exact value no matter
+         *          how many values are recorded. Recording a value never allocates.
+         */
+        class Histogram final {
+
+        public:
+
+            /** The number of linear buckets each power of two is split into. */
+            static const unsigned int SUB_BUCKETS = 32;
+            /** The number of bits needed to index the linear buckets. */
+            static const unsigned int SUB_BUCKET_BITS = 5;
+            /** The total number of buckets, covering every 64 bit value. */
+            static const unsigned int BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+            /** Constructs a new, empty Histogram. */
+            Histogram();
+
+            /**
+             * @brief Counts a value.
+             *
+             * @param value The value to count, usually a duration in nanoseconds.
+             */
+            void record(uint64_t value);
+
+            /**
+             * @brief Adds every value counted by another histogram.
+             *
+             * @param other The histogram to merge.
+             */
+            void merge(const Histogram& other);
+
+            /** Removes every counted value. */
+            void clear();
+
+            /**
+             * @brief Returns a value at least as large as the given fraction of counted values.
+             *
+             * @param fraction The fraction of values, from 0 to 1. 0.5 is the median.
+             * @return uint64_t The upper bound of the bucket holding the percentile, or 0 if empty.
+             */
+            uint64_t percentile(double fraction) const;
+
+            /**
+             * @brief Returns the number of counted values.
+             *
+             * @return uint64_t The number of values.
+             */
+            inline uint64_t count() const { return count_; }
+            /**
+             * @brief Returns the smallest counted value.
+             *
+             * @return uint64_t The smallest value, or 0 if empty.
+             */
+            inline uint64_t min() const { return count_ == 0 ? 0 : min_; }
+            /**
+             * @brief Returns the largest counted value.
+             *
+             * @return uint64_t The largest value, or 0 if empty.
+             */
+            inline uint64_t max() const { return max_; }
+            /**
+             * @brief Returns the sum of every counted value.
+             *
+             * @return uint64_t The sum of the values.
+             */
+            inline uint64_t total() const { return total_; }
+            /**
+             * @brief Returns the mean of the counted values.
+             *
+             * @return double The mean, or 0 if empty.
+             */
+            inline double mean() const { return count_ == 0 ? 0.0 : static_cast<double>(total_) / count_; }
+
+            /**
+             * @brief Returns the bucket a value is counted in.
+             *
+             * @param value The value.
+             * @return unsigned int The bucket index.
+             */
+            static unsigned int bucketOf(uint64_t value);
+            /**
+             * @brief Returns the largest value counted in a bucket.
+             *
+             * @param bucket The bucket index.
+             * @return uint64_t The upper bound of the bucket.
+             */
+            static uint64_t upperBound(unsigned int bucket);
+
+        private:
+
+            /** The number of values in each bucket. */
+            std::vector<uint64_t> buckets_;
+            /** The number of counted values. */
+            uint64_t count_ = 0;
+            /** The sum of the counted values. */
+            uint64_t total_ = 0;
+            /** The smallest counted value. */
+            uint64_t min_ = ~0ull;
+            /** The largest counted value. */
+            uint64_t max_ = 0;
+
+        };
+
+        /**
+         * @brief The most recent values of a series, kept in a ring buffer.
+         * @details Once full, each value replaces the oldest one, so the statistics follow the
+         *          last few seconds rather than the whole run. Percentiles are exact, and sort a
+         *          copy of the values kept by the window, so they never allocate.
+         */
+        class RollingWindow final {
+
+        public:
+
+            /**
+             * @brief Constructs a new, empty Rolling Window.
+             *
+             * @param capacity The number of values kept, at least 1.
+             */
+            explicit RollingWindow(size_t capacity = 600);
+
+            /**
+             * @brief Adds a value, replacing the oldest one when full.
+             *
+             * @param value The value, usually a duration in nanoseconds.
+             */
+            void record(uint64_t value);
+
+            /** Removes every value. */
+            void clear();
+
+            /**
+             * @brief Returns a value by age.
+             *
+             * @param index The index of the value, 0 being the oldest kept.
+             * @return uint64_t The value.
+             */
+            uint64_t at(size_t index) const;
+            /**
+             * @brief Returns the newest value.
+             *
+             * @return uint64_t The newest value, or 0 if empty.
+             */
+            uint64_t latest() const;
+
+            /**
+             * @brief Returns the mean of the values.
+             *
+             * @return double The mean, or 0 if empty.
+             */
+            inline double mean() const { return size_ == 0 ? 0.0 : static_cast<double>(total_) / size_; }
+            /**
+             * @brief Returns the largest value.
+             *
+             * @return uint64_t The largest value, or 0 if empty.
+             */
+            uint64_t max() const;
+            /**
+             * @brief Returns the value at least as large as the given fraction of values.
+             *
+             * @param fraction The fraction of values, from 0 to 1. 0.5 is the median.
+             * @return uint64_t The percentile, or 0 if empty.
+             */
+            uint64_t percentile(double fraction) const;
+            /**
+             * @brief Returns the number of values above a threshold.
+             *
+             * @param threshold The threshold.
+             * @return size_t The number of larger values.
+             */
+            size_t countAbove(uint64_t threshold) const;
+
+            /**
+             * @brief Returns the number of values kept.
+             *
+             * @return size_t The number of values.
+             */
+            inline size_t size() const { return size_; }
+            /**
+             * @brief Returns the most values kept.
+             *
+             * @return size_t The capacity.
+             */
+            inline size_t capacity() const { return values_.size(); }
+
+        private:
+
+            /** The values, starting at next_ once full. */
+            std::vector<uint64_t> values_;
+            /** A copy of the values reordered by percentile(). */
+            mutable std::vector<uint64_t> sorted_;
+            /** The index the next value is written to. */
+            size_t next_ = 0;
+            /** The number of values kept. */
+            size_t size_ = 0;
+            /** The sum of the values kept. */
+            uint64_t total_ = 0;
+
+        };
+
+    }
+
+    /** The parts of a frame timed by #FrameStats. */
+    enum class FrameStage : unsigned int {
+        /** The whole frame, from the start of one to the start of the next. */
+        FRAME      = 0,
+        /** The fixed updates of the frame: the tick event and the component ticks. */
+        TICK       = 1,
+        /** The pre-render event. */
+        PRE_RENDER = 2,
+        /** The render event. */
+        RENDER     = 3,
+        /** The window update, which swaps the buffers. */
+        SWAP       = 4
+    };
+
+    /**
+     * @brief Rolling frame time statistics of the engine, for telemetry and spotting stutter.
+     * @details The time of each stage is added up over a frame, and endFrame() moves the totals
+     *          into a rolling window and a histogram of the whole run. A hitch is a frame
+     *          longer than the hitch threshold, or twice the rolling median frame time when no
+     *          threshold is set. While a CSV file is open, endFrame() also writes a line with
+     *          the stage times of the frame. Stages may be recorded from any thread, so the
+     *          simulation and render threads of a pipelined program share one instance; a
+     *          frame then holds the stages recorded since the last endFrame().
+     */
+    class FrameStats final {
+
+    public:
+
+        /** The number of stages. */
+        static const unsigned int STAGES = 5;
+
+        /**
+         * @brief Constructs a new Frame Stats.
+         *
+         * @param window The number of frames in the rolling windows.
+         */
+        explicit FrameStats(size_t window = 600);
+        /** Closes the CSV file. */
+        ~FrameStats();
+
+        FrameStats(const FrameStats&) = delete;
+        FrameStats& operator=(const FrameStats&) = delete;
+
+        /**
+         * @brief Clears every statistic.
+         *
+         * @param window The number of frames in the rolling windows.
+         */
+        void reset(size_t window);
+        /**
+         * @brief Sets the frame time above which a frame counts as a hitch.
+         *
+         * @param threshold_ns The threshold in nanoseconds. 0 uses twice the rolling median.
+         */
+        void setHitchThreshold(uint64_t threshold_ns);
+
+        /**
+         * @brief Adds time spent in a stage during the current frame.
+         *
+         * @param stage The stage.
+         * @param ns The time in nanoseconds.
+         */
+        void record(FrameStage stage, int64_t ns);
+        /**
+         * @brief Ends the current frame.
+         *
+         * @param frame_ns The length of the frame in nanoseconds.
+         */
+        void endFrame(int64_t frame_ns);
+
+        /**
+         * @brief Starts writing the stage times of every frame.
+         *
+         * @param path The path of the CSV file. An existing file is replaced.
+         * @return true If the file was opened.
+         */
+        bool startCsv(const string& path);
+        /** Stops writing frames and closes the file. */
+        void stopCsv();
+
+        /**
+         * @brief Returns the mean time of a stage over the rolling window.
+         *
+         * @param stage The stage.
+         * @return double The mean in nanoseconds.
+         */
+        double mean(FrameStage stage) const;
+        /**
+         * @brief Returns a percentile of the time of a stage over the rolling window.
+         *
+         * @param stage The stage.
+         * @param fraction The fraction of frames, from 0 to 1. 0.99 is the 99th percentile.
+         * @return uint64_t The percentile in nanoseconds.
+         */
+        uint64_t percentile(FrameStage stage, double fraction) const;
+        /**
+         * @brief Returns the longest time of a stage over the rolling window.
+         *
+         * @param stage The stage.
+         * @return uint64_t The longest time in nanoseconds.
+         */
+        uint64_t max(FrameStage stage) const;
+        /**
+         * @brief Returns the times of a stage over the whole run.
+         *
+         * @param stage The stage.
+         * @return util::Histogram A copy of the histogram of the stage, in nanoseconds.
+         */
+        util::Histogram histogram(FrameStage stage) const;
+
+        /**
+         * @brief Returns the frames per second over the rolling window.
+         *
+         * @return double The frame rate, or 0 before the first frame.
+         */
+        double fps() const;
+        /**
+         * @brief Returns the number of frames ended.
+         *
+         * @return uint64_t The number of frames.
+         */
+        uint64_t frames() const;
+        /**
+         * @brief Returns the number of hitches over the whole run.
+         *
+         * @return uint64_t The number of hitches.
+         */
+        uint64_t hitches() const;
+        /**
+         * @brief Returns the number of hitches in the rolling window.
+         *
+         * @return size_t The number of hitches.
+         */
+        size_t recentHitches() const;
+
+        /**
+         * @brief Writes the statistics of every stage.
+         *
+         * @param out The stream to write to.
+         */
+        void report(std::ostream& out) const;
+        /**
+         * @brief Returns the frame rate, frame times and hitches as a single line of text.
+         *
+         * @return string The formatted statistics.
+         */
+        string summary() const;
+
+        /**
+         * @brief Returns the name of a stage, as used in the CSV header.
+         *
+         * @param stage The stage.
+         * @return const char* The name of the stage.
+         */
+        static const char* stageName(FrameStage stage);
+
+    private:
+
+        /**
+         * @brief Returns the hitch threshold for the current window. Requires the lock.
+         *
+         * @return uint64_t The threshold in nanoseconds, or 0 while too few frames are known.
+         */
+        uint64_t hitchThreshold() const;
+
+        /** Guards every member. */
+        mutable std::mutex mu_;
+        /** The time of each stage in the current frame. */
+        std::array<uint64_t, STAGES> pending_;
+        /** The recent frames of each stage. */
+        std::vector<util::RollingWindow> windows_;
+        /** The frames of each stage over the whole run. */
+        std::vector<util::Histogram> histograms_;
+        /** The set hitch threshold, or 0. */
+        uint64_t hitch_threshold_ns_ = 0;
+        /** Was each frame of the window a hitch? */
+        util::RollingWindow recent_hitches_;
+        /** The number of hitches. */
+        uint64_t hitches_ = 0;
+        /** The number of frames. */
+        uint64_t frames_ = 0;
+        /** The CSV file. */
+        std::ofstream csv_;
+
+    };
+
+}
+
+#endif
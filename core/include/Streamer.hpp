@@ -0,0 +1,388 @@
+#ifndef SEEDENGINE_INCLUDE_STREAMER_H_
+#define SEEDENGINE_INCLUDE_STREAMER_H_
+
+#include "Core.hpp"
+#include "Asset.hpp"
+#include "Event.hpp"
+
+#include <atomic>
+#include <condition_variable>
+
+namespace seedengine {
+
+    /** The priority class of a streaming request. Lower values are serviced first. */
+    enum class StreamPriority : unsigned int {
+        /** The asset blocks gameplay and ignores the per-frame upload budget. */
+        CRITICAL = 0,
+        /** The asset is required by gameplay in the near future. */
+        GAMEPLAY = 1,
+        /** The asset is near the camera. */
+        NEARBY   = 2,
+        /** The asset is being prefetched in the background. */
+        PREFETCH = 3
+    };
+
+    /** The state of a streaming request. */
+    enum class StreamState : unsigned int {
+        /** The request is waiting for I/O bandwidth. */
+        PENDING   = 0,
+        /** The asset data is being read by the stream source. */
+        READING   = 1,
+        /** The asset data has been read and is waiting to be handed over to upload. */
+        READY     = 2,
+        /** The asset has been handed over to upload and is waiting for its upload to run. */
+        UPLOADING = 3,
+        /** The asset has been uploaded. */
+        COMPLETE  = 4,
+        /** The request was cancelled. */
+        CANCELLED = 5,
+        /** The request does not exist, or finished long enough ago to be forgotten. */
+        UNKNOWN   = 6
+    };
+
+    /**
+     * @brief A source of asset data for the #AssetStreamer.
+     * @details Stream sources read asynchronously. The streamer starts reads with begin() and
+     *          polls for finished reads with collect() once per frame, then takes the bytes of
+     *          each finished read with take() so the upload step parses them from memory.
+     */
+    class StreamSource {
+
+    public:
+
+        /** Destroys this stream source. */
+        virtual ~StreamSource() {}
+
+        /**
+         * @brief Starts reading an asset. This must not block.
+         *
+         * @param id The id of the streaming request.
+         * @param path The path to the asset.
+         * @param bytes The expected size of the asset in bytes.
+         */
+        virtual void begin(unsigned int id, const string& path, uint64_t bytes) = 0;
+
+        /**
+         * @brief Abandons a read that is no longer wanted. The read may still be reported by collect().
+         *
+         * @param id The id of the streaming request.
+         */
+        virtual void cancel(unsigned int id) {}
+
+        /**
+         * @brief Appends the ids of all reads that have finished since the last call.
+         *
+         * @param completed The list to append finished request ids to.
+         */
+        virtual void collect(std::vector<unsigned int>& completed) = 0;
+
+        /**
+         * @brief Takes the bytes of a finished read. Sources that only warm the file cache
+         *        keep no bytes, in which case the asset is read from its file on upload.
+         *
+         * @param id The id of a streaming request reported by collect().
+         * @param data The vector to move the bytes into.
+         * @return true If the bytes of the read were kept.
+         */
+        virtual bool take(unsigned int id, std::vector<char>& data) { return false; }
+
+    };
+
+    /**
+     * @brief A stream source that reads files on a background thread.
+     * @details Files are read in full on the reader thread and kept until the streamer takes
+     *          them, so the upload step never touches the disk.
+     */
+    class FileStreamSource final : public StreamSource {
+
+    public:
+
+        /** Constructs a new File Stream Source and starts its reader thread. */
+        FileStreamSource();
+        /** Stops the reader thread. */
+        ~FileStreamSource();
+
+        void begin(unsigned int id, const string& path, uint64_t) override;
+        void cancel(unsigned int id) override;
+        void collect(std::vector<unsigned int>& completed) override;
+        bool take(unsigned int id, std::vector<char>& data) override;
+
+    private:
+
+        /** The function executed by the reader thread. */
+        void readLoop();
+
+        /** A mutex protecting the queues of this source. */
+        std::mutex mu_;
+        /** Signals the reader thread that work is available. */
+        std::condition_variable cv_;
+        /** The reads waiting for the reader thread. */
+        std::deque<std::pair<unsigned int, string>> queued_;
+        /** The reads that have finished. */
+        std::vector<unsigned int> finished_;
+        /** The bytes of finished reads, until they are taken. */
+        std::map<unsigned int, std::vector<char>> data_;
+        /** Instructs the reader thread to exit. */
+        bool stop_ = false;
+        /** The reader thread. */
+        std::thread reader_;
+
+    };
+
+    /**
+     * @brief A scheduler that streams assets in priority order under I/O and upload budgets.
+     * @details Requests are ordered by priority class, then by distance to the viewer, then by
+     *          request order. Reads are only started while the outstanding I/O bytes stay within
+     *          the I/O budget, and finished reads are only uploaded while the bytes uploaded this
+     *          frame stay within the upload budget, so streaming never causes a frame hitch.
+     *          The budgets always admit a single request, so an oversized asset cannot stall.
+     *
+     *          Scheduling and uploading may run on different threads. schedule() runs on the
+     *          thread that makes requests and hands the assets to upload over through a queue,
+     *          which upload() drains within the upload budget on the thread that owns the
+     *          graphics context. The queue is only topped up to one frame's budget, and
+     *          schedule() completes the requests whose uploads have run since its last call.
+     *
+     * @see #AssetLibrary
+     * @see #StreamSource
+     */
+    class AssetStreamer final {
+
+    public:
+
+        /** The number of updates a finished request keeps reporting its final state for. */
+        static const unsigned int FINISHED_UPDATES = 60;
+
+        /**
+         * @brief The function called on the main thread to upload a streamed asset, given its
+         *        path and the bytes read from it. The bytes are empty if the source kept none.
+         */
+        typedef std::function<void(const string&, const std::vector<char>&)> UploadFunction;
+
+        /**
+         * @brief Constructs a new Asset Streamer.
+         *
+         * @param source The source to read assets from. The streamer does not take ownership.
+         * @param max_io_bytes The maximum number of bytes being read at once.
+         * @param max_upload_bytes The maximum number of bytes uploaded per frame.
+         */
+        AssetStreamer(StreamSource* source, uint64_t max_io_bytes, uint64_t max_upload_bytes);
+
+        /**
+         * @brief Requests that an asset be streamed into an #AssetLibrary.
+         *
+         * @tparam T The asset type.
+         * @param path The path to the asset.
+         * @param priority The priority class of the request.
+         * @param position The world position of the asset, used for distance-based priority.
+         * @return unsigned int The id of the request.
+         */
+        template <class T>
+        unsigned int request(const string& path, StreamPriority priority,
+                const glm::vec3& position = glm::vec3(0.0f, 0.0f, 0.0f)) {
+            return request(path, priority, position, [](const string& p, const std::vector<char>& data) {
+                // Only the new asset is touched here, the library belongs to the dispatch thread
+                std::shared_ptr<T> asset = AssetLibrary<T>::loadDetached(p, data);
+                EventDispatcher::post([asset]() { AssetLibrary<T>::adopt(asset); });
+            });
+        }
+
+        /**
+         * @brief Requests that an asset be streamed, uploading it with a custom function.
+         * @details The size of the asset is taken from the #AssetManifest.
+         *
+         * @param path The path to the asset.
+         * @param priority The priority class of the request.
+         * @param position The world position of the asset, used for distance-based priority.
+         * @param upload The function used to upload the asset once read.
+         * @param bytes The size of the asset. Taken from the manifest if zero.
+         * @return unsigned int The id of the request.
+         */
+        unsigned int request(const string& path, StreamPriority priority, const glm::vec3& position,
+                UploadFunction upload, uint64_t bytes = 0);
+
+        /**
+         * @brief Cancels a request that is no longer wanted.
+         *
+         * @param id The id of the request.
+         * @return true If the request was cancelled before being uploaded.
+         */
+        bool cancel(unsigned int id);
+
+        /**
+         * @brief Changes the priority class of a request.
+         *
+         * @param id The id of the request.
+         * @param priority The new priority class.
+         */
+        void setPriority(unsigned int id, StreamPriority priority);
+
+        /**
+         * @brief Updates the viewer position, reprioritizing all waiting requests by distance.
+         *
+         * @param position The new viewer position.
+         */
+        void setViewerPosition(const glm::vec3& position);
+
+        /**
+         * @brief Advances the streamer by one frame on a single thread. Calls schedule(), then
+         *        upload(), then completes the requests just uploaded.
+         */
+        void update();
+        /**
+         * @brief Completes the requests uploaded since the last call, collects finished reads,
+         *        tops the upload queue up to the upload budget, and starts new reads within the
+         *        I/O budget. Must be called on the thread that makes requests.
+         */
+        void schedule();
+        /**
+         * @brief Uploads the assets handed over by schedule() that fit the upload budget,
+         *        leaving the rest queued for the next call. May be called on another thread,
+         *        such as the render thread between its frames.
+         *
+         * @return size_t The number of assets uploaded.
+         */
+        size_t upload();
+
+        /**
+         * @brief Returns the state of a request. A request is COMPLETE once its upload has run
+         *        and schedule() has seen it. Completed and cancelled requests keep reporting
+         *        their final state for #FINISHED_UPDATES updates, after which their ids are
+         *        forgotten and reported as UNKNOWN, like ids that were never requested.
+         *
+         * @param id The id of the request.
+         * @return StreamState The state of the request.
+         */
+        StreamState state(unsigned int id) const;
+
+        /**
+         * @brief Returns the number of bytes currently being read.
+         *
+         * @return uint64_t The number of outstanding I/O bytes.
+         */
+        inline uint64_t outstandingBytes() const { return outstanding_bytes_; }
+        /**
+         * @brief Returns the number of bytes uploaded by the last call to upload().
+         *
+         * @return uint64_t The number of bytes uploaded last frame.
+         */
+        inline uint64_t uploadedBytes() const { return uploaded_bytes_; }
+        /**
+         * @brief Returns the number of requests that have not been uploaded or cancelled.
+         *
+         * @return size_t The number of active requests.
+         */
+        inline size_t activeRequests() const { return requests_.size(); }
+
+        /**
+         * @brief Sets the maximum number of bytes being read at once.
+         *
+         * @param bytes The new I/O budget.
+         */
+        inline void setIOBudget(uint64_t bytes) { max_io_bytes_ = bytes; }
+        /**
+         * @brief Sets the maximum number of bytes uploaded per frame.
+         *
+         * @param bytes The new upload budget.
+         */
+        inline void setUploadBudget(uint64_t bytes) { max_upload_bytes_ = bytes; }
+
+    private:
+
+        /** A single streaming request. */
+        struct Request {
+            /** The id of this request. */
+            unsigned int id;
+            /** The path to the asset. */
+            string path;
+            /** The priority class of this request. */
+            StreamPriority priority;
+            /** The world position of the asset. */
+            glm::vec3 position;
+            /** The distance between the asset and the viewer. */
+            float distance;
+            /** The size of the asset in bytes. */
+            uint64_t bytes;
+            /** The state of this request. */
+            StreamState state;
+            /** The function used to upload the asset. */
+            UploadFunction upload;
+            /** The bytes read from the asset, if the source kept them. */
+            std::vector<char> data;
+        };
+
+        /** An asset handed over by schedule() to upload(). */
+        struct Upload {
+            /** The id of the request. */
+            unsigned int id;
+            /** The size of the asset in bytes. */
+            uint64_t bytes;
+            /** Whether the asset ignores the upload budget. */
+            bool critical;
+            /** The path to the asset. */
+            string path;
+            /** The bytes read from the asset, if the source kept them. */
+            std::vector<char> data;
+            /** The function used to upload the asset. */
+            UploadFunction upload;
+        };
+
+        /**
+         * @brief Orders two requests by priority class, distance, then request order.
+         *
+         * @param a The first request.
+         * @param b The second request.
+         * @return true If a should be serviced before b.
+         */
+        static bool before(const Request* a, const Request* b);
+        /** Completes the requests whose uploads have run since the last call. */
+        void completeUploads();
+
+        /** The source assets are read from. */
+        StreamSource* source_;
+        /** The maximum number of bytes being read at once. */
+        uint64_t max_io_bytes_;
+        /** The maximum number of bytes uploaded per frame. Read by the uploading thread. */
+        std::atomic<uint64_t> max_upload_bytes_;
+        /** The number of bytes currently being read. */
+        uint64_t outstanding_bytes_ = 0;
+        /** The number of bytes uploaded by the last call to upload(). */
+        std::atomic<uint64_t> uploaded_bytes_ { 0 };
+        /** The current viewer position. */
+        glm::vec3 viewer_;
+        /** The id of the next request. */
+        unsigned int next_id_ = 1;
+        /** All active requests by id. */
+        std::map<unsigned int, Request> requests_;
+        /** The number of updates run so far. */
+        uint64_t updates_ = 0;
+        /** The final states of recently finished requests, with the update they finished in. */
+        std::map<unsigned int, std::pair<StreamState, uint64_t>> finished_;
+        /** Reads that were cancelled while in flight, with their sizes. */
+        std::map<unsigned int, uint64_t> abandoned_;
+        /** Scratch storage for finished reads. */
+        std::vector<unsigned int> completed_;
+        /** Scratch storage for the bytes of abandoned reads. */
+        std::vector<char> discarded_;
+        /** Scratch storage for ordering requests. */
+        std::vector<Request*> order_;
+        /** A mutex guarding the handed over uploads and the uploaded ids. */
+        std::mutex uploads_mu_;
+        /** The assets handed over by schedule() and not yet uploaded, in priority order. */
+        std::deque<Upload> uploads_;
+        /** The number of bytes waiting in the upload queue. */
+        uint64_t queued_bytes_ = 0;
+        /** The ids of the requests uploaded since schedule() last completed them. */
+        std::vector<unsigned int> uploaded_;
+        /** Scratch storage for the uploads being drained. */
+        std::vector<Upload> uploading_;
+        /** Scratch storage for the ids of the uploads being drained. */
+        std::vector<unsigned int> uploading_ids_;
+        /** Scratch storage for the ids being completed. */
+        std::vector<unsigned int> completing_;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,468 @@
+#ifndef SEEDENGINE_INCLUDE_TICK_H_
+#define SEEDENGINE_INCLUDE_TICK_H_
+
+#include "Core.hpp"
+#include "Actor.hpp"
+#include "Jobs.hpp"
+#include "Memory.hpp"
+#include "Profile.hpp"
+#include "Stats.hpp"
+#include "Time.hpp"
+
+#include <atomic>
+#include <typeindex>
+
+namespace seedengine {
+
+    /**
+     * @brief The engine data a component type reads and writes in Component::update().
+     * @details Data is named freely, such as "Transform" or "Audio", and the names are only
+     *          compared with each other. Two component types conflict when either writes data
+     *          the other reads or writes. A type that declares nothing conflicts with every other
+     *          type, so undeclared components keep running one type at a time.
+     */
+    class TickAccess final {
+
+    public:
+
+        /** Constructs a new, undeclared Tick Access. */
+        TickAccess() = default;
+
+        /**
+         * @brief Sets the name reported in the tick timings.
+         *
+         * @param name The name of the component type.
+         * @return TickAccess& This access, for chaining.
+         */
+        TickAccess& setName(const string& name);
+        /**
+         * @brief Declares data that is read.
+         *
+         * @param data The name of the data.
+         * @return TickAccess& This access, for chaining.
+         */
+        TickAccess& reads(const string& data);
+        /**
+         * @brief Declares data that is written.
+         *
+         * @param data The name of the data.
+         * @return TickAccess& This access, for chaining.
+         */
+        TickAccess& writes(const string& data);
+        /**
+         * @brief Declares that each component only touches the data of its own actor, so the
+         *        components of the type may update in parallel with each other.
+         *
+         * @param per_actor Are the components independent of each other?
+         * @return TickAccess& This access, for chaining.
+         */
+        TickAccess& perActor(bool per_actor = true);
+
+        /**
+         * @brief Must this type run apart from another?
+         *
+         * @param other The access of the other type.
+         * @return true If the two types may not update at the same time.
+         */
+        bool conflictsWith(const TickAccess& other) const;
+
+        /**
+         * @brief Returns the name reported in the tick timings.
+         *
+         * @return const string& The name of the component type.
+         */
+        inline const string& name() const { return name_; }
+        /**
+         * @brief Has any data been declared?
+         *
+         * @return true If reads() or writes() was called.
+         */
+        inline bool isDeclared() const { return declared_; }
+        /**
+         * @brief May the components of the type update in parallel with each other?
+         *
+         * @return true If each component only touches its own actor.
+         */
+        inline bool isPerActor() const { return per_actor_; }
+
+    private:
+
+        /**
+         * @brief Returns the id of a data name, assigning a new one on first use.
+         *
+         * @param data The name of the data.
+         * @return uint32_t The id of the data.
+         */
+        static uint32_t dataId(const string& data);
+
+        /**
+         * @brief Adds an id to a sorted list of ids.
+         *
+         * @param ids The list.
+         * @param id The id to add.
+         */
+        static void insert(std::vector<uint32_t>& ids, uint32_t id);
+
+        /**
+         * @brief Do two sorted lists of ids share an id?
+         *
+         * @param a The first list.
+         * @param b The second list.
+         * @return true If an id is in both lists.
+         */
+        static bool intersects(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b);
+
+        /** The name of the component type. */
+        string name_;
+        /** The ids of the data read, sorted. */
+        std::vector<uint32_t> reads_;
+        /** The ids of the data written, sorted. */
+        std::vector<uint32_t> writes_;
+        /** Has any data been declared? */
+        bool declared_ = false;
+        /** May the components update in parallel with each other? */
+        bool per_actor_ = false;
+
+    };
+
+    /**
+     * @brief Calls Component::update() on the components of a set of actors, running component
+     *        types that do not conflict in parallel on the job system.
+     * @details Components are grouped by type, and each group reads its access from
+     *          Component::declareAccess() of its first component. Every tick, the groups with
+     *          components form a dependency graph: a group runs after every earlier group it
+     *          conflicts with, earlier meaning the type was seen first. As actors are walked in
+     *          the order they were added, conflicting groups always run in the same order.
+     *          Each group is timed, and the report shows the critical path: the chain of
+     *          dependent groups that sets the length of the tick.
+     *          Actors must be removed before they are destroyed.
+     */
+    class TickScheduler final {
+
+    public:
+
+        /** Constructs a new, empty Tick Scheduler. */
+        TickScheduler() = default;
+
+        TickScheduler(const TickScheduler&) = delete;
+        TickScheduler& operator=(const TickScheduler&) = delete;
+
+        /**
+         * @brief Adds an actor whose components are updated each tick.
+         *
+         * @param actor The actor to add.
+         */
+        void add(Actor& actor);
+        /**
+         * @brief Removes an actor.
+         *
+         * @param actor The actor to remove.
+         */
+        void remove(Actor& actor);
+        /**
+         * @brief Returns the number of actors.
+         *
+         * @return size_t The number of actors.
+         */
+        inline size_t actorCount() const { return actors_.size(); }
+
+        /**
+         * @brief Updates the components of every active actor that ticks, returning once all
+         *        of them are done.
+         *
+         * @param paused Is the game paused? Actors that can pause are skipped.
+         * @return size_t The number of updated components.
+         */
+        size_t tick(bool paused = false);
+
+        /**
+         * @brief Returns the number of component groups seen so far.
+         *
+         * @return size_t The number of groups.
+         */
+        inline size_t groupCount() const { return groups_.size(); }
+        /**
+         * @brief Returns the name of a group.
+         *
+         * @param group The index of the group, in the order its type was seen.
+         * @return const string& The name of the group.
+         */
+        inline const string& groupName(size_t group) const { return groups_.at(group)->access.name(); }
+        /**
+         * @brief Returns the groups a group waited for in the last tick.
+         *
+         * @param group The index of the group.
+         * @return const std::vector<size_t>& The indices of the groups it ran after.
+         */
+        inline const std::vector<size_t>& dependenciesOf(size_t group) const { return groups_.at(group)->predecessors; }
+        /**
+         * @brief Returns the update times of a group.
+         *
+         * @param group The index of the group.
+         * @return const util::Histogram& The time of each update of the group, in nanoseconds.
+         */
+        inline const util::Histogram& timesOf(size_t group) const { return groups_.at(group)->times; }
+        /**
+         * @brief Returns the length of each tick.
+         *
+         * @return const util::Histogram& The tick times in nanoseconds.
+         */
+        inline const util::Histogram& tickTimes() const { return tick_times_; }
+
+        /**
+         * @brief Returns the chain of dependent groups with the longest mean update time.
+         *
+         * @param length_ns Set to the summed mean time of the chain, in nanoseconds.
+         * @return std::vector<size_t> The indices of the groups on the path, in order.
+         */
+        std::vector<size_t> criticalPath(double* length_ns = nullptr) const;
+
+        /**
+         * @brief Writes the time of every group, its dependencies and the critical path.
+         *
+         * @param out The stream to write to.
+         */
+        void report(std::ostream& out) const;
+        /**
+         * @brief Returns the tick time and critical path as a single line of text.
+         *
+         * @return string The formatted statistics.
+         */
+        string summary() const;
+
+        /** Clears the timings, keeping the actors and groups. */
+        void resetTimings();
+
+    private:
+
+        /** The components of a single type. */
+        struct Group {
+            /** The component type. */
+            std::type_index type;
+            /** The index of the group. */
+            size_t index;
+            /** The data read and written by the type. */
+            TickAccess access;
+            /** The components to update this tick. */
+            TrackedVector<Component*, MemoryTag::SCENE> components;
+            /** The groups that ran before this one in the last tick. */
+            std::vector<size_t> predecessors;
+            /** The groups waiting for this one this tick. */
+            TrackedVector<Group*, MemoryTag::SCENE> successors;
+            /** The number of predecessors that have not finished this tick. */
+            std::atomic<size_t> remaining;
+            /** The update times of the group. */
+            util::Histogram times;
+
+            /**
+             * @brief Constructs a new Group.
+             *
+             * @param type The component type.
+             * @param index The index of the group.
+             */
+            Group(std::type_index type, size_t index) : type(type), index(index), remaining(0) {}
+        };
+
+        /**
+         * @brief Updates the components of a group, then starts every successor it was the last
+         *        predecessor of.
+         *
+         * @param group The group to update.
+         * @param counter The counter of the tick.
+         */
+        void runGroup(Group& group, jobs::Counter& counter);
+
+        /** The actors, in the order they were added. */
+        TrackedVector<Actor*, MemoryTag::SCENE> actors_;
+        /** The groups, in the order their type was seen. */
+        std::vector<std::unique_ptr<Group>> groups_;
+        /** The index of the group of each type. */
+        std::unordered_map<std::type_index, size_t> group_index_;
+        /** The groups with components this tick. */
+        TrackedVector<Group*, MemoryTag::SCENE> active_;
+        /** The length of each tick. */
+        util::Histogram tick_times_;
+
+    };
+
+    /**
+     * @brief Splits the time of each frame into fixed update steps.
+     * @details Frame time is added to an accumulator, and a step is taken for each whole update
+     *          interval in it. What is left over sets the interpolation alpha, how far the frame
+     *          is between the last step and the next, so rendering can blend the last two states.
+     *          The number of steps in a frame is limited, both by a maximum and by how many steps
+     *          of the measured cost fit in the update budget. Without the budget, steps that take
+     *          longer than the interval make each frame longer than the last, so the simulation
+     *          never catches up. Time that does not fit is dropped at the end of the frame and
+     *          counted, and the simulation runs slower than real time instead.
+     */
+    class FixedTimestep final {
+
+    public:
+
+        /** The weight of the newest step in the smoothed step cost. */
+        static const double COST_SMOOTHING;
+
+        /** Constructs a new Fixed Timestep. */
+        FixedTimestep() = default;
+
+        /**
+         * @brief Sets the simulated time of each step.
+         *
+         * @param interval_ms The update interval in milliseconds.
+         */
+        void setInterval(double interval_ms);
+        /**
+         * @brief Sets the most steps taken in a single frame.
+         *
+         * @param max_steps The maximum, at least 1.
+         */
+        void setMaxSteps(int max_steps);
+        /**
+         * @brief Sets the real time the steps of a frame may take.
+         *
+         * @param budget_ms The budget in milliseconds. 0 uses the update interval, so the steps of
+         *                  a frame never take longer than the time one of them simulates.
+         */
+        void setBudget(double budget_ms);
+
+        /**
+         * @brief Starts a frame, adding its time to the accumulator.
+         *
+         * @param delta_ms The time since the last frame, in milliseconds.
+         */
+        void advance(double delta_ms);
+        /**
+         * @brief Takes the next step of the frame, if there is one. Each step is timed until the
+         *        next call, so the update should run between calls.
+         *
+         * @return true If a step was taken and the update should run.
+         */
+        bool step();
+        /** Ends a frame, dropping the time that did not fit and updating the alpha. */
+        void endFrame();
+
+        /** Clears the accumulator and the counters, keeping the settings. */
+        void reset();
+
+        /**
+         * @brief Returns the simulated time of each step.
+         *
+         * @return double The update interval in milliseconds.
+         */
+        inline double interval() const { return interval_ms_; }
+        /**
+         * @brief Returns the time not yet simulated.
+         *
+         * @return double The accumulated time in milliseconds.
+         */
+        inline double accumulator() const { return accumulator_; }
+        /**
+         * @brief Returns how far the last frame is between the last step and the next one.
+         *
+         * @return double The interpolation alpha, from 0 to 1.
+         */
+        inline double alpha() const { return alpha_; }
+        /**
+         * @brief Returns the number of steps taken this frame.
+         *
+         * @return int The number of steps.
+         */
+        inline int stepsThisFrame() const { return frame_steps_; }
+        /**
+         * @brief Returns the most steps the current frame may take.
+         *
+         * @return int The maximum, lowered from the set maximum when steps are too slow.
+         */
+        inline int stepLimit() const { return step_limit_; }
+        /**
+         * @brief Returns the smoothed real time of a step.
+         *
+         * @return double The step cost in milliseconds.
+         */
+        inline double stepCost() const { return step_cost_ms_; }
+        /**
+         * @brief Did the last frame drop time? A game may lower the quality of its simulation
+         *        while it is behind.
+         *
+         * @return true If steps were dropped in the last frame.
+         */
+        inline bool isBehind() const { return behind_; }
+
+        /**
+         * @brief Returns the number of steps taken.
+         *
+         * @return uint64_t The number of steps.
+         */
+        inline uint64_t steps() const { return steps_; }
+        /**
+         * @brief Returns the number of steps dropped because they did not fit in their frame.
+         *
+         * @return uint64_t The number of dropped steps.
+         */
+        inline uint64_t dropped() const { return dropped_; }
+        /**
+         * @brief Returns the number of frames that dropped steps.
+         *
+         * @return uint64_t The number of frames.
+         */
+        inline uint64_t droppedFrames() const { return dropped_frames_; }
+        /**
+         * @brief Returns the number of steps of each frame.
+         *
+         * @return const util::Histogram& The steps per frame.
+         */
+        inline const util::Histogram& stepsPerFrame() const { return steps_per_frame_; }
+
+        /**
+         * @brief Returns the steps and dropped steps as a single line of text.
+         *
+         * @return string The formatted statistics.
+         */
+        string summary() const;
+
+    private:
+
+        /**
+         * @brief Adds the real time of a step to the smoothed step cost.
+         *
+         * @param cost_ns The time of the step in nanoseconds.
+         */
+        void recordCost(int64_t cost_ns);
+
+        /** The simulated time of each step. */
+        double interval_ms_ = 1000.0 / 30.0;
+        /** The most steps of a frame. */
+        int max_steps_ = 5;
+        /** The real time the steps of a frame may take, 0 for the interval. */
+        double budget_ms_ = 0.0;
+
+        /** The time not yet simulated. */
+        double accumulator_ = 0.0;
+        /** The interpolation alpha of the last frame. */
+        double alpha_ = 0.0;
+        /** The smoothed real time of a step. */
+        double step_cost_ms_ = 0.0;
+        /** The number of steps this frame. */
+        int frame_steps_ = 0;
+        /** The most steps this frame. */
+        int step_limit_ = 5;
+        /** Did the last frame drop steps? */
+        bool behind_ = false;
+        /** The time the current step started, or -1. */
+        int64_t step_start_ns_ = -1;
+
+        /** The number of steps taken. */
+        uint64_t steps_ = 0;
+        /** The number of steps dropped. */
+        uint64_t dropped_ = 0;
+        /** The number of frames that dropped steps. */
+        uint64_t dropped_frames_ = 0;
+        /** The number of steps of each frame. */
+        util::Histogram steps_per_frame_;
+
+    };
+
+}
+
+#endif
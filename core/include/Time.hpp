@@ -7,7 +7,9 @@ namespace seedengine {
 
     /**
      * @brief Controls time related data for the application.
-     * @details
+     * @details Program times are measured with a monotonic clock and kept as integer
+     *          nanoseconds, so they do not drift with rounding or jump when the system clock
+     *          is adjusted. Only the currentSys functions read the wall clock.
      */
     class Time final {
 
@@ -33,12 +35,38 @@ namespace seedengine {
         inline static bool isPaused() { return paused_; }
 
         /**
-         * @brief Returns the current delta time.
+         * @brief Returns the scaled time between the last two frames.
          * 
-         * @return float The current delta time.
+         * @return float The current delta time in seconds.
          */
         inline static float getDeltaTime() { return delta_time_; }
 
+        /**
+         * @brief Returns the time that advances the fixed updates of the frame. Pausing sets
+         *        the time scale to zero, so while paused this is the unscaled frame time, which
+         *        keeps actors that cannot pause ticking.
+         * 
+         * @return float The step time in seconds.
+         */
+        inline static float getStepTime() {
+            return paused_ ? static_cast<float>(frame_time_ns_ / 1000000000.0) : delta_time_;
+        }
+
+        /**
+         * @brief Returns the scaled delta time averaged over recent frames. Use it where a
+         *        single long frame should not cause a visible jump, such as camera motion.
+         * 
+         * @return float The smoothed delta time in seconds.
+         */
+        inline static float getSmoothedDeltaTime() { return static_cast<float>(smoothed_delta_ * time_scale_); }
+
+        /**
+         * @brief Sets how quickly the smoothed delta time follows the measured delta time.
+         * 
+         * @param weight The weight of the newest frame, from 0 to 1. 1 disables smoothing.
+         */
+        static void setDeltaSmoothing(float weight);
+
         /**
          * @brief Sets the time scale of the program.
          * 
@@ -55,21 +83,64 @@ namespace seedengine {
         inline static float getTimeScale() { return time_scale_; }
 
         /**
-         * @brief Returns the time between updates.
+         * @brief Returns the scaled time since the current frame started.
          * 
-         * @return float The current update time in milliseconds.
+         * @return float The time since the frame started in milliseconds.
          */
         static float getUpTime();
 
         /**
-         * @brief Returns the time of the last update loop.
+         * @brief Returns the time the current frame started.
+         * 
+         * @return float The frame start time in milliseconds since the program began.
+         */
+        inline static float getLastLoopTime() { return static_cast<float>(frame_start_ns_ / 1000000.0); }
+
+        /**
+         * @brief Returns the time the current frame started.
+         * 
+         * @return int64_t The frame start time in nanoseconds since the program began.
+         */
+        inline static int64_t getFrameStartNS() { return frame_start_ns_; }
+
+        /**
+         * @brief Returns the unscaled time between the last two frames.
+         * 
+         * @return int64_t The frame time in nanoseconds.
+         */
+        inline static int64_t getFrameTimeNS() { return frame_time_ns_; }
+
+        /**
+         * @brief Returns the number of frames started since the program began.
+         * 
+         * @return uint64_t The index of the current frame.
+         */
+        inline static uint64_t getFrameIndex() { return frame_index_; }
+
+        /**
+         * @brief Returns the time since the program began from the monotonic clock.
+         * 
+         * @return int64_t The time since the program began in nanoseconds.
+         */
+        static int64_t nowNS();
+
+        /**
+         * @brief Returns the time since the program began from the monotonic clock.
          * 
-         * @return float The time of the last update loop.
+         * @return int64_t The time since the program began in microseconds.
          */
-        inline static float getLastLoopTime() { return (float)(last_loop_time_.count()); }
+        static int64_t nowUS();
 
         /**
-         * @brief Returns the current system time in milliseconds.
+         * @brief Returns the time since the program began from the monotonic clock.
+         * 
+         * @return double The time since the program began in seconds.
+         */
+        static double elapsedSeconds();
+
+        /**
+         * @brief Returns the current system time in milliseconds. This is wall clock time,
+         *        which may jump when the system clock is adjusted.
          * 
          * @return std::chrono::milliseconds The current system time in milliseconds.
          */
@@ -83,7 +154,8 @@ namespace seedengine {
         static std::chrono::milliseconds elapsedTimeMS();
 
         /**
-         * @brief Returns the current system time in seconds.
+         * @brief Returns the current system time in seconds. This is wall clock time,
+         *        which may jump when the system clock is adjusted.
          * 
          * @return std::chrono::seconds The current system time in seconds.
          */
@@ -105,8 +177,19 @@ namespace seedengine {
          */
         static float msToSec(long ms);
 
+        /**
+         * @brief Starts a new frame, measuring the time since the last one. Called once per
+         *        frame by the Program class, or by anything else driving its own loop.
+         * 
+         * @see #Program
+         */
+        static void beginFrame();
+
     private:
 
+        /** The monotonic clock all program times are measured with. */
+        typedef std::chrono::steady_clock Clock;
+
         /**
          * @brief Starts the clock on the program. This should only be called
          *        by the Program class.
@@ -115,8 +198,12 @@ namespace seedengine {
          */
         static void start();
 
-        /** The time between frames in milliseconds. */
+        /** The scaled time between frames in seconds. */
         static float delta_time_;
+        /** The unscaled time between frames averaged over recent frames, in seconds. */
+        static double smoothed_delta_;
+        /** The weight of the newest frame in the smoothed delta time. */
+        static float smoothing_;
         /** Is the game paused. */
         static bool paused_;
 
@@ -125,9 +212,13 @@ namespace seedengine {
         /** The last active time scale. */
         static float last_time_scale_;
         /** The start time of the program */
-        static std::chrono::milliseconds start_time_;
-        /** The last update loop time value. */
-        static std::chrono::milliseconds last_loop_time_;
+        static Clock::time_point start_time_;
+        /** The start time of the current frame in nanoseconds since the program began. */
+        static int64_t frame_start_ns_;
+        /** The unscaled time between the last two frames in nanoseconds. */
+        static int64_t frame_time_ns_;
+        /** The number of frames started. */
+        static uint64_t frame_index_;
 
     };
 }
@@ -0,0 +1,232 @@
+#ifndef SEEDENGINE_INCLUDE_TIMER_H_
+#define SEEDENGINE_INCLUDE_TIMER_H_
+
+#include "Core.hpp"
+
+namespace seedengine {
+
+    /** A handle to a scheduled timer. 0 is never a valid timer. */
+    typedef uint64_t TimerId;
+
+    /**
+     * @brief A hierarchical timer wheel that calls functions once a number of ticks has passed.
+     * @details Timers are kept in LEVELS levels of SLOTS slots each. A timer is placed in the
+     *          level of the highest group of bits in which its deadline differs from the current
+     *          tick, and is moved down a level when the wheel reaches its slot, so every timer is
+     *          moved at most LEVELS times. Each level keeps a bit mask of its occupied slots, so
+     *          advancing jumps straight to the next occupied slot instead of visiting every tick.
+     *          Scheduling and cancelling are O(1) and take no locks, so timers must be scheduled,
+     *          cancelled and advanced on a single thread.
+     */
+    class TimerWheel final {
+
+    public:
+
+        /** The function called when a timer expires. */
+        typedef std::function<void()> Callback;
+
+        /** The number of bits of the deadline covered by each level. */
+        static const unsigned int SLOT_BITS = 6;
+        /** The number of slots in each level. */
+        static const unsigned int SLOTS = 1 << SLOT_BITS;
+        /** The number of levels, enough for delays of 2^42 ticks. */
+        static const unsigned int LEVELS = 7;
+
+        /** Constructs a new Timer Wheel at tick 0. */
+        TimerWheel();
+
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        /**
+         * @brief Schedules a function to be called once a number of ticks has passed.
+         *
+         * @param delay The number of ticks to wait. Timers always wait at least one tick.
+         * @param callback The function to call.
+         * @return TimerId The handle used to cancel the timer.
+         */
+        TimerId schedule(uint64_t delay, Callback callback);
+
+        /**
+         * @brief Cancels a timer that has not expired.
+         *
+         * @param id The handle of the timer.
+         * @return true If the timer was cancelled, false if it already expired or was cancelled.
+         */
+        bool cancel(TimerId id);
+
+        /**
+         * @brief Is a timer waiting to expire?
+         *
+         * @param id The handle of the timer.
+         * @return true If the timer has not expired or been cancelled.
+         */
+        bool active(TimerId id) const;
+
+        /**
+         * @brief Moves the wheel forward, calling every timer that expires in order of deadline.
+         *        Timers scheduled by the called functions wait at least one tick more.
+         *
+         * @param ticks The number of ticks to move forward.
+         * @return size_t The number of expired timers.
+         */
+        size_t advance(uint64_t ticks);
+
+        /** Cancels every timer. */
+        void clear();
+
+        /**
+         * @brief Returns the current tick.
+         *
+         * @return uint64_t The number of ticks since the wheel was created.
+         */
+        inline uint64_t now() const { return now_; }
+        /**
+         * @brief Returns the number of timers waiting to expire.
+         *
+         * @return size_t The number of pending timers.
+         */
+        inline size_t pending() const { return pending_; }
+
+    private:
+
+        /** Marks the end of a list of timers. */
+        static const uint32_t NONE = ~0u;
+
+        /** A scheduled timer, linked into the list of its slot. */
+        struct Node {
+            /** The tick the timer expires on. */
+            uint64_t deadline = 0;
+            /** The function to call. */
+            Callback callback;
+            /** The previous timer in the slot. */
+            uint32_t prev = NONE;
+            /** The next timer in the slot, or the next free node. */
+            uint32_t next = NONE;
+            /** The slot holding the timer, or NONE if the node is free. */
+            uint32_t slot = NONE;
+            /** Increased each time the node is freed, so old handles stop matching. */
+            uint32_t generation = 0;
+        };
+
+        /**
+         * @brief Adds a node to the slot of its deadline.
+         *
+         * @param index The index of the node.
+         */
+        void insert(uint32_t index);
+        /**
+         * @brief Removes a node from its slot.
+         *
+         * @param index The index of the node.
+         */
+        void unlink(uint32_t index);
+        /**
+         * @brief Returns a node to the free list.
+         *
+         * @param index The index of the node.
+         */
+        void release(uint32_t index);
+
+        /**
+         * @brief Finds the handle's node.
+         *
+         * @param id The handle of the timer.
+         * @return uint32_t The index of the node, or NONE if the timer is not pending.
+         */
+        uint32_t find(TimerId id) const;
+
+        /** Every timer node, scheduled or free. */
+        std::vector<Node> nodes_;
+        /** The first and last timer in each slot, level by level. */
+        std::vector<uint32_t> slots_;
+        /** The occupied slots of each level. */
+        uint64_t occupied_[LEVELS];
+        /** The first free node. */
+        uint32_t free_ = NONE;
+        /** The current tick. */
+        uint64_t now_ = 0;
+        /** The number of pending timers. */
+        size_t pending_ = 0;
+
+    };
+
+    /**
+     * @brief The engine timers, driven by the program once per frame.
+     * @details Timers scheduled in seconds follow the scaled game time, so they stop while the
+     *          game is paused, and expire with millisecond resolution. Timers scheduled in frames
+     *          count the frames run by the program. Expired timers are called at the start of a
+     *          frame, before events are run, on the dispatch thread.
+     * 
+     *          The wheels are not synchronized, so timers are only scheduled, cancelled and
+     *          advanced on the dispatch thread, which debug builds assert. Other threads, such as
+     *          job workers updating components, hand their work over with EventDispatcher::post().
+     */
+    class Timers final {
+
+    public:
+
+        /** The function called when a timer expires. */
+        typedef TimerWheel::Callback Callback;
+
+        /**
+         * @brief Calls a function once an amount of game time has passed.
+         *
+         * @param seconds The game time to wait.
+         * @param callback The function to call.
+         * @return TimerId The handle used to cancel the timer.
+         */
+        static TimerId after(float seconds, Callback callback);
+
+        /**
+         * @brief Calls a function at the start of a later frame.
+         *
+         * @param frames The number of frames to wait. 1 calls the function next frame.
+         * @param callback The function to call.
+         * @return TimerId The handle used to cancel the timer.
+         */
+        static TimerId afterFrames(unsigned int frames, Callback callback);
+
+        /**
+         * @brief Cancels a timer that has not expired.
+         *
+         * @param id The handle of the timer.
+         * @return true If the timer was cancelled.
+         */
+        static bool cancel(TimerId id);
+
+        /**
+         * @brief Starts a new frame, calling every timer that expires.
+         *
+         * @param delta_ms The scaled game time since the last frame, in milliseconds.
+         * @return size_t The number of expired timers.
+         */
+        static size_t advance(float delta_ms);
+
+        /**
+         * @brief Returns the number of timers waiting to expire.
+         *
+         * @return size_t The number of pending timers.
+         */
+        static size_t pending();
+
+        /** Cancels every timer. */
+        static void clear();
+
+    private:
+
+        /** The bit marking handles of frame timers. */
+        static const TimerId FRAME_TIMER = 1ull << 63;
+
+        /** The timers counted in milliseconds of game time. */
+        static TimerWheel time_wheel;
+        /** The timers counted in frames. */
+        static TimerWheel frame_wheel;
+        /** The game time not yet added to the time wheel, in milliseconds. */
+        static double carry_ms;
+
+    };
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define SEEDENGINE_INCLUDE_TRANSFORM_H_
 
 #include "Core.hpp"
+#include "Serial.hpp"
 
 namespace seedengine {
 
@@ -193,6 +194,17 @@ namespace seedengine {
             return glm::normalize(glm::vec3(glm::inverse(transformation_matrix_)[0]));
         }
 
+        /**
+         * @brief Blends two transforms, such as the states before and after a fixed update.
+         *        Positions and scales are blended linearly, rotations along the shortest arc.
+         * 
+         * @param from The transform at alpha 0.
+         * @param to The transform at alpha 1.
+         * @param alpha How far to blend from the first transform to the second.
+         * @return Transform The blended transform.
+         */
+        static Transform interpolate(const Transform& from, const Transform& to, float alpha);
+
         //TODO: Provide additional transform functionality such as translate, scale, rotate, etc.
         //TODO: Create operator overloads for the transform class.
         //TODO: Unit test transform class.
@@ -225,6 +237,29 @@ namespace seedengine {
 
     };
 
+    /**
+     * @brief The field description of #Transform. Only the components are stored, the
+     *        matrices are rebuilt by the setters when read.
+     */
+    template <>
+    struct Serial<Transform> {
+        ENGINE_SERIAL_BODY(1)
+        template <class V>
+        static void fields(V& v, Transform& transform) {
+            glm::vec3 position = transform.getPosition();
+            glm::quat rotation = transform.getRotation();
+            glm::vec3 scale = transform.getScale();
+            v.field(1, position);
+            v.field(1, rotation);
+            v.field(1, scale);
+            if (V::IS_READER) {
+                transform.setPosition(position);
+                transform.setRotation(rotation);
+                transform.setScale(scale);
+            }
+        }
+    };
+
 }
 
 #endif
\ No newline at end of file
@@ -19,7 +19,7 @@ namespace seedengine {
     public:
         /**
          * @brief Constructs a WindowProperties object. All parameters default to the
-         *        value found in defaults.ini.
+         *        value found in defaults.ini, including any changes reloaded at runtime.
          * 
          * @param title The title of the window.
          * @param width The width of the window.
@@ -11,8 +11,8 @@ namespace seedengine {
 
     }
 
-    Actor::Actor(const Transform& transfrom, const ActorProperties& properties)
-        : Object("Actor"), actor_properties_(properties) {
+    Actor::Actor(const Transform& transform, const ActorProperties& properties)
+        : Object("Actor"), actor_properties_(properties), previous_transform_(transform) {
         this->transform = transform;
         this->active = true;
         this->parent_ = nullptr;
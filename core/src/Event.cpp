@@ -2,48 +2,397 @@
 
 namespace seedengine {
 
-    std::queue<std::shared_ptr<Event>> EventDispatcher::event_buffer;
-    std::map<const unsigned int, std::vector<EventDispatcher::EventDeligate>> EventDispatcher::deligate_regtistry;
+    // Event Queue
 
-    void EventDispatcher::registerDeligate(const unsigned int event_id, EventDispatcher::EventDeligate deligate) {
+    EventQueue::~EventQueue() {
+        clear();
+    }
+
+    void EventQueue::destroy(size_t i) {
+        if (events_[i] == nullptr) return;
+        events_[i]->~Event();
+        events_[i] = nullptr;
+        generation_++;
+    }
 
-        // Check if event has been registered
-        if (deligate_regtistry.find(event_id) == deligate_regtistry.end()) {
-            // Register event reference if not found
-            std::vector<EventDeligate> deligates;
-            deligate_regtistry[event_id] = deligates;
+    void EventQueue::compact() {
+        events_.erase(std::remove(events_.begin(), events_.end(), nullptr), events_.end());
+        if (events_.empty()) {
+            page_ = 0;
+            offset_ = 0;
         }
-        // Add delegate to binding list
-        deligate_regtistry[event_id].push_back(deligate);
     }
 
-    std::shared_ptr<Event> EventDispatcher::pop() {
-        auto next_event = event_buffer.front();
-        event_buffer.pop();
-        return next_event;
+    void EventQueue::clear() {
+        for (size_t i = 0; i < events_.size(); i++) destroy(i);
+        compact();
     }
 
-    void EventDispatcher::run(unsigned int type_filter) {
+    void* EventQueue::allocate(size_t size, size_t align) {
+        size_t offset = (offset_ + align - 1) & ~(align - 1);
+        if (page_ < pages_.size() && offset + size > PAGE_SIZE) {
+            // Move on to the next page
+            page_++;
+            offset = 0;
+        }
+        if (page_ == pages_.size()) {
+            void* page = MemoryTracker::allocate(PAGE_SIZE, MemoryTag::EVENTS);
+            if (page == nullptr) throw std::bad_alloc();
+            pages_.push_back(std::unique_ptr<unsigned char[], TrackedDeleter>(static_cast<unsigned char*>(page)));
+            offset = 0;
+        }
+        offset_ = offset + size;
+        return pages_[page_].get() + offset;
+    }
 
-        int q_size = (int)event_buffer.size();
-        int buffer_count = 0;
-
-        // Iterate through each event in the queue once, passing filtered out events to back of queue
-        while (buffer_count < q_size) {
-            auto next = pop();
-            if (next->isType(static_cast<EventType>(type_filter))) {
-                // Iterate through all delegates bound to this event
-                for (EventDeligate deligate : deligate_regtistry[next->getId()])
-                {
-                    // Call the function
-                    deligate(*next);
+    // Event Channel
+
+    EventChannel::EventChannel() : cells_(new Cell[CAPACITY]), enqueue_pos_(0), waits_(0) {
+        for (size_t i = 0; i < CAPACITY; i++) cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    EventChannel::Cell* EventChannel::claim() {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[pos & (CAPACITY - 1)];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (difference == 0) {
+                // The cell is free for this position, try to take it
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.claimed = pos;
+                    return &cell;
                 }
             }
+            else if (difference < 0) {
+                // The cell still holds an event from the previous lap
+                return nullptr;
+            }
             else {
-                // Move event to the back of the buffer
-                event_buffer.push(next);
+                // Another producer took the position
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
             }
-            buffer_count++;
+        }
+    }
+
+    size_t EventChannel::drain() {
+        size_t count = 0;
+        while (true) {
+            Cell& cell = cells_[dequeue_pos_ & (CAPACITY - 1)];
+            if (cell.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) break;
+            cell.consume(cell.storage);
+            // Free the cell for the next lap
+            cell.sequence.store(dequeue_pos_ + CAPACITY, std::memory_order_release);
+            dequeue_pos_++;
+            count++;
+        }
+        return count;
+    }
+
+    // Event Subscription
+
+    void EventSubscription::reset() {
+        if (token_ == 0) return;
+        EventDispatcher::unbind(event_id_, token_);
+        token_ = 0;
+    }
+
+    // Dispatch Profiler
+
+    std::vector<std::unique_ptr<DispatchProfiler::Entry>> DispatchProfiler::events;
+    std::unordered_map<uint64_t, DispatchProfiler::Entry> DispatchProfiler::subscribers;
+    uint64_t DispatchProfiler::budget_ns = 0;
+    uint64_t DispatchProfiler::slow_calls = 0;
+
+    void DispatchProfiler::record(unsigned int event_id, uint64_t token, uint64_t nanoseconds) {
+        if (event_id >= events.size()) events.resize(event_id + 1);
+        if (!events[event_id]) events[event_id].reset(new Entry());
+        Entry& event = *events[event_id];
+        event.times.record(nanoseconds);
+        if (token != 0) subscribers[token].times.record(nanoseconds);
+        if (budget_ns == 0 || nanoseconds <= budget_ns) return;
+        event.slow_calls++;
+        slow_calls++;
+        if (token == 0) return;
+        Entry& subscriber = subscribers[token];
+        if (subscriber.slow_calls++ == 0) {
+            ENGINE_WARN("Deligate {0} of event {1} took {2} us, over the {3} us dispatch budget.",
+                subscriber.name.empty() ? std::to_string(token) : subscriber.name, event_id,
+                nanoseconds / 1000, budget_ns / 1000);
+        }
+    }
+
+    void DispatchProfiler::setBudget(uint64_t nanoseconds) {
+        budget_ns = nanoseconds;
+    }
+
+    uint64_t DispatchProfiler::budget() {
+        return budget_ns;
+    }
+
+    void DispatchProfiler::name(uint64_t token, const string& name) {
+        subscribers[token].name = name;
+    }
+
+    void DispatchProfiler::forget(uint64_t token) {
+        subscribers.erase(token);
+    }
+
+    const DispatchProfiler::Entry* DispatchProfiler::event(unsigned int event_id) {
+        if (event_id >= events.size() || !events[event_id]) return nullptr;
+        return events[event_id].get();
+    }
+
+    const DispatchProfiler::Entry* DispatchProfiler::subscriber(uint64_t token) {
+        auto it = subscribers.find(token);
+        if (it == subscribers.end() || it->second.times.count() == 0) return nullptr;
+        return &it->second;
+    }
+
+    uint64_t DispatchProfiler::slowCalls() {
+        return slow_calls;
+    }
+
+    void DispatchProfiler::report(std::ostream& out) {
+        auto row = [&out](const string& label, const Entry& entry) {
+            const util::Histogram& times = entry.times;
+            out << label << "\t" << times.count()
+                << "\t" << times.percentile(0.5) / 1000.0
+                << "\t" << times.percentile(0.99) / 1000.0
+                << "\t" << times.max() / 1000.0
+                << "\t" << entry.slow_calls << "\n";
+        };
+        out << "Event dispatch profile, budget " << budget_ns / 1000.0 << " us, " << slow_calls << " slow calls\n";
+        out << "\nevent\tcalls\tp50 us\tp99 us\tmax us\tslow\n";
+        for (size_t i = 0; i < events.size(); i++) {
+            if (events[i] && events[i]->times.count() > 0) row(std::to_string(i), *events[i]);
+        }
+
+        // Subscribers are listed from the slowest worst case down
+        std::vector<std::pair<uint64_t, const Entry*>> sorted;
+        for (const auto& subscriber : subscribers) {
+            if (subscriber.second.times.count() > 0) sorted.push_back(std::make_pair(subscriber.first, &subscriber.second));
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const std::pair<uint64_t, const Entry*>& a, const std::pair<uint64_t, const Entry*>& b) {
+            return a.second->times.max() > b.second->times.max();
+        });
+        out << "\nsubscriber\tcalls\tp50 us\tp99 us\tmax us\tslow\n";
+        for (const auto& subscriber : sorted) {
+            row(subscriber.second->name.empty() ? "#" + std::to_string(subscriber.first) : subscriber.second->name, *subscriber.second);
+        }
+    }
+
+    bool DispatchProfiler::report(const string& path) {
+        std::ofstream file(path);
+        if (!file.is_open()) {
+            ENGINE_WARN("Could not write the dispatch profile to {0}.", path);
+            return false;
+        }
+        report(file);
+        return file.good();
+    }
+
+    void DispatchProfiler::clear() {
+        events.clear();
+        for (auto& subscriber : subscribers) {
+            subscriber.second.times.clear();
+            subscriber.second.slow_calls = 0;
+        }
+        slow_calls = 0;
+    }
+
+    // Event Dispatcher
+
+    std::vector<EventDispatcher::TypeBuffer> EventDispatcher::event_buffers;
+    EventChannel EventDispatcher::event_channel;
+    std::atomic<std::thread::id> EventDispatcher::dispatch_thread(std::this_thread::get_id());
+    size_t EventDispatcher::coalesced_events = 0;
+    EventDeligate EventDispatcher::event_observer;
+    std::vector<std::unique_ptr<EventDispatcher::DeligateList>> EventDispatcher::deligate_table;
+    std::vector<EventDispatcher::PendingDeligate> EventDispatcher::pending_deligates;
+    unsigned int EventDispatcher::dispatch_depth = 0;
+    bool EventDispatcher::deligates_unbound = false;
+    uint64_t EventDispatcher::next_token = 1;
+
+    void EventDispatcher::registerDeligate(const unsigned int event_id, EventDispatcher::EventDeligate deligate, const string& name) {
+        uint64_t token = bind(event_id, std::move(deligate));
+        #if ENGINE_PROFILE_DISPATCH
+            if (!name.empty()) DispatchProfiler::name(token, name);
+        #endif
+    }
+
+    EventSubscription EventDispatcher::subscribe(const unsigned int event_id, EventDeligate deligate, const string& name) {
+        uint64_t token = bind(event_id, std::move(deligate));
+        #if ENGINE_PROFILE_DISPATCH
+            if (!name.empty()) DispatchProfiler::name(token, name);
+        #endif
+        return EventSubscription(event_id, token);
+    }
+
+    size_t EventDispatcher::deligateCount(const unsigned int event_id) {
+        size_t count = 0;
+        if (event_id < deligate_table.size() && deligate_table[event_id]) {
+            for (const DeligateSlot& slot : *deligate_table[event_id]) {
+                if (slot.token != 0) count++;
+            }
+        }
+        for (const PendingDeligate& pending : pending_deligates) {
+            if (pending.event_id == event_id && pending.slot.token != 0) count++;
+        }
+        return count;
+    }
+
+    uint64_t EventDispatcher::bind(const unsigned int event_id, EventDeligate&& deligate) {
+        uint64_t token = next_token++;
+        if (dispatch_depth > 0) {
+            // The table may be in use, so the binding waits for dispatch to return
+            PendingDeligate pending;
+            pending.event_id = event_id;
+            pending.slot.token = token;
+            pending.slot.deligate = std::move(deligate);
+            pending_deligates.push_back(std::move(pending));
+            return token;
+        }
+        DeligateSlot slot;
+        slot.token = token;
+        slot.deligate = std::move(deligate);
+        deligatesFor(event_id).push_back(std::move(slot));
+        return token;
+    }
+
+    void EventDispatcher::unbind(const unsigned int event_id, uint64_t token) {
+        #if ENGINE_PROFILE_DISPATCH
+            DispatchProfiler::forget(token);
+        #endif
+        for (PendingDeligate& pending : pending_deligates) {
+            if (pending.slot.token == token) pending.slot.token = 0;
+        }
+        if (event_id >= deligate_table.size() || !deligate_table[event_id]) return;
+        DeligateList& slots = *deligate_table[event_id];
+        for (size_t i = 0; i < slots.size(); i++) {
+            if (slots[i].token != token) continue;
+            if (dispatch_depth > 0) {
+                // The deligate may be running, so it is only marked until dispatch returns
+                slots[i].token = 0;
+                deligates_unbound = true;
+            }
+            else slots.erase(slots.begin() + i);
+            return;
+        }
+    }
+
+    void EventDispatcher::settleDeligates() {
+        if (deligates_unbound) {
+            for (std::unique_ptr<DeligateList>& slots : deligate_table) {
+                if (!slots) continue;
+                slots->erase(std::remove_if(slots->begin(), slots->end(),
+                    [](const DeligateSlot& slot) { return slot.token == 0; }), slots->end());
+            }
+            deligates_unbound = false;
+        }
+        for (PendingDeligate& pending : pending_deligates) {
+            if (pending.slot.token == 0) continue;
+            deligatesFor(pending.event_id).push_back(std::move(pending.slot));
+        }
+        pending_deligates.clear();
+    }
+
+    void EventDispatcher::notify(Event& e) {
+        unsigned int event_id = e.getId();
+        if (event_id >= deligate_table.size() || !deligate_table[event_id]) return;
+        notify(event_id, *deligate_table[event_id], e);
+    }
+
+    EventDispatcher::DeligateList& EventDispatcher::deligatesFor(const unsigned int event_id) {
+        if (event_id >= deligate_table.size()) deligate_table.resize(event_id + 1);
+        if (!deligate_table[event_id]) deligate_table[event_id].reset(new DeligateList());
+        return *deligate_table[event_id];
+    }
+
+    EventQueue& EventDispatcher::bufferFor(unsigned int type) {
+        for (TypeBuffer& buffer : event_buffers) {
+            if (buffer.type == type) return *buffer.events;
+        }
+        TypeBuffer buffer;
+        buffer.type = type;
+        buffer.events.reset(new EventQueue());
+        buffer.run_size = 0;
+        event_buffers.push_back(std::move(buffer));
+        return *event_buffers.back().events;
+    }
+
+    void EventDispatcher::setDispatchThread() {
+        setDispatchThread(std::this_thread::get_id());
+    }
+
+    void EventDispatcher::setDispatchThread(std::thread::id id) {
+        dispatch_thread.store(id, std::memory_order_release);
+    }
+
+    void EventDispatcher::post(std::function<void()> function) {
+        if (isDispatchThread()) {
+            function();
+            return;
+        }
+        event_channel.emplace<PostedCall>(&EventDispatcher::call, PostedCall { std::move(function) });
+    }
+
+    void EventDispatcher::call(void* storage) {
+        PostedCall* posted = static_cast<PostedCall*>(storage);
+        PostedCall call = std::move(*posted);
+        posted->~PostedCall();
+        call.function();
+    }
+
+    size_t EventDispatcher::backpressure() {
+        return event_channel.waits();
+    }
+
+    size_t EventDispatcher::coalesced() {
+        return coalesced_events;
+    }
+
+    void EventDispatcher::setObserver(EventDeligate observer) {
+        event_observer = std::move(observer);
+    }
+
+    size_t EventDispatcher::pending(unsigned int type_filter) {
+        size_t count = 0;
+        for (const TypeBuffer& buffer : event_buffers) {
+            if ((buffer.type & type_filter) == type_filter) count += buffer.events->size();
+        }
+        return count;
+    }
+
+    void EventDispatcher::run(unsigned int type_filter) {
+        ENGINE_PROFILE_SCOPE("EventDispatcher::run");
+
+        // Collect the events pushed from other threads
+        event_channel.drain();
+
+        // Only the events queued before this call are run, events pushed by deligates wait for the next run
+        for (TypeBuffer& buffer : event_buffers) {
+            buffer.run_size = ((buffer.type & type_filter) == type_filter) ? buffer.events->size() : 0;
+        }
+
+        // Buffers may be created by deligates, so they are accessed by index
+        for (size_t b = 0; b < event_buffers.size(); b++) {
+            size_t q_size = event_buffers[b].run_size;
+            if (q_size == 0) continue;
+            EventQueue& events = *event_buffers[b].events;
+
+            // Events pushed by the deligates are new events, rather than combined into the ones being run
+            events.seal();
+
+            // Run each event of the type in order
+            for (size_t i = 0; i < q_size; i++) {
+                if (event_observer) event_observer(*events.at(i));
+                notify(*events.at(i));
+                events.destroy(i);
+            }
+
+            // Release the run events in bulk
+            events.compact();
         }
     }
 
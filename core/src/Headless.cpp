@@ -0,0 +1,72 @@
+#include "Headless.hpp"
+
+namespace seedengine {
+
+    /** The FNV-1a offset basis. */
+    static const uint64_t FNV_OFFSET = 14695981039346656037ull;
+    /** The FNV-1a prime. */
+    static const uint64_t FNV_PRIME = 1099511628211ull;
+
+    /**
+     * @brief Adds bytes to an FNV-1a hash.
+     *
+     * @param hash The hash to update.
+     * @param data The bytes to add.
+     * @param size The number of bytes.
+     */
+    static void hashBytes(uint64_t& hash, const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= FNV_PRIME;
+        }
+    }
+
+    HeadlessRenderer::HeadlessRenderer() : checksum_(FNV_OFFSET) {
+
+    }
+
+    HeadlessRenderer::~HeadlessRenderer() {
+        stop();
+    }
+
+    bool HeadlessRenderer::record(const string& path) {
+        stop();
+        file_.open(path, std::ios::out | std::ios::trunc);
+        if (!file_.is_open()) {
+            ENGINE_WARN("Could not open headless frame record {0}.", path);
+            return false;
+        }
+        file_ << "frame,draws,hash" << std::endl;
+        return true;
+    }
+
+    void HeadlessRenderer::stop() {
+        if (file_.is_open()) file_.close();
+    }
+
+    void HeadlessRenderer::render(const RenderSnapshot& snapshot) {
+        uint64_t frame_hash = hash(snapshot);
+        draw_counts_.record(snapshot.drawCount());
+        hashBytes(checksum_, &frame_hash, sizeof(frame_hash));
+        if (file_.is_open()) {
+            file_ << snapshot.frame() << "," << snapshot.drawCount() << "," << std::hex << frame_hash << std::dec << "\n";
+        }
+    }
+
+    uint64_t HeadlessRenderer::hash(const RenderSnapshot& snapshot) {
+        uint64_t hash = FNV_OFFSET;
+        hashBytes(hash, &snapshot.view()[0][0], sizeof(glm::mat4));
+        hashBytes(hash, &snapshot.projection()[0][0], sizeof(glm::mat4));
+        for (const DrawItem& item : snapshot.draws()) hashBytes(hash, &item.model[0][0], sizeof(glm::mat4));
+        return hash;
+    }
+
+    string HeadlessRenderer::summary() const {
+        std::ostringstream out;
+        out << draw_counts_.count() << " frames, " << draw_counts_.total() << " draws, max "
+            << draw_counts_.max() << " per frame, checksum " << std::hex << checksum_;
+        return out.str();
+    }
+
+}
@@ -2,6 +2,10 @@
 
 #ifndef STB_IMAGE_IMPLEMENTATION
     #define STB_IMAGE_IMPLEMENTATION
+    // Count decoded pixels against images
+    #define STBI_MALLOC(size) seedengine::MemoryTracker::allocate(size, seedengine::MemoryTag::IMAGE)
+    #define STBI_REALLOC(memory, size) seedengine::MemoryTracker::reallocate(memory, size, seedengine::MemoryTag::IMAGE)
+    #define STBI_FREE(memory) seedengine::MemoryTracker::deallocate(memory)
     #include <stb_image.h>
 #endif
 
@@ -23,19 +27,53 @@ namespace seedengine {
 
     #endif
 
+    size_t Image::residentBytes() const {
+        return (data_ == nullptr) ? 0 : (size_t)width_ * height_ * channels_;
+    }
+
     void Image::load() {
-        int width, height, channels;
-        delete data_;
-        data_ = stbi_load(path_.c_str(), &width, &height, &channels, format_);
+        load(std::vector<char>());
+    }
 
-        width_ = width;
-        height_ = height;
-        channels_ = (format_ == 0) ? channels : format_;
+    void Image::load(const std::vector<char>& bytes) {
+        if (!read(bytes)) {
+            ENGINE_ERROR("Failed to load image '{0}'.", path_);
+            return;
+        }
+        full_bytes_ = residentBytes();
+        loaded_ = true;
+        complete_ = true;
     }
 
     void Image::unload() {
-        delete data_;
+        stbi_image_free(data_);
+        data_ = nullptr;
+        loaded_ = false;
+        complete_ = false;
+    }
+
+    void Image::reload() {
+        complete_ = read();
+    }
+
+    void Image::release() {
+        stbi_image_free(data_);
         data_ = nullptr;
+        complete_ = false;
+    }
+
+    bool Image::read(const std::vector<char>& bytes) {
+        int width, height, channels;
+        stbi_image_free(data_);
+        if (bytes.empty()) data_ = stbi_load(path_.c_str(), &width, &height, &channels, format_);
+        else data_ = stbi_load_from_memory(reinterpret_cast<const unsigned char*>(bytes.data()), static_cast<int>(bytes.size()),
+            &width, &height, &channels, format_);
+        if (data_ == nullptr) return false;
+
+        width_ = width;
+        height_ = height;
+        channels_ = (format_ == 0) ? channels : format_;
+        return true;
     }
 
 }
\ No newline at end of file
@@ -0,0 +1,408 @@
+#include "Jobs.hpp"
+#include "Profile.hpp"
+
+#include <condition_variable>
+
+namespace seedengine {
+
+    namespace jobs {
+
+        // Work Queue
+
+        const size_t WorkQueue::INITIAL_CAPACITY;
+
+        WorkQueue::Ring::Ring(size_t capacity)
+            : slots(new std::atomic<Job*>[capacity]), mask(static_cast<int64_t>(capacity) - 1) {
+            for (size_t i = 0; i < capacity; i++) slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+
+        WorkQueue::WorkQueue() : top_(0), bottom_(0), ring_(nullptr) {
+            rings_.emplace_back(new Ring(INITIAL_CAPACITY));
+            ring_.store(rings_.back().get(), std::memory_order_relaxed);
+        }
+
+        WorkQueue::~WorkQueue() {}
+
+        void WorkQueue::push(Job* job) {
+            int64_t bottom = bottom_.load(std::memory_order_relaxed);
+            int64_t top = top_.load(std::memory_order_acquire);
+            Ring* ring = ring_.load(std::memory_order_relaxed);
+
+            if (bottom - top > ring->mask) {
+                // Full, so copy the queued jobs into a ring twice the size
+                Ring* grown = new Ring(static_cast<size_t>(ring->mask + 1) * 2);
+                for (int64_t i = top; i < bottom; i++) grown->put(i, ring->get(i));
+                rings_.emplace_back(grown);
+                ring_.store(grown, std::memory_order_release);
+                ring = grown;
+            }
+
+            ring->put(bottom, job);
+            // Thieves that see the new bottom must also see the job
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        Job* WorkQueue::pop() {
+            int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+            Ring* ring = ring_.load(std::memory_order_relaxed);
+            bottom_.store(bottom, std::memory_order_relaxed);
+            // Thieves must see the reserved bottom before the top is read
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t top = top_.load(std::memory_order_relaxed);
+
+            if (top > bottom) {
+                // Empty
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            Job* job = ring->get(bottom);
+            if (top == bottom) {
+                // The last job, which a thief may be taking at the same time
+                if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    job = nullptr;
+                }
+                bottom_.store(bottom + 1, std::memory_order_relaxed);
+            }
+            return job;
+        }
+
+        Job* WorkQueue::steal() {
+            int64_t top = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t bottom = bottom_.load(std::memory_order_acquire);
+            if (top >= bottom) return nullptr;
+
+            Ring* ring = ring_.load(std::memory_order_acquire);
+            Job* job = ring->get(top);
+            // Another thief or the owner took the job first
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return job;
+        }
+
+        size_t WorkQueue::size() const {
+            int64_t bottom = bottom_.load(std::memory_order_relaxed);
+            int64_t top = top_.load(std::memory_order_relaxed);
+            return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+        }
+
+        // Scheduler
+
+        /** The index of the queue owned by this thread, or -1 if it owns none. */
+        static thread_local int queue_index = -1;
+        /** The state of the random victim choice of this thread. */
+        static thread_local uint32_t steal_seed = 0;
+
+        /** The worker threads and queues behind the functions of the job system. */
+        class Scheduler final {
+
+        public:
+
+            /** @copydoc jobs::start() */
+            static void start(unsigned int workers) {
+                if (running_.load()) {
+                    ENGINE_WARN("The job system is already running.");
+                    return;
+                }
+                if (workers == 0) {
+                    unsigned int cores = std::thread::hardware_concurrency();
+                    workers = cores > 1 ? cores - 1 : 0;
+                }
+
+                // Queue 0 belongs to the calling thread, the rest to the workers
+                queues_.clear();
+                for (unsigned int i = 0; i <= workers; i++) queues_.emplace_back(new WorkQueue());
+                queue_index = 0;
+                stopping_.store(false);
+                executed_.store(0);
+                stolen_.store(0);
+                running_.store(true);
+
+                for (unsigned int i = 1; i <= workers; i++) threads_.emplace_back(&Scheduler::workerLoop, i);
+            }
+
+            /** @copydoc jobs::stop() */
+            static void stop() {
+                if (!running_.load()) return;
+
+                {
+                    std::lock_guard<std::mutex> guard(sleep_mu_);
+                    stopping_.store(true);
+                    wake_.notify_all();
+                }
+                for (std::thread& thread : threads_) thread.join();
+                threads_.clear();
+
+                // Run whatever the workers left behind, including jobs those jobs queue
+                while (Job* job = find(0)) execute(job);
+
+                running_.store(false);
+                queue_index = -1;
+                queues_.clear();
+            }
+
+            /**
+             * @brief Queues a job on the queue of the calling thread, or the shared queue.
+             *
+             * @param function The function to run.
+             * @param counter The counter of the job's group, or nullptr.
+             */
+            static void submit(Function function, Counter* counter) {
+                if (!running_.load(std::memory_order_acquire)) {
+                    function();
+                    return;
+                }
+
+                if (counter != nullptr) counter->pending_.fetch_add(1, std::memory_order_relaxed);
+                Job* job = new Job{ std::move(function), counter };
+                queued_.fetch_add(1);
+                if (queue_index >= 0) queues_[queue_index]->push(job);
+                else {
+                    std::lock_guard<std::mutex> guard(shared_mu_);
+                    shared_.push(job);
+                }
+
+                // A sleeping worker either sees the new job or is woken here
+                if (sleepers_.load() > 0) {
+                    std::lock_guard<std::mutex> guard(sleep_mu_);
+                    wake_.notify_one();
+                }
+            }
+
+            /** @copydoc jobs::help() */
+            static bool help() {
+                if (!running_.load(std::memory_order_acquire)) return false;
+                Job* job = find(queue_index);
+                if (job == nullptr) return false;
+                execute(job);
+                return true;
+            }
+
+            /**
+             * @brief Processes a range, handing halves of it to other threads while they are idle.
+             *
+             * @param begin The first index.
+             * @param end One past the last index.
+             * @param grain The smallest range split off as a job.
+             * @param body Processes part of the range.
+             * @param counter The counter of the jobs split off.
+             */
+            static void split(size_t begin, size_t end, size_t grain, const RangeFunction& body, Counter& counter) {
+                while (end - begin > grain) {
+                    // Only split while the last half has been taken, so idle threads set the job count
+                    if (queue_index < 0 || queues_[queue_index]->size() == 0) {
+                        size_t middle = begin + (end - begin) / 2;
+                        submit([middle, end, grain, &body, &counter]() { split(middle, end, grain, body, counter); }, &counter);
+                        end = middle;
+                    }
+                    else {
+                        body(begin, begin + grain);
+                        begin += grain;
+                    }
+                }
+                body(begin, end);
+            }
+
+            /** @copydoc jobs::workerCount() */
+            static unsigned int workerCount() { return static_cast<unsigned int>(threads_.size()); }
+
+            /** Is the job system running? */
+            static std::atomic<bool> running_;
+            /** The number of jobs run. */
+            static std::atomic<uint64_t> executed_;
+            /** The number of jobs stolen from another queue. */
+            static std::atomic<uint64_t> stolen_;
+
+        private:
+
+            /** The number of times an idle worker yields before going to sleep. */
+            static const unsigned int SPIN_ROUNDS = 64;
+
+            /**
+             * @brief Runs jobs until the job system stops. The body of each worker thread.
+             *
+             * @param index The index of the worker's queue.
+             */
+            static void workerLoop(unsigned int index) {
+                queue_index = static_cast<int>(index);
+                steal_seed = index * 2654435761u;
+                Profiler::setThreadName("Job Worker " + std::to_string(index));
+                unsigned int idle = 0;
+
+                while (!stopping_.load(std::memory_order_acquire)) {
+                    if (Job* job = find(queue_index)) {
+                        execute(job);
+                        idle = 0;
+                        continue;
+                    }
+                    if (++idle < SPIN_ROUNDS) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+
+                    // Nothing to steal for a while, so sleep until a job is queued
+                    std::unique_lock<std::mutex> lock(sleep_mu_);
+                    sleepers_.fetch_add(1);
+                    wake_.wait(lock, []() { return stopping_.load() || queued_.load() > 0; });
+                    sleepers_.fetch_sub(1);
+                    idle = 0;
+                }
+
+                queue_index = -1;
+            }
+
+            /**
+             * @brief Takes a job from the thread's own queue, the shared queue or another thread.
+             *
+             * @param index The index of the thread's queue, or -1.
+             * @return Job* The job, or nullptr if none was found.
+             */
+            static Job* find(int index) {
+                // Newest local work first, as its data is likely still in cache
+                if (index >= 0) {
+                    if (Job* job = queues_[index]->pop()) return job;
+                }
+
+                if (queued_.load(std::memory_order_relaxed) == 0) return nullptr;
+
+                {
+                    std::lock_guard<std::mutex> guard(shared_mu_);
+                    if (!shared_.empty()) {
+                        Job* job = shared_.front();
+                        shared_.pop();
+                        return job;
+                    }
+                }
+
+                // Steal the oldest job of another thread, starting from a random victim
+                steal_seed = steal_seed * 1664525u + 1013904223u;
+                size_t count = queues_.size();
+                size_t first = (steal_seed >> 16) % count;
+                for (size_t i = 0; i < count; i++) {
+                    size_t victim = (first + i) % count;
+                    if (static_cast<int>(victim) == index) continue;
+                    if (Job* job = queues_[victim]->steal()) {
+                        stolen_.fetch_add(1, std::memory_order_relaxed);
+                        return job;
+                    }
+                }
+                return nullptr;
+            }
+
+            /**
+             * @brief Runs and frees a job, then counts it as finished.
+             *
+             * @param job The job to run.
+             */
+            static void execute(Job* job) {
+                queued_.fetch_sub(1);
+                try {
+                    job->function();
+                }
+                catch (std::exception& e) {
+                    ENGINE_ERROR("Job failed: {0}", e.what());
+                }
+                if (job->counter != nullptr) job->counter->pending_.fetch_sub(1, std::memory_order_release);
+                delete job;
+                executed_.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            /** The queue of each thread, starting with the owning thread. */
+            static std::vector<std::unique_ptr<WorkQueue>> queues_;
+            /** The worker threads. */
+            static std::vector<std::thread> threads_;
+            /** Jobs queued by threads without a queue of their own. */
+            static std::queue<Job*> shared_;
+            /** Guards the shared queue. */
+            static std::mutex shared_mu_;
+            /** The number of queued jobs that have not been taken. */
+            static std::atomic<size_t> queued_;
+            /** Guards sleeping. */
+            static std::mutex sleep_mu_;
+            /** Signalled when a job is queued or the workers should stop. */
+            static std::condition_variable wake_;
+            /** The number of sleeping workers. */
+            static std::atomic<unsigned int> sleepers_;
+            /** Should the workers stop? */
+            static std::atomic<bool> stopping_;
+
+        };
+
+        const unsigned int Scheduler::SPIN_ROUNDS;
+        std::atomic<bool> Scheduler::running_(false);
+        std::atomic<uint64_t> Scheduler::executed_(0);
+        std::atomic<uint64_t> Scheduler::stolen_(0);
+        std::vector<std::unique_ptr<WorkQueue>> Scheduler::queues_;
+        std::vector<std::thread> Scheduler::threads_;
+        std::queue<Job*> Scheduler::shared_;
+        std::mutex Scheduler::shared_mu_;
+        std::atomic<size_t> Scheduler::queued_(0);
+        std::mutex Scheduler::sleep_mu_;
+        std::condition_variable Scheduler::wake_;
+        std::atomic<unsigned int> Scheduler::sleepers_(0);
+        std::atomic<bool> Scheduler::stopping_(false);
+
+        // Job System
+
+        void start(unsigned int workers) {
+            Scheduler::start(workers);
+        }
+
+        void stop() {
+            Scheduler::stop();
+        }
+
+        bool running() {
+            return Scheduler::running_.load();
+        }
+
+        unsigned int workerCount() {
+            return Scheduler::workerCount();
+        }
+
+        void run(Function function) {
+            Scheduler::submit(std::move(function), nullptr);
+        }
+
+        void run(Function function, Counter& counter) {
+            Scheduler::submit(std::move(function), &counter);
+        }
+
+        void wait(Counter& counter) {
+            while (!counter.done()) {
+                if (!Scheduler::help()) std::this_thread::yield();
+            }
+        }
+
+        bool help() {
+            return Scheduler::help();
+        }
+
+        void parallelFor(size_t begin, size_t end, const RangeFunction& body, size_t grain) {
+            if (end <= begin) return;
+            size_t count = end - begin;
+            if (grain == 0) grain = std::max<size_t>(1, count / (8 * (workerCount() + 1)));
+            if (!running() || count <= grain) {
+                body(begin, end);
+                return;
+            }
+
+            Counter counter;
+            Scheduler::split(begin, end, grain, body, counter);
+            wait(counter);
+        }
+
+        uint64_t executed() {
+            return Scheduler::executed_.load();
+        }
+
+        uint64_t stolen() {
+            return Scheduler::stolen_.load();
+        }
+
+    }
+
+}
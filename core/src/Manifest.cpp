@@ -0,0 +1,236 @@
+#include "Manifest.hpp"
+
+#ifndef _WIN32
+    #include <dirent.h>
+    #include <sys/stat.h>
+#endif
+
+namespace seedengine {
+
+    std::mutex AssetManifest::mu_;
+    std::unordered_map<string, AssetRecord> AssetManifest::records_;
+    std::vector<string> AssetManifest::roots_;
+    std::atomic<unsigned long> AssetManifest::probes_avoided_(0);
+
+    bool AssetManifest::load(const string& manifest_path) {
+        std::ifstream file(manifest_path);
+        if (!file) return false;
+
+        // Paths in the manifest are relative to its directory
+        size_t sep = manifest_path.find_last_of("/\\");
+        string root = (sep == string::npos) ? string("./") : manifest_path.substr(0, sep + 1);
+
+        // Read every entry before taking the lock, so lookups are not held up by the file
+        std::vector<AssetRecord> records;
+        string line;
+        int line_num = 0;
+        while (std::getline(file, line)) {
+            line_num++;
+            if (line.empty() || line[0] == '#') continue;
+
+            // Format: <size> <hash> <type> <relative path>
+            std::istringstream stream(line);
+            AssetRecord record;
+            unsigned int type = 0;
+            string relative;
+            if (stream >> record.size >> std::hex >> record.hash >> std::dec >> type >> std::ws) {
+                std::getline(stream, relative);
+            }
+            if (relative.empty()) {
+                ENGINE_WARN("Invalid entry in asset manifest '{0}' at line {1}.", manifest_path, line_num);
+                continue;
+            }
+            record.path = root + relative;
+            record.type = static_cast<AssetType>(type);
+            records.push_back(record);
+        }
+
+        std::lock_guard<std::mutex> guard(mu_);
+        for (const AssetRecord& record : records) records_[record.path] = record;
+        addRoot(root);
+        return true;
+    }
+
+    unsigned int AssetManifest::scan(const string& root) {
+        string base = root;
+        if (!base.empty() && base.back() != '/' && base.back() != '\\') base += '/';
+
+        // Walk the tree before taking the lock, so lookups are not held up by the disk
+        std::vector<AssetRecord> records;
+        std::vector<string> pending { base };
+
+        while (!pending.empty()) {
+            string dir = pending.back();
+            pending.pop_back();
+
+            #ifdef _WIN32
+
+                WIN32_FIND_DATAA entry;
+                HANDLE handle = FindFirstFileA((dir + "*").c_str(), &entry);
+                if (handle == INVALID_HANDLE_VALUE) continue;
+                do {
+                    string name = entry.cFileName;
+                    if (name == "." || name == "..") continue;
+                    if (entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+                        pending.push_back(dir + name + "/");
+                    }
+                    else {
+                        AssetRecord record;
+                        record.path = dir + name;
+                        record.size = (static_cast<uint64_t>(entry.nFileSizeHigh) << 32) | entry.nFileSizeLow;
+                        record.hash = 0;
+                        record.type = typeOf(name);
+                        records.push_back(record);
+                    }
+                } while (FindNextFileA(handle, &entry));
+                FindClose(handle);
+
+            #else
+
+                DIR* handle = opendir(dir.c_str());
+                if (handle == nullptr) continue;
+                struct dirent* entry;
+                while ((entry = readdir(handle)) != nullptr) {
+                    string name = entry->d_name;
+                    if (name == "." || name == "..") continue;
+                    struct stat info;
+                    if (fstatat(dirfd(handle), entry->d_name, &info, 0) != 0) continue;
+                    if (S_ISDIR(info.st_mode)) {
+                        pending.push_back(dir + name + "/");
+                    }
+                    else if (S_ISREG(info.st_mode)) {
+                        AssetRecord record;
+                        record.path = dir + name;
+                        record.size = static_cast<uint64_t>(info.st_size);
+                        record.hash = 0;
+                        record.type = typeOf(name);
+                        records.push_back(record);
+                    }
+                }
+                closedir(handle);
+
+            #endif
+        }
+
+        std::lock_guard<std::mutex> guard(mu_);
+        for (const AssetRecord& record : records) records_[record.path] = record;
+        addRoot(base);
+        return static_cast<unsigned int>(records.size());
+    }
+
+    bool AssetManifest::covers(const string& path) {
+        std::lock_guard<std::mutex> guard(mu_);
+        return coversLocked(path);
+    }
+
+    bool AssetManifest::coversLocked(const string& path) {
+        for (const string& root : roots_) {
+            if (path.compare(0, root.size(), root) == 0) return true;
+        }
+        return false;
+    }
+
+    bool AssetManifest::exists(const string& path) {
+        bool covered;
+        {
+            std::lock_guard<std::mutex> guard(mu_);
+            covered = coversLocked(path);
+            if (covered && records_.count(path) != 0) {
+                probes_avoided_++;
+                return true;
+            }
+        }
+
+        // Misses are rare, so they are checked on disk in case the manifest is stale
+        std::ifstream test_path(path, std::ios::in | std::ios::binary | std::ios::ate);
+        if (!test_path) return false;
+        if (covered) {
+            AssetRecord record;
+            record.path = path;
+            record.size = static_cast<uint64_t>(test_path.tellg());
+            record.hash = 0;
+            record.type = typeOf(path);
+            std::lock_guard<std::mutex> guard(mu_);
+            records_.insert(std::make_pair(path, record));
+        }
+        return true;
+    }
+
+    const AssetRecord* AssetManifest::find(const string& path) {
+        std::lock_guard<std::mutex> guard(mu_);
+        auto it = records_.find(path);
+        return (it == records_.end()) ? nullptr : &it->second;
+    }
+
+    uint64_t AssetManifest::size(const string& path) {
+        std::lock_guard<std::mutex> guard(mu_);
+        auto it = records_.find(path);
+        return (it == records_.end()) ? 0 : it->second.size;
+    }
+
+    uint64_t AssetManifest::hash(const string& path) {
+        {
+            std::lock_guard<std::mutex> guard(mu_);
+            auto it = records_.find(path);
+            if (it == records_.end()) return 0;
+            if (it->second.hash != 0) return it->second.hash;
+        }
+
+        // Hash the file without the lock, racing hashes of the same file agree
+        uint64_t hash = hashFile(path);
+        std::lock_guard<std::mutex> guard(mu_);
+        auto it = records_.find(path);
+        if (it != records_.end()) it->second.hash = hash;
+        return hash;
+    }
+
+    size_t AssetManifest::count() {
+        std::lock_guard<std::mutex> guard(mu_);
+        return records_.size();
+    }
+
+    unsigned long AssetManifest::probesAvoided() {
+        return probes_avoided_;
+    }
+
+    void AssetManifest::clear() {
+        std::lock_guard<std::mutex> guard(mu_);
+        records_.clear();
+        roots_.clear();
+        probes_avoided_ = 0;
+    }
+
+    AssetType AssetManifest::typeOf(const string& path) {
+        size_t dot = path.find_last_of('.');
+        if (dot == string::npos) return AssetType::UNKNOWN;
+        string ext = path.substr(dot + 1);
+        std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+        if (ext == "png" || ext == "jpg" || ext == "jpeg" || ext == "bmp" || ext == "tga") return AssetType::IMAGE;
+        if (ext == "mesh") return AssetType::MESH;
+        if (ext == "glsl") return AssetType::SHADER;
+        if (ext == "ini") return AssetType::CONFIG;
+        if (ext == "tmp") return AssetType::MATERIAL;
+        return AssetType::UNKNOWN;
+    }
+
+    uint64_t AssetManifest::hashFile(const string& path) {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        uint64_t hash = 14695981039346656037ULL; // FNV-1a offset basis
+        char buffer[4096];
+        while (file) {
+            file.read(buffer, sizeof(buffer));
+            std::streamsize read = file.gcount();
+            for (std::streamsize i = 0; i < read; i++) {
+                hash ^= static_cast<unsigned char>(buffer[i]);
+                hash *= 1099511628211ULL; // FNV-1a prime
+            }
+        }
+        return hash;
+    }
+
+    void AssetManifest::addRoot(const string& root) {
+        if (std::find(roots_.begin(), roots_.end(), root) == roots_.end()) roots_.push_back(root);
+    }
+
+}
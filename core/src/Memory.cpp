@@ -0,0 +1,291 @@
+#include "Core.hpp"
+#include "Memory.hpp"
+
+#include <cstdlib>
+
+namespace seedengine {
+
+    /** Written before each block from the tracker, so it can be freed without knowing its size. */
+    struct AllocationHeader {
+        /** The number of bytes after the header. */
+        size_t size;
+        /** The tag the bytes are counted against. */
+        MemoryTag tag;
+    };
+
+    /** The space before each block, keeping the block aligned for any type. */
+    static const size_t HEADER_SIZE =
+        (sizeof(AllocationHeader) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+    /** The counts of a single tag. Zero initialized, so they may be used before main(). */
+    struct TagCounters {
+        std::atomic<uint64_t> live_bytes;
+        std::atomic<uint64_t> peak_bytes;
+        std::atomic<uint64_t> live_allocations;
+        std::atomic<uint64_t> allocations;
+        std::atomic<uint64_t> frame_allocations;
+        std::atomic<uint64_t> last_frame_allocations;
+    };
+
+    /** The counts of every tag. */
+    static TagCounters counters[MemoryTracker::TAGS];
+    /** The allocations each tag may make per frame. */
+    static std::vector<uint64_t> frame_limits(MemoryTracker::TAGS, MemoryTracker::NO_LIMIT);
+    /** The number of frames that went over a limit. */
+    static uint64_t violation_count = 0;
+
+    const size_t MemoryTracker::TAGS;
+    const uint64_t MemoryTracker::NO_LIMIT;
+    thread_local MemoryTag MemoryTagScope::current_ = MemoryTag::UNTAGGED;
+
+    /**
+     * @brief Counts an allocation against a tag.
+     *
+     * @param tag The tag.
+     * @param size The number of bytes.
+     */
+    static void countAllocation(MemoryTag tag, uint64_t size) {
+        TagCounters& tag_counters = counters[static_cast<size_t>(tag)];
+        uint64_t live = tag_counters.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+        uint64_t peak = tag_counters.peak_bytes.load(std::memory_order_relaxed);
+        while (live > peak && !tag_counters.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+        tag_counters.live_allocations.fetch_add(1, std::memory_order_relaxed);
+        tag_counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        tag_counters.frame_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Counts a free against a tag.
+     *
+     * @param tag The tag.
+     * @param size The number of bytes.
+     */
+    static void countFree(MemoryTag tag, uint64_t size) {
+        TagCounters& tag_counters = counters[static_cast<size_t>(tag)];
+        tag_counters.live_bytes.fetch_sub(size, std::memory_order_relaxed);
+        tag_counters.live_allocations.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void* MemoryTracker::allocate(size_t size, MemoryTag tag) {
+        unsigned char* block = static_cast<unsigned char*>(std::malloc(HEADER_SIZE + size));
+        if (block == nullptr) return nullptr;
+        AllocationHeader* header = reinterpret_cast<AllocationHeader*>(block);
+        header->size = size;
+        header->tag = tag;
+        countAllocation(tag, size);
+        return block + HEADER_SIZE;
+    }
+
+    void* MemoryTracker::reallocate(void* memory, size_t size, MemoryTag tag) {
+        if (memory == nullptr) return allocate(size, tag);
+        unsigned char* block = static_cast<unsigned char*>(memory) - HEADER_SIZE;
+        AllocationHeader old = *reinterpret_cast<AllocationHeader*>(block);
+
+        // The old block is untouched if it cannot be resized
+        unsigned char* resized = static_cast<unsigned char*>(std::realloc(block, HEADER_SIZE + size));
+        if (resized == nullptr) return nullptr;
+        countFree(old.tag, old.size);
+        AllocationHeader* header = reinterpret_cast<AllocationHeader*>(resized);
+        header->size = size;
+        header->tag = tag;
+        countAllocation(tag, size);
+        return resized + HEADER_SIZE;
+    }
+
+    void MemoryTracker::deallocate(void* memory) {
+        if (memory == nullptr) return;
+        unsigned char* block = static_cast<unsigned char*>(memory) - HEADER_SIZE;
+        const AllocationHeader* header = reinterpret_cast<const AllocationHeader*>(block);
+        countFree(header->tag, header->size);
+        std::free(block);
+    }
+
+    bool MemoryTracker::endFrame() {
+        std::vector<std::pair<size_t, uint64_t>> over;
+        for (size_t i = 0; i < TAGS; i++) {
+            uint64_t count = counters[i].frame_allocations.exchange(0, std::memory_order_relaxed);
+            counters[i].last_frame_allocations.store(count, std::memory_order_relaxed);
+            if (count > frame_limits[i]) over.emplace_back(i, count);
+        }
+        if (over.empty()) return true;
+
+        // Logging allocates, so the warnings are taken back out of the next frame
+        violation_count++;
+        TagCounters& log_counters = counters[static_cast<size_t>(MemoryTag::LOG)];
+        uint64_t before = log_counters.frame_allocations.load(std::memory_order_relaxed);
+        for (const std::pair<size_t, uint64_t>& tag : over) {
+            ENGINE_WARN("{0} made {1} allocations in a frame, over its limit of {2}.",
+                tagName(static_cast<MemoryTag>(tag.first)), tag.second, frame_limits[tag.first]);
+        }
+        uint64_t after = log_counters.frame_allocations.load(std::memory_order_relaxed);
+        if (after > before) log_counters.frame_allocations.fetch_sub(after - before, std::memory_order_relaxed);
+        return false;
+    }
+
+    void MemoryTracker::setFrameLimit(MemoryTag tag, uint64_t limit) {
+        frame_limits[static_cast<size_t>(tag)] = limit;
+    }
+
+    void MemoryTracker::setFrameLimit(uint64_t limit) {
+        std::fill(frame_limits.begin(), frame_limits.end(), limit);
+    }
+
+    uint64_t MemoryTracker::violations() {
+        return violation_count;
+    }
+
+    MemoryUsage MemoryTracker::usage(MemoryTag tag) {
+        const TagCounters& tag_counters = counters[static_cast<size_t>(tag)];
+        MemoryUsage usage;
+        usage.live_bytes = tag_counters.live_bytes.load(std::memory_order_relaxed);
+        usage.peak_bytes = tag_counters.peak_bytes.load(std::memory_order_relaxed);
+        usage.live_allocations = tag_counters.live_allocations.load(std::memory_order_relaxed);
+        usage.allocations = tag_counters.allocations.load(std::memory_order_relaxed);
+        usage.frame_allocations = tag_counters.last_frame_allocations.load(std::memory_order_relaxed);
+        return usage;
+    }
+
+    MemoryUsage MemoryTracker::total() {
+        MemoryUsage total = MemoryUsage();
+        for (size_t i = 0; i < TAGS; i++) {
+            MemoryUsage tag = usage(static_cast<MemoryTag>(i));
+            total.live_bytes += tag.live_bytes;
+            total.peak_bytes += tag.peak_bytes;
+            total.live_allocations += tag.live_allocations;
+            total.allocations += tag.allocations;
+            total.frame_allocations += tag.frame_allocations;
+        }
+        return total;
+    }
+
+    uint64_t MemoryTracker::frameAllocations(MemoryTag tag) {
+        return counters[static_cast<size_t>(tag)].frame_allocations.load(std::memory_order_relaxed);
+    }
+
+    void MemoryTracker::resetPeaks() {
+        for (TagCounters& tag_counters : counters) {
+            tag_counters.peak_bytes.store(tag_counters.live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    }
+
+    bool MemoryTracker::isHooked() {
+    #if ENGINE_TRACK_MEMORY
+        return true;
+    #else
+        return false;
+    #endif
+    }
+
+    const char* MemoryTracker::tagName(MemoryTag tag) {
+        switch (tag) {
+            case MemoryTag::UNTAGGED: return "Untagged";
+            case MemoryTag::MESH: return "Assets/Mesh";
+            case MemoryTag::IMAGE: return "Assets/Image";
+            case MemoryTag::EVENTS: return "Events";
+            case MemoryTag::SCENE: return "Scene";
+            case MemoryTag::RENDER: return "Render";
+            case MemoryTag::LOG: return "Log";
+        }
+        return "Unknown";
+    }
+
+    void MemoryTracker::report(std::ostream& out) {
+        MemoryUsage all = total();
+        out << "Memory: " << all.live_bytes << " bytes live in " << all.live_allocations << " allocations, "
+            << all.allocations << " allocations in total" << (isHooked() ? "" : ", global new not tracked") << std::endl;
+        for (size_t i = 0; i < TAGS; i++) {
+            MemoryUsage tag = usage(static_cast<MemoryTag>(i));
+            if (tag.allocations == 0) continue;
+            out << "  " << tagName(static_cast<MemoryTag>(i)) << ": " << tag.live_bytes << " bytes live in "
+                << tag.live_allocations << " allocations, peak " << tag.peak_bytes << " bytes, "
+                << tag.allocations << " allocations, " << tag.frame_allocations << " last frame";
+            if (frame_limits[i] != NO_LIMIT) out << ", limit " << frame_limits[i];
+            out << std::endl;
+        }
+        if (violation_count > 0) out << "  " << violation_count << " frames over their allocation limit" << std::endl;
+    }
+
+    string MemoryTracker::summary() {
+        std::ostringstream out;
+        bool first = true;
+        for (size_t i = 0; i < TAGS; i++) {
+            MemoryUsage tag = usage(static_cast<MemoryTag>(i));
+            if (tag.allocations == 0) continue;
+            out << (first ? "" : ", ") << tagName(static_cast<MemoryTag>(i)) << " " << tag.live_bytes
+                << " bytes live, peak " << tag.peak_bytes;
+            first = false;
+        }
+        if (first) out << "nothing tracked";
+        if (violation_count > 0) out << ", " << violation_count << " frames over their allocation limit";
+        return out.str();
+    }
+
+}
+
+#if ENGINE_TRACK_MEMORY
+
+    // Global allocations are counted against the tag of the innermost scope of the thread
+
+    /**
+     * @brief Allocates memory for operator new, calling the new handler until it succeeds.
+     *
+     * @param size The number of bytes.
+     * @return void* The memory, or nullptr if there is no new handler.
+     */
+    static void* trackedNew(size_t size) {
+        for (;;) {
+            void* memory = seedengine::MemoryTracker::allocate(size == 0 ? 1 : size, seedengine::MemoryTagScope::current());
+            if (memory != nullptr) return memory;
+            std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr) return nullptr;
+            handler();
+        }
+    }
+
+    void* operator new(size_t size) {
+        void* memory = trackedNew(size);
+        if (memory == nullptr) throw std::bad_alloc();
+        return memory;
+    }
+
+    void* operator new[](size_t size) {
+        void* memory = trackedNew(size);
+        if (memory == nullptr) throw std::bad_alloc();
+        return memory;
+    }
+
+    void* operator new(size_t size, const std::nothrow_t&) noexcept {
+        try {
+            return trackedNew(size);
+        }
+        catch (...) {
+            return nullptr;
+        }
+    }
+
+    void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+        try {
+            return trackedNew(size);
+        }
+        catch (...) {
+            return nullptr;
+        }
+    }
+
+    void operator delete(void* memory) noexcept {
+        seedengine::MemoryTracker::deallocate(memory);
+    }
+
+    void operator delete[](void* memory) noexcept {
+        seedengine::MemoryTracker::deallocate(memory);
+    }
+
+    void operator delete(void* memory, const std::nothrow_t&) noexcept {
+        seedengine::MemoryTracker::deallocate(memory);
+    }
+
+    void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+        seedengine::MemoryTracker::deallocate(memory);
+    }
+
+#endif
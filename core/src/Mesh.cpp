@@ -7,16 +7,32 @@ namespace seedengine {
     }
 
     void Mesh::load() {
+        load(std::vector<char>());
+    }
+
+    void Mesh::load(const std::vector<char>& bytes) {
 
-        // Extract mesh data from file
+        // Extract mesh data from the bytes read, or from the file
         mesh_data m_data;
-        if (!parse(path_, &m_data)) {
+        if (!parse(path_, &m_data, &bytes)) {
             ENGINE_ERROR("Failed to load mesh. Skipping load.");
             return;
         }
         delete data_;
         data_ = new mesh_data();
         *data_ = m_data;
+        loaded_ = true;
+        complete_ = true;
+        full_bytes_ = residentBytes();
+
+        // Record the data still needed once the CPU copy is released
+        index_count_ = (uint32_t)data_->indices.size();
+        for (size_t i = 0; i + 2 < data_->positions.size(); i += 3) {
+            glm::vec3 p(data_->positions[i], data_->positions[i + 1], data_->positions[i + 2]);
+            if (i == 0) bounds_min_ = bounds_max_ = p;
+            bounds_min_ = glm::vec3(std::min(bounds_min_.x, p.x), std::min(bounds_min_.y, p.y), std::min(bounds_min_.z, p.z));
+            bounds_max_ = glm::vec3(std::max(bounds_max_.x, p.x), std::max(bounds_max_.y, p.y), std::max(bounds_max_.z, p.z));
+        }
 
         // Check for OpenGL
         #if ENGINE_GRAPHICS_API == ENGINE_GRAPHICS_OPGL
@@ -45,6 +61,9 @@ namespace seedengine {
             
             //TODO: Create attribute list helper function.
 
+            // The data is now in graphics memory
+            releaseData();
+
         // Check for Vulkan
         #elif ENGINE_GRAPHICS_API == ENGINE_GRAPHICS_VLKN
 
@@ -60,9 +79,46 @@ namespace seedengine {
         #endif
     }
 
+    size_t Mesh::residentBytes() const {
+        if (data_ == nullptr) return 0;
+        return sizeof(mesh_data) +
+            sizeof(float) * (data_->positions.capacity() + data_->normals.capacity() + data_->uvs.capacity() +
+                data_->colors.capacity() + data_->bone_weights.capacity() + data_->morphs.capacity()) +
+            sizeof(uint32_t) * data_->indices.capacity();
+    }
+
+    void Mesh::reload() {
+        mesh_data m_data;
+        if (!parse(path_, &m_data)) {
+            ENGINE_ERROR("Failed to reload mesh '{0}'.", path_);
+            return;
+        }
+        if (data_ == nullptr) data_ = new mesh_data();
+        *data_ = m_data;
+        complete_ = true;
+    }
+
+    void Mesh::release() {
+        if (residency_ == ResidencyPolicy::COMPACT && data_ != nullptr) {
+            // Keep positions and indices as a collision proxy
+            TrackedVector<float, MemoryTag::MESH>().swap(data_->normals);
+            TrackedVector<float, MemoryTag::MESH>().swap(data_->uvs);
+            TrackedVector<float, MemoryTag::MESH>().swap(data_->colors);
+            TrackedVector<float, MemoryTag::MESH>().swap(data_->bone_weights);
+            TrackedVector<float, MemoryTag::MESH>().swap(data_->morphs);
+        }
+        else {
+            delete data_;
+            data_ = nullptr;
+        }
+        complete_ = false;
+    }
+
     void Mesh::unload() {
         delete data_;
         data_ = nullptr;
+        loaded_ = false;
+        complete_ = false;
         
         // Check for OpenGL
         #if ENGINE_GRAPHICS_API == ENGINE_GRAPHICS_OPGL
@@ -294,9 +350,13 @@ namespace seedengine {
         }
     }
 
-    bool Mesh::parse(const string& path, mesh_data* out) {
+    bool Mesh::parse(const string& path, mesh_data* out, const std::vector<char>* bytes) {
+        ENGINE_PROFILE_SCOPE("Mesh::parse");
+        MemoryTagScope memory_tag(MemoryTag::MESH);
 
-        util::BinaryParser parser(path);
+        std::unique_ptr<util::BinaryParser> source(bytes != nullptr && !bytes->empty() ?
+            new util::BinaryParser(path, bytes->data(), bytes->size()) : new util::BinaryParser(path));
+        util::BinaryParser& parser = *source;
 
         // Header data
         std::array<uint32_t, 8> h_data_32{}; // group count, position count, normal count, uv count, color count, bone weight count, morph count, vertices count
@@ -481,16 +541,16 @@ namespace seedengine {
             }
         }
 
-        out->positions = t_positions;
-        out->normals = t_normals;
-        out->uvs = t_uvs;
-        out->colors = t_colors;
-        out->bone_weights = bone_weights;
-        out->morphs = morphs;
+        out->positions.assign(t_positions.begin(), t_positions.end());
+        out->normals.assign(t_normals.begin(), t_normals.end());
+        out->uvs.assign(t_uvs.begin(), t_uvs.end());
+        out->colors.assign(t_colors.begin(), t_colors.end());
+        out->bone_weights.assign(bone_weights.begin(), bone_weights.end());
+        out->morphs.assign(morphs.begin(), morphs.end());
         out->uvs_per_vertex = uvs_p_vert;
         out->colors_per_vertex = colors_p_vert;
         out->vertex_size = vertex_size;
-        out->indices = indices_buffer;
+        out->indices.assign(indices_buffer.begin(), indices_buffer.end());
 
         return true;
 
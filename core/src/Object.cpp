@@ -1,4 +1,5 @@
 #include "Object.hpp"
+#include "Event.hpp"
 
 namespace seedengine {
 
@@ -65,4 +66,17 @@ namespace seedengine {
         return *this > obj || *this == obj;
     }
 
+    TimerId Object::Destroy(Object* obj, float delay) {
+        if (delay <= 0.0f) {
+            delete obj;
+            return 0;
+        }
+        if (!EventDispatcher::isDispatchThread()) {
+            // The timers belong to the dispatch thread
+            EventDispatcher::post([obj, delay]() { Timers::after(delay, [obj]() { delete obj; }); });
+            return 0;
+        }
+        return Timers::after(delay, [obj]() { delete obj; });
+    }
+
 }
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "Pacer.hpp"
+
+namespace seedengine {
+
+    // Frame Pacer
+
+    const int64_t FramePacer::DEFAULT_SPIN_NS;
+    const int64_t FramePacer::MAX_SPIN_NS;
+
+    FramePacer::FramePacer(int64_t spin_ns) : spin_ns_(spin_ns > 0 ? spin_ns : 0), base_spin_ns_(spin_ns_) {}
+
+    FramePacer::~FramePacer() {
+        #ifdef _WIN32
+            if (timer_period_) timeEndPeriod(1);
+        #endif
+    }
+
+    int64_t FramePacer::waitUntil(int64_t deadline_ns) {
+        int64_t now = Time::nowNS();
+
+        // Sleep through most of the wait, leaving the margin for late wake ups
+        if (deadline_ns - now > spin_ns_) {
+            #ifdef _WIN32
+                // The default 15.6 ms timer would oversleep most frames
+                if (!timer_period_) timer_period_ = timeBeginPeriod(1) == TIMERR_NOERROR;
+            #endif
+            std::this_thread::sleep_for(std::chrono::nanoseconds(deadline_ns - now - spin_ns_));
+            int64_t woke = Time::nowNS();
+            slept_ns_ += woke - now;
+            now = woke;
+            // Woke past the deadline, so keep a wider margin for a while
+            int64_t oversleep = woke - (deadline_ns - spin_ns_);
+            int64_t needed = std::min(oversleep + oversleep / 4, MAX_SPIN_NS);
+            if (woke > deadline_ns) spin_ns_ = std::max(spin_ns_, needed);
+            // Woke on time, so narrow a widened margin back toward the configured one
+            else if (spin_ns_ > base_spin_ns_) {
+                int64_t target = std::max(base_spin_ns_, needed);
+                if (spin_ns_ > target) spin_ns_ -= (spin_ns_ - target + 7) / 8;
+            }
+        }
+
+        // Spin out the rest, letting other threads run meanwhile
+        int64_t spin_start = now;
+        while (now < deadline_ns) {
+            std::this_thread::yield();
+            now = Time::nowNS();
+        }
+        spun_ns_ += now - spin_start;
+
+        int64_t error = now - deadline_ns;
+        errors_.record(static_cast<uint64_t>(error));
+        if (last_wake_ns_ >= 0) {
+            int64_t interval = now - last_wake_ns_;
+            intervals_.record(static_cast<uint64_t>(interval));
+            // Welford's update keeps the variance exact without storing every interval
+            double delta = interval - interval_mean_;
+            interval_mean_ += delta / static_cast<double>(intervals_.count());
+            interval_m2_ += delta * (interval - interval_mean_);
+        }
+        last_wake_ns_ = now;
+        return error;
+    }
+
+    double FramePacer::intervalDeviation() const {
+        if (intervals_.count() < 2) return 0.0;
+        return std::sqrt(interval_m2_ / static_cast<double>(intervals_.count() - 1));
+    }
+
+    string FramePacer::summary() const {
+        std::ostringstream out;
+        out << errors_.count() << " waits, late by p50 " << errors_.percentile(0.5) / 1000.0
+            << " us, p99 " << errors_.percentile(0.99) / 1000.0
+            << " us, max " << errors_.max() / 1000.0
+            << " us, interval deviation " << intervalDeviation() / 1000.0
+            << " us, slept " << slept_ns_ / 1000000.0
+            << " ms, spun " << spun_ns_ / 1000000.0 << " ms";
+        return out.str();
+    }
+
+    void FramePacer::reset() {
+        errors_.clear();
+        intervals_.clear();
+        last_wake_ns_ = -1;
+        interval_mean_ = 0.0;
+        interval_m2_ = 0.0;
+        slept_ns_ = 0;
+        spun_ns_ = 0;
+    }
+
+}
@@ -1,5 +1,15 @@
 #include "Parser.hpp"
 
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <cstring>
+
+#ifndef _WIN32
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
 namespace seedengine {
     namespace util {
 
@@ -19,156 +29,849 @@ namespace seedengine {
             ENGINE_INFO("Printing parser contents...");
         }
 
+        // Config Table
+
+        ConfigTable::ConfigTable(size_t capacity) {
+            size_t slots = 16;
+            while (slots < capacity * 2) slots *= 2;
+            slots_.resize(slots);
+        }
+
+        ConfigEntry& ConfigTable::insert(uint64_t id) {
+            // Keep the load factor at or below one half
+            if ((count_ + 1) * 2 > slots_.size()) grow();
+            size_t mask = slots_.size() - 1;
+            for (size_t i = hash(id) & mask;; i = (i + 1) & mask) {
+                if (slots_[i].id == id) return slots_[i];
+                if (slots_[i].id == 0) {
+                    slots_[i].id = id;
+                    count_++;
+                    return slots_[i];
+                }
+            }
+        }
+
+        const ConfigEntry* ConfigTable::find(uint64_t id) const {
+            if (id == 0) return nullptr;
+            size_t mask = slots_.size() - 1;
+            for (size_t i = hash(id) & mask;; i = (i + 1) & mask) {
+                if (slots_[i].id == id) return &slots_[i];
+                if (slots_[i].id == 0) return nullptr;
+            }
+        }
+
+        size_t ConfigTable::hash(uint64_t id) {
+            // 64 bit finalizer from MurmurHash3
+            id ^= id >> 33;
+            id *= 0xff51afd7ed558ccdULL;
+            id ^= id >> 33;
+            id *= 0xc4ceb9fe1a85ec53ULL;
+            id ^= id >> 33;
+            return static_cast<size_t>(id);
+        }
+
+        void ConfigTable::grow() {
+            std::vector<ConfigEntry> old(slots_.size() * 2);
+            old.swap(slots_);
+            count_ = 0;
+            for (ConfigEntry& entry : old) {
+                if (entry.id != 0) insert(entry.id) = std::move(entry);
+            }
+        }
+
+        // Config Blob
+
+        namespace {
+
+            /** The header of a compiled config blob. */
+            struct ConfigBlobHeader {
+                uint32_t magic;
+                uint32_t version;
+                uint32_t count;
+                uint32_t pool_size;
+            };
+
+            /**
+             * @brief Returns the modification time of a file in nanoseconds.
+             * 
+             * @param path The path to the file.
+             * @param size Set to the size of the file if not nullptr.
+             * @return int64_t The modification time, or -1 if the file does not exist.
+             */
+            int64_t fileTime(const string& path, int64_t* size = nullptr) {
+                struct stat info;
+                if (stat(path.c_str(), &info) != 0) {
+                    if (size != nullptr) *size = -1;
+                    return -1;
+                }
+                if (size != nullptr) *size = static_cast<int64_t>(info.st_size);
+                // Use nanosecond modification times where available
+                #if defined(__APPLE__) || defined(__MACH__)
+                    return static_cast<int64_t>(info.st_mtimespec.tv_sec) * 1000000000 + info.st_mtimespec.tv_nsec;
+                #elif defined(_WIN32)
+                    return static_cast<int64_t>(info.st_mtime) * 1000000000;
+                #else
+                    return static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+                #endif
+            }
+
+        }
+
+        ConfigBlob::~ConfigBlob() {
+            close();
+        }
+
+        bool ConfigBlob::open(const string& path) {
+            close();
+
+            #ifdef _WIN32
+
+                HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+                if (file == INVALID_HANDLE_VALUE) return false;
+                LARGE_INTEGER size;
+                GetFileSizeEx(file, &size);
+                length_ = static_cast<size_t>(size.QuadPart);
+                mapping_ = (length_ == 0) ? NULL : CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+                CloseHandle(file);
+                if (mapping_ == NULL) return false;
+                data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+
+            #else
+
+                int file = ::open(path.c_str(), O_RDONLY);
+                if (file < 0) return false;
+                struct stat info;
+                if (fstat(file, &info) != 0 || info.st_size == 0) {
+                    ::close(file);
+                    return false;
+                }
+                length_ = static_cast<size_t>(info.st_size);
+                void* mapped = mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, file, 0);
+                ::close(file);
+                data_ = (mapped == MAP_FAILED) ? nullptr : static_cast<const char*>(mapped);
+
+            #endif
+
+            if (data_ == nullptr) {
+                close();
+                return false;
+            }
+
+            // Validate the header and section sizes
+            ConfigBlobHeader header;
+            if (length_ < sizeof(header)) {
+                close();
+                return false;
+            }
+            std::memcpy(&header, data_, sizeof(header));
+            size_t table_end = sizeof(header) + static_cast<size_t>(header.count) * sizeof(ConfigBlobEntry);
+            if (header.magic != MAGIC || header.version != VERSION || table_end + header.pool_size != length_) {
+                ENGINE_WARN("Config blob '{0}' is invalid or was written by a different version.", path);
+                close();
+                return false;
+            }
+
+            entries_ = reinterpret_cast<const ConfigBlobEntry*>(data_ + sizeof(header));
+            count_ = header.count;
+            pool_ = data_ + table_end;
+            pool_size_ = header.pool_size;
+
+            // Validate every entry once, so lookups may trust the offsets
+            for (size_t i = 0; i < count_; i++) {
+                if (!valid(entries_[i]) || (i > 0 && entries_[i - 1].hash > entries_[i].hash)) {
+                    ENGINE_WARN("Config blob '{0}' is corrupt at entry {1}.", path, i);
+                    close();
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool ConfigBlob::valid(const ConfigBlobEntry& entry) const {
+
+            // Both names are null terminated inside the pool
+            if (entry.name >= pool_size_) return false;
+            const char* section_end = static_cast<const char*>(std::memchr(pool_ + entry.name, '\0', pool_size_ - entry.name));
+            if (section_end == nullptr) return false;
+            size_t key_start = static_cast<size_t>(section_end - pool_) + 1;
+            if (key_start >= pool_size_ || std::memchr(pool_ + key_start, '\0', pool_size_ - key_start) == nullptr) return false;
+
+            if (entry.type > static_cast<uint32_t>(ConfigType::STRING)) return false;
+            if (entry.type == static_cast<uint32_t>(ConfigType::STRING)) {
+                return static_cast<uint64_t>(entry.value) + entry.length <= pool_size_;
+            }
+            return true;
+        }
+
+        void ConfigBlob::close() {
+            if (data_ != nullptr) {
+                #ifdef _WIN32
+                    UnmapViewOfFile(data_);
+                #else
+                    munmap(const_cast<char*>(data_), length_);
+                #endif
+            }
+            #ifdef _WIN32
+                if (mapping_ != NULL) CloseHandle(mapping_);
+                mapping_ = NULL;
+            #endif
+            data_ = nullptr;
+            length_ = 0;
+            entries_ = nullptr;
+            count_ = 0;
+            pool_ = nullptr;
+            pool_size_ = 0;
+        }
+
+        const ConfigBlobEntry* ConfigBlob::find(const string& section, const string& key) const {
+            uint64_t h = hash(section, key);
+            const ConfigBlobEntry* it = std::lower_bound(begin(), end(), h,
+                [](const ConfigBlobEntry& entry, uint64_t value) { return entry.hash < value; });
+            for (; it != end() && it->hash == h; ++it) {
+                if (section == this->section(*it) && key == this->key(*it)) return it;
+            }
+            return nullptr;
+        }
+
+        void ConfigBlob::read(const ConfigBlobEntry& entry, ConfigEntry& out) const {
+            out.type = static_cast<ConfigType>(entry.type);
+            switch (out.type) {
+                case ConfigType::INT:
+                    std::memcpy(&out.int_value, &entry.value, sizeof(out.int_value));
+                    break;
+                case ConfigType::FLOAT:
+                    std::memcpy(&out.float_value, &entry.value, sizeof(out.float_value));
+                    break;
+                case ConfigType::BOOL:
+                    out.bool_value = entry.value != 0;
+                    break;
+                case ConfigType::STRING:
+                    out.string_value.assign(pool_ + entry.value, entry.length);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        uint64_t ConfigBlob::hash(const string& section, const string& key) {
+            uint64_t h = 14695981039346656037ULL; // FNV-1a offset basis
+            for (char c : section) {
+                h ^= static_cast<unsigned char>(c);
+                h *= 1099511628211ULL; // FNV-1a prime
+            }
+            h *= 1099511628211ULL; // The separating null byte
+            for (char c : key) {
+                h ^= static_cast<unsigned char>(c);
+                h *= 1099511628211ULL;
+            }
+            return h;
+        }
+
+        bool ConfigBlob::write(const string& path, const ConfigTable& table) {
+            std::vector<std::pair<ConfigBlobEntry, const ConfigEntry*>> entries;
+            string pool;
+
+            for (const ConfigEntry& slot : table.slots()) {
+                if (slot.id == 0) continue;
+                string section = IniParser::nameOf(static_cast<uint32_t>(slot.id >> 32));
+                string key = IniParser::nameOf(static_cast<uint32_t>(slot.id));
+
+                ConfigBlobEntry entry;
+                entry.hash = hash(section, key);
+                entry.name = static_cast<uint32_t>(pool.size());
+                entry.type = static_cast<uint32_t>(slot.type);
+                entry.value = 0;
+                entry.length = 0;
+                pool += section;
+                pool += '\0';
+                pool += key;
+                pool += '\0';
+
+                switch (slot.type) {
+                    case ConfigType::INT:
+                        std::memcpy(&entry.value, &slot.int_value, sizeof(entry.value));
+                        break;
+                    case ConfigType::FLOAT:
+                        std::memcpy(&entry.value, &slot.float_value, sizeof(entry.value));
+                        break;
+                    case ConfigType::BOOL:
+                        entry.value = slot.bool_value ? 1 : 0;
+                        break;
+                    case ConfigType::STRING:
+                        entry.value = static_cast<uint32_t>(pool.size());
+                        entry.length = static_cast<uint32_t>(slot.string_value.size());
+                        pool += slot.string_value;
+                        break;
+                    default:
+                        break;
+                }
+                entries.push_back(std::make_pair(entry, &slot));
+            }
+
+            std::sort(entries.begin(), entries.end(),
+                [](const std::pair<ConfigBlobEntry, const ConfigEntry*>& a, const std::pair<ConfigBlobEntry, const ConfigEntry*>& b) {
+                    return a.first.hash < b.first.hash;
+                });
+
+            std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!file) return false;
+            ConfigBlobHeader header = { MAGIC, VERSION, static_cast<uint32_t>(entries.size()), static_cast<uint32_t>(pool.size()) };
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            for (auto& entry : entries) file.write(reinterpret_cast<const char*>(&entry.first), sizeof(ConfigBlobEntry));
+            file.write(pool.data(), pool.size());
+            return static_cast<bool>(file);
+        }
+
         // INI Parser
 
-        IniParser::IniParser(string filepath) : Parser(filepath) {
-            parsed_data = ini_data();
-            parse(filepath);
+        namespace {
+
+            /** An interned name. Never freed, so lookups may hold it without a lock. */
+            struct InternNode {
+                string name;
+                uint32_t id;
+            };
+
+            /** An open addressing table of interned names. Slots are only ever filled in. */
+            struct InternTable {
+                explicit InternTable(size_t capacity) : slots(new std::atomic<const InternNode*>[capacity]), mask(capacity - 1) {
+                    for (size_t i = 0; i < capacity; i++) slots[i].store(nullptr, std::memory_order_relaxed);
+                }
+                std::unique_ptr<std::atomic<const InternNode*>[]> slots;
+                size_t mask;
+            };
+
+            /**
+             * The interned section and key names shared by all parsers. Names are added under the
+             * mutex and published to the current table, which lookups probe without locking. A full
+             * table is replaced by one twice its size, and old tables are kept for lookups still in them.
+             */
+            struct Interner {
+                Interner() : table(nullptr) {
+                    tables.emplace_back(new InternTable(64));
+                    table.store(tables.back().get(), std::memory_order_release);
+                }
+                std::mutex mu;
+                std::atomic<const InternTable*> table;
+                std::vector<std::unique_ptr<InternTable>> tables;
+                std::vector<std::unique_ptr<InternNode>> nodes;
+                std::vector<string> names { string() };
+            };
+
+            Interner& interner() {
+                static Interner instance;
+                return instance;
+            }
+
+            inline bool isNameStart(char c) {
+                return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+            }
+
+            inline bool isNameChar(char c) {
+                return isNameStart(c) || (c >= '0' && c <= '9') || c == '_';
+            }
+
+            inline bool isSpace(char c) {
+                return c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+            }
+
+            inline bool isDigit(char c) {
+                return c >= '0' && c <= '9';
+            }
+
+            /**
+             * @brief Parses a single value, determining its type from its spelling.
+             * 
+             * @param begin The first character of the value.
+             * @param end One past the last character of the value.
+             * @param entry The entry to store the value in.
+             * @return true If the value is valid.
+             */
+            bool parseValue(const char* begin, const char* end, ConfigEntry& entry) {
+                size_t length = end - begin;
+                if (length == 0) return false;
+
+                // Quoted strings
+                if ((*begin == '"' || *begin == '\'') && length >= 2 && *(end - 1) == *begin) {
+                    entry.type = ConfigType::STRING;
+                    entry.string_value.assign(begin + 1, end - 1);
+                    return true;
+                }
+
+                // Booleans
+                string word(begin, end);
+                if (word == "true" || word == "True" || word == "TRUE") {
+                    entry.type = ConfigType::BOOL;
+                    entry.bool_value = true;
+                    return true;
+                }
+                if (word == "false" || word == "False" || word == "FALSE") {
+                    entry.type = ConfigType::BOOL;
+                    entry.bool_value = false;
+                    return true;
+                }
+
+                // Integers and floats
+                const char* c = begin;
+                if (*c == '-') c++;
+                bool digits = false, point = false;
+                for (; c != end; c++) {
+                    if (isDigit(*c)) digits = true;
+                    else if (*c == '.' && !point) point = true;
+                    else return false;
+                }
+                if (!digits) return false;
+                if (point) {
+                    entry.type = ConfigType::FLOAT;
+                    entry.float_value = std::strtof(word.c_str(), nullptr);
+                }
+                else {
+                    entry.type = ConfigType::INT;
+                    entry.int_value = static_cast<int>(std::strtol(word.c_str(), nullptr, 10));
+                }
+                return true;
+            }
+
         }
 
-        void IniParser::parse(string filepath) {
+        IniParser::IniParser(string filepath) : Parser(filepath), filepath_(filepath), compiled_(false), table_(nullptr), generation_(0), readers_(0) {
 
-            // Regex templates in ECMAScript format
+        }
 
-            std::regex white_regex("^[\\s]*$");
-            std::regex section_regex("^[\\s]*(\\[\\s*([a-zA-Z][\\w]*(?:\\.[\\w]+)?)\\s*\\])\\s*$");
-            std::regex int_regex("^[\\s]*([a-zA-Z][\\w]*)\\s*=\\s*(-?[0-9]+)\\s*$");
-            std::regex float_regex("^[\\s]*([a-zA-Z][\\w]*)\\s*=\\s*(-?[0-9]*\\.(?:[0-9]*)?)\\s*$");
-            std::regex bool_regex("^[\\s]*([a-zA-Z][\\w]*)\\s*=\\s*([Tt]rue|TRUE|[Ff]alse|FALSE)\\s*$");
-            std::regex string_regex("^[\\s]*([a-zA-Z][\\w]*)\\s*=\\s*(?:\"([^\"]*)\"|'([^\']*)')\\s*$");
+        IniParser::~IniParser() {
+            unwatch();
+            for (const ConfigTable* retired : retired_) delete retired;
+            delete table_.load();
+        }
 
-            // Read the passed file
+        IniParser::Reader IniParser::table() const {
+            return Reader(*this);
+        }
 
-            file_.open(filepath, std::ios::in);
+        const ConfigTable& IniParser::current() const {
+            // Sequentially consistent with the reader count, see dispatchChanges()
+            const ConfigTable* table = table_.load();
+            if (table != nullptr) return *table;
+
+            std::lock_guard<std::mutex> guard(parse_mu_);
+            table = table_.load(std::memory_order_relaxed);
+            if (table == nullptr) {
+                stampChanged();
+                ConfigTable* parsed = const_cast<IniParser*>(this)->parse(filepath_);
+                parsed->generation = 1;
+                table = parsed;
+                table_.store(table);
+                generation_.store(parsed->generation, std::memory_order_release);
+            }
+            return *table;
+        }
 
-            if (file_.is_open()) {
+        bool IniParser::reload() {
+            table();
+            std::lock_guard<std::mutex> guard(parse_mu_);
+            if (!stampChanged()) return false;
 
-                // The name of the active section
-                string active_section;
+            publish(parse(filepath_));
+            ENGINE_INFO("Reloaded ini file \"" + filepath_ + "\".");
+            return true;
+        }
 
-                std::string line;
-                int line_num = 0;
+        void IniParser::reopen(const string& filepath) {
+            assert(!watcher_.joinable() && "An ini file may not be reopened while it is watched.");
+            table();
+            std::lock_guard<std::mutex> guard(parse_mu_);
+            filepath_ = filepath;
+            stampChanged();
+            publish(parse(filepath_));
+            ENGINE_INFO("Opened ini file \"" + filepath_ + "\".");
+        }
 
-                while (std::getline(file_, line)) {
+        void IniParser::publish(ConfigTable* parsed) {
+            const ConfigTable* old = table_.load(std::memory_order_relaxed);
+            parsed->generation = old->generation + 1;
+            table_.store(parsed);
+            generation_.store(parsed->generation, std::memory_order_release);
+            // Readers may still hold the old table, free it once their reads have ended
+            retired_.push_back(old);
+        }
+
+        void IniParser::watch(unsigned int interval_ms) {
+            unwatch();
+            table();
+            {
+                std::lock_guard<std::mutex> guard(watch_mu_);
+                watching_ = true;
+            }
+            watcher_ = std::thread(&IniParser::watchLoop, this, interval_ms);
+        }
 
-                    std::smatch m;
+        void IniParser::unwatch() {
+            {
+                std::lock_guard<std::mutex> guard(watch_mu_);
+                watching_ = false;
+            }
+            watch_cv_.notify_all();
+            if (watcher_.joinable()) watcher_.join();
+        }
 
-                    ENGINE_DEBUG(line);
+        void IniParser::watchLoop(unsigned int interval_ms) {
+            std::unique_lock<std::mutex> lock(watch_mu_);
+            while (watching_) {
+                watch_cv_.wait_for(lock, std::chrono::milliseconds(interval_ms));
+                if (!watching_) break;
+                lock.unlock();
+                reload();
+                lock.lock();
+            }
+        }
 
-                    // Remove comments
-                    string no_comment_line = line.substr(0, line.find(";", 0));
-                    no_comment_line = no_comment_line.substr(0, no_comment_line.find("#", 0));
+        unsigned int IniParser::subscribe(const string& section, const string& key, ChangeCallback callback) {
+            Subscription subscription;
+            subscription.id = next_subscription_++;
+            subscription.value_id = id(section, key);
+            subscription.callback = callback;
+            subscriptions_.push_back(subscription);
+            return subscription.id;
+        }
 
-                    if (std::regex_match(no_comment_line, m, white_regex)) {
-                        // Skip line
-                    }
-                    else if (std::regex_match(no_comment_line, m, section_regex)) {
-                        active_section = m[2];
-                        // Check if section exists
-                        if (parsed_data.find(active_section) == parsed_data.end()) {
-
-                            // Create storage for this section
-                            ints int_data = ints();
-                            floats float_data = floats();
-                            bools bool_data = bools();
-                            strings string_data = strings();
-
-                            section s = {
-                                int_data,
-                                float_data,
-                                string_data,
-                                bool_data
-                            };
-
-                            parsed_data.insert(std::pair<string, section>(active_section, s));
+        void IniParser::unsubscribe(unsigned int id) {
+            for (auto it = subscriptions_.begin(); it != subscriptions_.end(); ++it) {
+                if (it->id == id) {
+                    subscriptions_.erase(it);
+                    return;
+                }
+            }
+        }
+
+        unsigned int IniParser::dispatchChanges() {
+            unsigned int called = 0;
+
+            // The read ends before retired tables are freed
+            {
+                Reader current = table();
+                if (dispatched_ != &*current) {
+                    if (dispatched_ != nullptr) {
+                        // Copy the subscriptions so callbacks may subscribe or unsubscribe
+                        std::vector<Subscription> subscriptions = subscriptions_;
+                        for (const Subscription& subscription : subscriptions) {
+                            const ConfigEntry* before = dispatched_->find(subscription.value_id);
+                            const ConfigEntry* after = current->find(subscription.value_id);
+                            bool changed = (before == nullptr || after == nullptr) ? before != after :
+                                before->type != after->type || before->int_value != after->int_value ||
+                                before->float_value != after->float_value || before->bool_value != after->bool_value ||
+                                before->string_value != after->string_value;
+                            if (changed) {
+                                subscription.callback();
+                                called++;
+                            }
                         }
-                        // Note: allows repeating a header, will append additional data. key value pairs will however overwrite if repeated
-                    }
-                    else if (active_section.empty()) {
-                        ENGINE_ERROR("Error in ini file \"" + filepath + "\" at line " + std::to_string(line_num) + ": no section header defined.");
                     }
-                    else if (std::regex_match(no_comment_line, m, int_regex)) {
-                        const int v = std::stoi(m[2]);
-                        parsed_data.at(active_section).int_data.insert(std::pair<string, const int>(m[1], v));
+                    dispatched_ = &*current;
+                }
+            }
+
+            // Readers count in before loading the table, and tables are retired after the next one
+            // is stored. So once no read is in progress, no reader can hold a retired table. The
+            // table last dispatched is kept, as the next call compares against it.
+            std::lock_guard<std::mutex> guard(parse_mu_);
+            if (readers_.load() == 0) {
+                for (auto it = retired_.begin(); it != retired_.end();) {
+                    if (*it != dispatched_) {
+                        delete *it;
+                        it = retired_.erase(it);
                     }
-                    else if (std::regex_match(no_comment_line, m, float_regex)) {
-                        const float v = std::stof(m[2]);
-                        parsed_data.at(active_section).float_data.insert(std::pair<string, const float>(m[1], v));
+                    else ++it;
+                }
+            }
+            return called;
+        }
+
+        bool IniParser::stampChanged() const {
+            int64_t size;
+            int64_t time = fileTime(filepath_, &size);
+            if (time == stamp_time_ && size == stamp_size_) return false;
+            stamp_time_ = time;
+            stamp_size_ = size;
+            return true;
+        }
+
+        bool IniParser::compile(const string& blob_path) const {
+            string path = blob_path.empty() ? filepath_ + ".bin" : blob_path;
+            if (!ConfigBlob::write(path, *table())) {
+                ENGINE_ERROR("Failed to write config blob \"" + path + "\".");
+                return false;
+            }
+            return true;
+        }
+
+        ConfigTable* IniParser::load(const string& blob_path) {
+            ConfigBlob blob;
+            if (!blob.open(blob_path)) return nullptr;
+
+            ConfigTable* table = new ConfigTable(blob.size());
+            for (const ConfigBlobEntry& entry : blob) {
+                uint64_t id = (static_cast<uint64_t>(intern(blob.section(entry))) << 32) | intern(blob.key(entry));
+                ConfigEntry& out = table->insert(id);
+                blob.read(entry, out);
+            }
+            return table;
+        }
+
+        ConfigTable* IniParser::parse(string filepath) {
+
+            // Prefer the compiled blob while it is newer than the text file
+            string blob_path = filepath + ".bin";
+            int64_t blob_time = fileTime(blob_path);
+            if (blob_time >= 0 && blob_time >= fileTime(filepath)) {
+                ConfigTable* compiled = load(blob_path);
+                if (compiled != nullptr) {
+                    compiled_ = true;
+                    return compiled;
+                }
+            }
+            compiled_ = false;
+
+            ConfigTable* table = new ConfigTable();
+
+            // Read the passed file in a single pass
+            std::ifstream file(filepath, std::ios::in | std::ios::binary);
+            if (!file) {
+                ENGINE_ERROR("Failed to open ini file \"" + filepath + "\".");
+                return table;
+            }
+            string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            // The id of the active section
+            uint32_t active_section = 0;
+
+            const char* c = contents.data();
+            const char* end = c + contents.size();
+            int line_num = 0;
+
+            while (c < end) {
+
+                line_num++;
+
+                // Find the end of the line, ignoring comments outside of quotes
+                const char* line = c;
+                const char* line_end = line;
+                char quote = 0;
+                while (c < end && *c != '\n') {
+                    if (quote != 0) {
+                        if (*c == quote) quote = 0;
                     }
-                    else if (std::regex_match(no_comment_line, m, bool_regex)) {
-                        const bool v = (m[2] == "true" || m[2] == "True" || m[2] == "TRUE");
-                        parsed_data.at(active_section).bool_data.insert(std::pair<string, const bool>(m[1], v));
+                    else if (*c == '"' || *c == '\'') quote = *c;
+                    else if (*c == ';' || *c == '#') {
+                        while (c < end && *c != '\n') c++;
+                        break;
                     }
-                    else if (std::regex_match(no_comment_line, m, string_regex)) {
-                        const string v = (m[2].str().empty()) ? m[3] : m[2];
-                        parsed_data.at(active_section).string_data.insert(std::pair<string, const string>(m[1], v));
+                    line_end = ++c;
+                }
+                if (c < end) c++;
+
+                // Trim whitespace
+                while (line < line_end && isSpace(*line)) line++;
+                while (line_end > line && isSpace(*(line_end - 1))) line_end--;
+
+                if (line == line_end) {
+                    // Skip line
+                    continue;
+                }
+
+                if (*line == '[') {
+                    // Section header: [Name] or [Name.Sub]
+                    const char* name = line + 1;
+                    const char* name_end = line_end - 1;
+                    while (name < name_end && isSpace(*name)) name++;
+                    while (name_end > name && isSpace(*(name_end - 1))) name_end--;
+                    bool valid = *(line_end - 1) == ']' && name < name_end && isNameStart(*name);
+                    for (const char* n = name; valid && n < name_end; n++) {
+                        valid = isNameChar(*n) || *n == '.';
                     }
-                    else {
+                    if (!valid) {
                         ENGINE_ERROR("Error in ini file \"" + filepath + "\" at line " + std::to_string(line_num));
+                        continue;
                     }
+                    // Note: allows repeating a header, key value pairs will however overwrite if repeated
+                    active_section = intern(string(name, name_end));
+                    continue;
+                }
+
+                if (active_section == 0) {
+                    ENGINE_ERROR("Error in ini file \"" + filepath + "\" at line " + std::to_string(line_num) + ": no section header defined.");
+                    continue;
+                }
 
-                    line_num++;
+                // Key value pair: key = value
+                const char* key_end = line;
+                if (isNameStart(*key_end)) {
+                    while (key_end < line_end && isNameChar(*key_end)) key_end++;
+                }
+                const char* value = key_end;
+                while (value < line_end && isSpace(*value)) value++;
+
+                ConfigEntry entry;
+                if (key_end == line || value == line_end || *value != '=' ||
+                        !parseValue(std::find_if_not(value + 1, line_end, isSpace), line_end, entry)) {
+                    ENGINE_ERROR("Error in ini file \"" + filepath + "\" at line " + std::to_string(line_num));
+                    continue;
                 }
 
-                file_.close();
-                
+                uint64_t id = (static_cast<uint64_t>(active_section) << 32) | intern(string(line, key_end));
+                entry.id = id;
+                table->insert(id) = std::move(entry);
             }
 
+            return table;
+        }
 
+        const ConfigEntry& IniParser::at(const Reader& reader, const string& section, const string& key, ConfigType type) const {
+            const ConfigEntry* entry = reader->find(lookup(section, key));
+            if (entry == nullptr || entry->type != type) {
+                throw std::out_of_range("Config value '" + section + "." + key + "' not found.");
+            }
+            return *entry;
         }
 
         int IniParser::get(const string& section, const string& key, int& out) const {
-            return out = parsed_data.at(section).int_data.at(key);
+            Reader reader = table();
+            return out = at(reader, section, key, ConfigType::INT).int_value;
         }
 
         float IniParser::get(const string& section, const string& key, float& out) const {
-            return out = parsed_data.at(section).float_data.at(key);
+            Reader reader = table();
+            return out = at(reader, section, key, ConfigType::FLOAT).float_value;
         }
 
         bool IniParser::get(const string& section, const string& key, bool& out) const {
-            return out = parsed_data.at(section).bool_data.at(key);
+            Reader reader = table();
+            return out = at(reader, section, key, ConfigType::BOOL).bool_value;
         }
 
         string IniParser::get(const string& section, const string& key, string& out) const {
-            return out = parsed_data.at(section).string_data.at(key);
+            Reader reader = table();
+            return out = at(reader, section, key, ConfigType::STRING).string_value;
         }
 
         int IniParser::getInt(const string& section, const string& key) const {
-            return parsed_data.at(section).int_data.at(key);
+            Reader reader = table();
+            return at(reader, section, key, ConfigType::INT).int_value;
         }
 
         float IniParser::getFloat(const string& section, const string& key) const {
-            return parsed_data.at(section).float_data.at(key);
+            Reader reader = table();
+            return at(reader, section, key, ConfigType::FLOAT).float_value;
         }
 
         bool IniParser::getBool(const string& section, const string& key) const {
-            return parsed_data.at(section).bool_data.at(key);
+            Reader reader = table();
+            return at(reader, section, key, ConfigType::BOOL).bool_value;
         }
 
         string IniParser::getString(const string& section, const string& key) const {
-            return parsed_data.at(section).string_data.at(key);
+            Reader reader = table();
+            return at(reader, section, key, ConfigType::STRING).string_value;
+        }
+
+        bool IniParser::has(const string& section, const string& key) const {
+            return table()->find(lookup(section, key)) != nullptr;
+        }
+
+        bool IniParser::find(uint64_t id, int& out) const {
+            Reader reader = table();
+            const ConfigEntry* entry = reader->find(id);
+            if (entry == nullptr || entry->type != ConfigType::INT) return false;
+            out = entry->int_value;
+            return true;
+        }
+
+        bool IniParser::find(uint64_t id, float& out) const {
+            Reader reader = table();
+            const ConfigEntry* entry = reader->find(id);
+            if (entry == nullptr) return false;
+            if (entry->type == ConfigType::FLOAT) out = entry->float_value;
+            else if (entry->type == ConfigType::INT) out = static_cast<float>(entry->int_value);
+            else return false;
+            return true;
+        }
+
+        bool IniParser::find(uint64_t id, bool& out) const {
+            Reader reader = table();
+            const ConfigEntry* entry = reader->find(id);
+            if (entry == nullptr || entry->type != ConfigType::BOOL) return false;
+            out = entry->bool_value;
+            return true;
+        }
+
+        bool IniParser::find(uint64_t id, string& out) const {
+            Reader reader = table();
+            const ConfigEntry* entry = reader->find(id);
+            if (entry == nullptr || entry->type != ConfigType::STRING) return false;
+            out = entry->string_value;
+            return true;
+        }
+
+        uint32_t IniParser::intern(const string& name) {
+            uint32_t found = lookup(name);
+            if (found != 0) return found;
+
+            Interner& in = interner();
+            std::lock_guard<std::mutex> guard(in.mu);
+            // Another thread may have interned the name since the lookup
+            found = lookup(name);
+            if (found != 0) return found;
+
+            uint32_t id = static_cast<uint32_t>(in.names.size());
+            in.nodes.emplace_back(new InternNode { name, id });
+            in.names.push_back(name);
+
+            // Keep the load factor at or below one half
+            InternTable* table = in.tables.back().get();
+            if (in.nodes.size() * 2 > table->mask + 1) {
+                in.tables.emplace_back(new InternTable((table->mask + 1) * 2));
+                table = in.tables.back().get();
+                for (const std::unique_ptr<InternNode>& node : in.nodes) {
+                    size_t i = std::hash<string>()(node->name) & table->mask;
+                    while (table->slots[i].load(std::memory_order_relaxed) != nullptr) i = (i + 1) & table->mask;
+                    table->slots[i].store(node.get(), std::memory_order_relaxed);
+                }
+                in.table.store(table, std::memory_order_release);
+            }
+            else {
+                size_t i = std::hash<string>()(name) & table->mask;
+                while (table->slots[i].load(std::memory_order_relaxed) != nullptr) i = (i + 1) & table->mask;
+                table->slots[i].store(in.nodes.back().get(), std::memory_order_release);
+            }
+            return id;
+        }
+
+        uint32_t IniParser::lookup(const string& name) {
+            const InternTable* table = interner().table.load(std::memory_order_acquire);
+            for (size_t i = std::hash<string>()(name) & table->mask;; i = (i + 1) & table->mask) {
+                const InternNode* node = table->slots[i].load(std::memory_order_acquire);
+                if (node == nullptr) return 0;
+                if (node->name == name) return node->id;
+            }
+        }
+
+        string IniParser::nameOf(uint32_t id) {
+            Interner& in = interner();
+            std::lock_guard<std::mutex> guard(in.mu);
+            return (id < in.names.size()) ? in.names[id] : string();
         }
 
         void IniParser::print() const {
             Parser::print();
-            if (parsed_data.empty()) {
+            Reader data = table();
+            if (data->size() == 0) {
                 ENGINE_INFO("Parser is empty.");
                 return;
             }
-            for (auto it = parsed_data.begin(); it != parsed_data.end(); ++it) {
-                ENGINE_INFO("Section: " + it->first);
-                for (auto i = parsed_data.at(it->first).int_data.begin(); i != parsed_data.at(it->first).int_data.end(); ++i) {
-                    ENGINE_INFO("Int: [" + i->first + "]");
-                }
-                for (auto i = parsed_data.at(it->first).float_data.begin(); i != parsed_data.at(it->first).float_data.end(); ++i) {
-                    ENGINE_INFO("Float: [" + i->first + "]");
-                }
-                for (auto i = parsed_data.at(it->first).bool_data.begin(); i != parsed_data.at(it->first).bool_data.end(); ++i) {
-                    ENGINE_INFO("Bool: [" + i->first + "]");
-                }
-                for (auto i = parsed_data.at(it->first).string_data.begin(); i != parsed_data.at(it->first).string_data.end(); ++i) {
-                    ENGINE_INFO("String: [" + i->first + "]");
-                }
+            static const char* type_names[] = { "None", "Int", "Float", "Bool", "String" };
+            for (const ConfigEntry& entry : data->slots()) {
+                if (entry.id == 0) continue;
+                ENGINE_INFO(string(type_names[static_cast<int>(entry.type)]) + ": [" +
+                    nameOf(static_cast<uint32_t>(entry.id >> 32)) + "." + nameOf(static_cast<uint32_t>(entry.id)) + "]");
             }
         }
 
@@ -182,13 +885,17 @@ namespace seedengine {
             pos_ = 0;
         }
 
+        BinaryParser::BinaryParser(string filepath, const char* data, size_t size) : Parser(filepath) {
+            memory_ = data;
+            length_ = static_cast<std::streamoff>(size);
+            pos_ = 0;
+        }
+
 
         bool BinaryParser::getNext(uint32_t* out) {
             if ((unsigned int)pos_ + sizeof(*out) > length_) return false;
-            // Navigate to current file location
-            file_.seekg(pos_);
             // Read in bytes in Big Endian Format (Network byte order)
-            file_.read(reinterpret_cast<char*>(out), sizeof(*out));
+            read(pos_, reinterpret_cast<char*>(out), sizeof(*out));
             *out = ntohl(*out); // Convert to host byte order
             pos_ += sizeof(*out); // Iterate file position
             return true;
@@ -196,10 +903,8 @@ namespace seedengine {
 
         bool BinaryParser::getNext(uint16_t* out) {
             if ((unsigned int)pos_ + sizeof(*out) > length_) return false;
-            // Navigate to current file location
-            file_.seekg(pos_);
             // Read in bytes in Big Endian Format (Network byte order)
-            file_.read(reinterpret_cast<char*>(out), sizeof(*out));
+            read(pos_, reinterpret_cast<char*>(out), sizeof(*out));
             *out = ntohs(*out); // Convert to host byte order
             pos_ += sizeof(*out); // Iterate file position
             return true;
@@ -207,20 +912,16 @@ namespace seedengine {
 
         bool BinaryParser::getNext(uint8_t* out) {
             if ((unsigned int)pos_ + sizeof(*out) > length_) return false;
-            // Navigate to current file location
-            file_.seekg(pos_);
-            file_.read(reinterpret_cast<char*>(out), sizeof(*out));
+            read(pos_, reinterpret_cast<char*>(out), sizeof(*out));
             pos_ += sizeof(*out); // Iterate file position
             return true;
         }
 
         bool BinaryParser::getNext(float* out) {
             if ((unsigned int)pos_ + sizeof(*out) > length_) return false;
-            // Navigate to current file location
-            file_.seekg(pos_);
             uint32_t buffer = 0;
             // Read in bytes in Big Endian Format (Network byte order)
-            file_.read(reinterpret_cast<char*>(&buffer), sizeof(buffer));
+            read(pos_, reinterpret_cast<char*>(&buffer), sizeof(buffer));
             *out = ntohf(buffer); // Convert to host byte order
             pos_ += sizeof(*out); // Iterate file position
             return true;
@@ -231,16 +932,12 @@ namespace seedengine {
                 ENGINE_WARN("Invalid buffer range provided.");
                 return {};
             }
-            if (start + end > length_) {
+            if (end > length_) {
                 ENGINE_WARN("Reguested byte buffer exceeds file bounds.");
                 return {};
             }
-            file_.seekg(start);
-            std::streamoff size = end - start;
-            std::vector<char> values{};
-            values.reserve((unsigned int)size);
-            file_.read(values.data(), size);
-            file_.seekg(pos_);
+            std::vector<char> values(static_cast<size_t>(end - start));
+            read(start, values.data(), end - start);
             return values;
         }
 
@@ -249,14 +946,22 @@ namespace seedengine {
                 ENGINE_WARN("Reguested byte buffer exceeds file bounds.");
                 return {};
             }
-            file_.seekg(pos_);
-            std::vector<char> values{};
-            values.reserve((unsigned int)size);
-            file_.read(values.data(), size);
+            std::vector<char> values(static_cast<size_t>(size));
+            read(pos_, values.data(), size);
             pos_ += size; // Iterate file position
             return values;
         }
 
+        void BinaryParser::read(const std::streampos& start, char* out, std::streamoff size) {
+            if (memory_ != nullptr) {
+                std::memcpy(out, memory_ + static_cast<std::streamoff>(start), static_cast<size_t>(size));
+                return;
+            }
+            // Navigate to the file location
+            file_.seekg(start);
+            file_.read(out, size);
+        }
+
         void BinaryParser::print() const {
             Parser::print();
             ENGINE_WARN("Printing is not implemented for binary parser.");
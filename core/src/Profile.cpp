@@ -0,0 +1,236 @@
+#include "Profile.hpp"
+
+#include <iomanip>
+
+namespace seedengine {
+
+    /** The scopes recorded by a single thread. Only the owning thread writes to it. */
+    class ProfileBuffer final {
+
+    public:
+
+        /**
+         * @brief Constructs a new Profile Buffer. The scopes are allocated by the first capture
+         *        the thread records in, so naming a thread costs nothing until then.
+         *
+         * @param id The id of the thread in traces.
+         */
+        explicit ProfileBuffer(uint32_t id)
+            : count(0), dropped(0), capture(0), id(id) {}
+
+        /** The recorded scopes. Guarded by the registry mutex while resized. */
+        std::vector<ProfileEvent> events;
+        /** The number of scopes recorded in the capture. */
+        std::atomic<size_t> count;
+        /** The number of scopes that did not fit in the capture. */
+        std::atomic<uint64_t> dropped;
+        /** The capture the scopes belong to. */
+        std::atomic<uint32_t> capture;
+        /** The id of the thread in traces. */
+        uint32_t id;
+        /** The name of the thread in traces. Guarded by the registry mutex. */
+        string name;
+
+    };
+
+    /** Guards the list of buffers and the capture settings. */
+    static std::mutex registry_mu;
+    /** The buffer of every thread that has recorded, kept after the thread exits. */
+    static std::vector<std::unique_ptr<ProfileBuffer>> registry;
+    /** The number of scopes each new buffer keeps. */
+    static size_t buffer_capacity = Profiler::DEFAULT_CAPACITY;
+    /** The time the current capture started. */
+    static int64_t capture_start_ns = 0;
+    /** The buffer of the calling thread. */
+    static thread_local ProfileBuffer* local_buffer = nullptr;
+
+    const size_t Profiler::DEFAULT_CAPACITY;
+    std::atomic<bool> Profiler::capturing_(false);
+    std::atomic<uint32_t> Profiler::capture_(0);
+    thread_local uint32_t Profiler::depth_ = 0;
+
+    /**
+     * @brief Calls a function with every buffer holding scopes of the current capture.
+     *
+     * @param function Called with the buffer and the number of scopes to read from it.
+     * @param capture The number of the capture.
+     */
+    static void forEachBuffer(const std::function<void(const ProfileBuffer&, size_t)>& function, uint32_t capture) {
+        std::lock_guard<std::mutex> guard(registry_mu);
+        for (const std::unique_ptr<ProfileBuffer>& buffer : registry) {
+            if (buffer->capture.load(std::memory_order_acquire) != capture) continue;
+            function(*buffer, std::min(buffer->count.load(std::memory_order_acquire), buffer->events.size()));
+        }
+    }
+
+    /**
+     * @brief Writes a string as a JSON string literal.
+     *
+     * @param out The stream to write to.
+     * @param text The string.
+     */
+    static void writeJsonString(std::ostream& out, const char* text) {
+        out << '"';
+        for (const char* c = text; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') out << '\\' << *c;
+            else if (static_cast<unsigned char>(*c) < 0x20) out << ' ';
+            else out << *c;
+        }
+        out << '"';
+    }
+
+    void Profiler::start(size_t capacity) {
+        {
+            std::lock_guard<std::mutex> guard(registry_mu);
+            buffer_capacity = std::max<size_t>(capacity, 1);
+            capture_start_ns = Time::nowNS();
+        }
+        // Buffers start over the next time their thread records
+        capture_.fetch_add(1, std::memory_order_acq_rel);
+        capturing_.store(true, std::memory_order_release);
+    }
+
+    void Profiler::stop() {
+        capturing_.store(false, std::memory_order_release);
+    }
+
+    void Profiler::setThreadName(const string& name) {
+        ProfileBuffer& local = buffer();
+        std::lock_guard<std::mutex> guard(registry_mu);
+        local.name = name;
+    }
+
+    void Profiler::record(const char* name, int64_t start_ns, int64_t end_ns, uint32_t depth) {
+        if (!isCapturing()) return;
+        ProfileBuffer& local = buffer();
+
+        // Only this thread writes to its buffer, so it clears the last capture itself
+        uint32_t capture = capture_.load(std::memory_order_acquire);
+        if (local.capture.load(std::memory_order_relaxed) != capture) {
+            std::lock_guard<std::mutex> guard(registry_mu);
+            if (local.events.empty()) local.events.resize(buffer_capacity);
+            local.count.store(0, std::memory_order_relaxed);
+            local.dropped.store(0, std::memory_order_relaxed);
+            local.capture.store(capture, std::memory_order_release);
+        }
+
+        size_t index = local.count.load(std::memory_order_relaxed);
+        if (index >= local.events.size()) {
+            local.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        local.events[index] = ProfileEvent{ name, start_ns, end_ns, depth };
+        local.count.store(index + 1, std::memory_order_release);
+    }
+
+    std::vector<ProfileEvent> Profiler::events() {
+        std::vector<ProfileEvent> events;
+        forEachBuffer([&events](const ProfileBuffer& buffer, size_t count) {
+            events.insert(events.end(), buffer.events.begin(), buffer.events.begin() + count);
+        }, capture_.load(std::memory_order_acquire));
+        return events;
+    }
+
+    uint64_t Profiler::recorded() {
+        uint64_t recorded = 0;
+        forEachBuffer([&recorded](const ProfileBuffer& buffer, size_t count) {
+            recorded += count;
+        }, capture_.load(std::memory_order_acquire));
+        return recorded;
+    }
+
+    uint64_t Profiler::dropped() {
+        uint64_t dropped = 0;
+        forEachBuffer([&dropped](const ProfileBuffer& buffer, size_t count) {
+            dropped += buffer.dropped.load(std::memory_order_relaxed);
+        }, capture_.load(std::memory_order_acquire));
+        return dropped;
+    }
+
+    void Profiler::writeTrace(std::ostream& out) {
+        int64_t origin;
+        {
+            std::lock_guard<std::mutex> guard(registry_mu);
+            origin = capture_start_ns;
+        }
+        bool first = true;
+        auto separate = [&out, &first]() {
+            out << (first ? "\n" : ",\n");
+            first = false;
+        };
+
+        // Timestamps are in microseconds, written to the nanosecond
+        std::ios::fmtflags flags = out.flags();
+        std::streamsize precision = out.precision();
+        out << std::fixed << std::setprecision(3);
+        out << "{\"traceEvents\":[";
+        forEachBuffer([&](const ProfileBuffer& buffer, size_t count) {
+            if (!buffer.name.empty()) {
+                separate();
+                out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.id << ",\"args\":{\"name\":";
+                writeJsonString(out, buffer.name.c_str());
+                out << "}}";
+            }
+            // Complete events, which viewers stack by their times on each thread
+            for (size_t i = 0; i < count; i++) {
+                const ProfileEvent& event = buffer.events[i];
+                separate();
+                out << "{\"name\":";
+                writeJsonString(out, event.name);
+                out << ",\"cat\":\"engine\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.id
+                    << ",\"ts\":" << (event.start_ns - origin) / 1000.0
+                    << ",\"dur\":" << (event.end_ns - event.start_ns) / 1000.0 << "}";
+            }
+        }, capture_.load(std::memory_order_acquire));
+        out << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+    bool Profiler::writeTrace(const string& path) {
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+        if (!file.is_open()) {
+            ENGINE_WARN("Could not open profile trace {0}.", path);
+            return false;
+        }
+        writeTrace(file);
+        return true;
+    }
+
+    void Profiler::report(std::ostream& out) {
+        /** The times of every scope with a name. */
+        struct Totals {
+            int64_t total_ns = 0;
+            uint64_t count = 0;
+            uint32_t depth = ~0u;
+        };
+        std::map<string, Totals> totals;
+        for (const ProfileEvent& event : events()) {
+            Totals& entry = totals[event.name];
+            entry.total_ns += event.end_ns - event.start_ns;
+            entry.count++;
+            entry.depth = std::min(entry.depth, event.depth);
+        }
+
+        std::vector<std::pair<string, Totals>> sorted(totals.begin(), totals.end());
+        std::sort(sorted.begin(), sorted.end(), [](const std::pair<string, Totals>& a, const std::pair<string, Totals>& b) {
+            return a.second.total_ns > b.second.total_ns;
+        });
+        out << "Profile: " << recorded() << " scopes, " << dropped() << " dropped" << std::endl;
+        for (const std::pair<string, Totals>& entry : sorted) {
+            out << string(2 + 2 * std::min(entry.second.depth, 16u), ' ') << entry.first << ": "
+                << entry.second.total_ns / 1000000.0 << " ms over " << entry.second.count << " calls, mean "
+                << entry.second.total_ns / 1000.0 / entry.second.count << " us" << std::endl;
+        }
+    }
+
+    ProfileBuffer& Profiler::buffer() {
+        if (local_buffer == nullptr) {
+            std::lock_guard<std::mutex> guard(registry_mu);
+            registry.emplace_back(new ProfileBuffer(static_cast<uint32_t>(registry.size() + 1)));
+            local_buffer = registry.back().get();
+        }
+        return *local_buffer;
+    }
+
+}
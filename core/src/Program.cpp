@@ -3,9 +3,8 @@
 namespace seedengine {
 
     Program::Program() {
-        renderer_ = Renderer(RenderOptions());
         // Bind onClose event deligate
-        EventDispatcher::registerDeligate(WindowCloseEvent::EVENT_ID, [this](Event& e) {
+        close_subscription_ = EventDispatcher::subscribe(WindowCloseEvent::EVENT_ID, [this](Event& e) {
             this->onClose(static_cast<WindowCloseEvent&>(e));
         });
     }
@@ -17,8 +16,10 @@ namespace seedengine {
     void Program::run(int* exit_code) {
         ENGINE_DEBUG("Main loop running.");
         ENGINE_DEBUG("Waiting for game to be loaded...");
-        while (this->getGame() == nullptr && !this->shouldAbort() && !this->shouldExit()) {
-
+        {
+            // Sleep until loadGame(), abort() or exit() signals
+            std::unique_lock<std::mutex> lock(mu);
+            game_loaded_.wait(lock, [this]() { return game_ != nullptr || abort_flag_ || exit_flag_; });
         }
         if (this->shouldAbort()) {
             *exit_code = this->abort_code_;
@@ -31,75 +32,255 @@ namespace seedengine {
             return;
         }
 
+        // Config subscriptions made during execution
+        std::vector<unsigned int> subscriptions;
+
+        // Simulate the next frame on a second thread while the current one renders
+        bool pipelined = util::DEFAULTS.getBool("Engine", "pipelined");
+
+        // The thread that runs the events is chosen once, before any other engine thread starts,
+        // and other threads push through the event channel. When pipelined, the simulation thread
+        // runs the events, and waits here until the main loop hands it the simulation.
+        std::mutex handoff_mu;
+        std::condition_variable handoff_cv;
+        std::function<void()> simulation_body;
+        bool simulation_stopped = false;
+        std::thread simulation;
+        if (pipelined) {
+            simulation = std::thread([&]() {
+                std::function<void()> body;
+                {
+                    std::unique_lock<std::mutex> lock(handoff_mu);
+                    handoff_cv.wait(lock, [&]() { return simulation_body || simulation_stopped; });
+                    body.swap(simulation_body);
+                }
+                if (body) body();
+            });
+            EventDispatcher::setDispatchThread(simulation.get_id());
+        }
+        else EventDispatcher::setDispatchThread();
+
+        // Stops the simulation thread, whether or not it was handed the simulation
+        auto stopSimulation = [&]() {
+            if (!simulation.joinable()) return;
+            {
+                std::lock_guard<std::mutex> guard(handoff_mu);
+                simulation_stopped = true;
+            }
+            handoff_cv.notify_all();
+            // Wake the simulation if it is waiting to publish
+            exchange_.close();
+            simulation.join();
+        };
+
         try {
 
             ENGINE_DEBUG("Starting program clock");
             // Set the starting time for the Time class
             Time::start();
 
+            // Start the job system, with this thread helping while it waits on jobs
+            jobs::start(static_cast<unsigned int>(util::DEFAULTS.getInt("Engine", "worker_threads")));
+            ENGINE_INFO("Job system running with {0} worker threads.", jobs::workerCount());
+
+            // Capture a trace of the start up and the first frames
+            string profile_trace = util::DEFAULTS.getString("Debug", "profile_trace");
+            uint64_t profile_frames = static_cast<uint64_t>(std::max(util::DEFAULTS.getInt("Debug", "profile_frames"), 0));
+            Profiler::setThreadName("Program");
+            if (!profile_trace.empty()) {
+            #if ENGINE_PROFILE
+                Profiler::start();
+            #else
+                ENGINE_WARN("Profile trace {0} is not written, as the engine was built without ENGINE_PROFILE.", profile_trace);
+            #endif
+            }
+            auto writeProfile = [&]() {
+                if (!Profiler::isCapturing()) return;
+                Profiler::stop();
+                if (Profiler::writeTrace(profile_trace)) {
+                    ENGINE_INFO("Wrote {0} profile scopes to {1}, {2} dropped.", Profiler::recorded(), profile_trace, Profiler::dropped());
+                }
+            };
+
+            // Run without a window or graphics, such as for tests and benchmarks on a server
+            headless_ = util::DEFAULTS.getBool("Engine", "headless");
+            std::unique_ptr<HeadlessRenderer> headless_renderer;
+
             ENGINE_DEBUG("Initializing program window and input.");
             // Spawn window
-            Window* window = Window::create();
+            Window* window = headless_ ? nullptr : Window::create();
 
-            if (window == nullptr) {
+            if (window == nullptr && !headless_) {
                 ENGINE_ERROR("Failed to create window.");
+                stopSimulation();
+                jobs::stop();
+                EventDispatcher::setDispatchThread();
                 abort();
                 *exit_code = this->abort_code_;
                 ENGINE_ERROR("Program aborted. Exiting exection thread.");
                 return;
             }
 
+            // Reload defaults.ini while running, changes are dispatched at the frame boundaries of
+            // the simulation. The window belongs to this thread, so its changes are applied here.
+            int watch_interval = util::DEFAULTS.getInt("Config", "watch_interval_ms");
+            if (watch_interval > 0) util::DEFAULTS.watch(watch_interval);
+            std::atomic<bool> vsync_changed(false), size_changed(false);
+            if (window != nullptr) {
+                subscriptions.push_back(util::DEFAULTS.subscribe("Window", "vsync", [&vsync_changed]() { vsync_changed = true; }));
+                auto resize = [&size_changed]() { size_changed = true; };
+                subscriptions.push_back(util::DEFAULTS.subscribe("Window", "windowed_width", resize));
+                subscriptions.push_back(util::DEFAULTS.subscribe("Window", "windowed_height", resize));
+            }
+            auto applyWindowChanges = [&]() {
+                if (window == nullptr) return;
+                if (vsync_changed.exchange(false)) window->setVSync(util::DEFAULTS.getBool("Window", "vsync"));
+                if (size_changed.exchange(false)) {
+                    window->resize(
+                        static_cast<unsigned int>(util::DEFAULTS.getInt("Window", "windowed_width")),
+                        static_cast<unsigned int>(util::DEFAULTS.getInt("Window", "windowed_height")));
+                }
+            };
+
             string icon_path;
             util::DEFAULTS.get("Window", "icon_path", icon_path);
             string core_icon = CORE_PATH("") + icon_path;
 
             {
+                ENGINE_PROFILE_SCOPE("Program::indexAssets");
+                ENGINE_INFO("Indexing assets...");
+                // Index asset files once so existence checks do not touch the disk
+                string manifest_path, scan_path;
+                util::DEFAULTS.get("Assets", "manifest_path", manifest_path);
+                util::DEFAULTS.get("Assets", "scan_path", scan_path);
+                if (!AssetManifest::load(CORE_PATH("") + manifest_path)) {
+                    AssetManifest::scan(CORE_PATH("") + scan_path);
+                }
+                ENGINE_INFO("Asset manifest indexed {0} files.", AssetManifest::count());
+            }
+
+            {
+                // Choose how much of each asset stays in CPU memory after upload
+                string mesh_residency, image_residency;
+                util::DEFAULTS.get("Assets", "mesh_residency", mesh_residency);
+                util::DEFAULTS.get("Assets", "image_residency", image_residency);
+                AssetLibrary<Mesh>::setDefaultResidency(residencyFromString(mesh_residency));
+                AssetLibrary<Image>::setDefaultResidency(residencyFromString(image_residency));
+            }
+
+            if (headless_) {
+                // Meshes and images are uploaded to the GPU when loaded, so none are loaded
+                renderer_.setEnabled(false);
+                headless_renderer.reset(new HeadlessRenderer());
+                string headless_record = util::DEFAULTS.getString("Engine", "headless_record");
+                if (!headless_record.empty() && !headless_renderer->record(headless_record)) {
+                    ENGINE_WARN("Failed to open {0} to record headless frames.", headless_record);
+                }
+                ENGINE_INFO("Running headless.");
+            }
+            else {
+                ENGINE_PROFILE_SCOPE("Program::loadAssets");
                 ENGINE_INFO("Loading assets...");
                 // Set window icon
                 AssetLibrary<Image>::load(core_icon);
                 window->setIcon(AssetLibrary<Image>::request(core_icon));
+                AssetLibrary<Image>::request(core_icon)->releaseData();
 
                 AssetLibrary<Mesh>::load(CORE_PATH("data/assets/models/primatives/quad.mesh"));
                 //AssetLibrary<Mesh>::load(CORE_PATH("data/assets/models/primatives/triangle.mesh"));
                 AssetLibrary<Mesh>::load(CORE_PATH("data/assets/models/primatives/cube.mesh"));
                 ENGINE_INFO("Assets loaded.");
+                ENGINE_INFO("Asset CPU memory: {0} bytes resident, {1} bytes released by residency policies.",
+                    AssetLibrary<Mesh>::residentBytes() + AssetLibrary<Image>::residentBytes(),
+                    AssetLibrary<Mesh>::savedBytes() + AssetLibrary<Image>::savedBytes());
+                ENGINE_INFO("Asset manifest avoided {0} filesystem probes.", AssetManifest::probesAvoided());
             }
 
             // The time in ms between each frame.
             float delta_time;
-            // Stores time information for frame update loop
-            float accumulator = 0.0f;
-            // Controls the time between updates.
-            float update_interval = 1000.0f / this->TARGET_UPS;
-            // Controls the time between frame renders.
-            float render_interval = 1000.0f / this->TARGET_FPS;
+            // Splits the frame time into fixed updates
+            timestep_.reset();
+
+            // Load game data into application, on the simulation thread when pipelined
+            auto loadGame = [&]() {
+                ENGINE_INFO("Loading game data.");
+                ENGINE_PROFILE_SCOPE("Program::loadGame");
+                EventDispatcher::force<EngineGameLoadEvent>();
+            };
+            if (!pipelined) loadGame();
+
+            // Record the event stream, or replay a recorded one as a repeatable benchmark
+            EventRecorder recorder;
+            EventReplay replay;
+            string record_path, replay_path;
+            util::DEFAULTS.get("Debug", "record_events", record_path);
+            util::DEFAULTS.get("Debug", "replay_events", replay_path);
+            bool replaying = !replay_path.empty() && replay.load(replay_path);
+            if (replaying) {
+                replay.setWindow(window);
+                ENGINE_INFO("Replaying {0} events over {1} frames from {2}.", replay.events(), replay.frames(), replay_path);
+            }
+            else if (!record_path.empty()) recorder.start(record_path);
+
+        #if ENGINE_PROFILE_DISPATCH
+            DispatchProfiler::setBudget(static_cast<uint64_t>(util::DEFAULTS.getInt("Debug", "dispatch_budget_us")) * 1000);
+        #endif
+
+            pacer_.setSpinMargin(static_cast<int64_t>(util::DEFAULTS.getInt("Engine", "pacer_spin_us")) * 1000);
+
+            exchange_.reset();
+
+            // Headless runs are paced to a frame rate, or step a fixed update per frame as fast as possible
+            double headless_rate = headless_ ? util::DEFAULTS.getFloat("Engine", "headless_rate") : 0.0;
+            bool fixed_step = headless_ && headless_rate <= 0.0;
+            uint64_t headless_frames = headless_ ? static_cast<uint64_t>(std::max(util::DEFAULTS.getInt("Engine", "headless_frames"), 0)) : 0;
 
-            ENGINE_INFO("Loading game data.");
-            // Load game data into application
-            EventDispatcher::force<EngineGameLoadEvent>();
+            // Runs the timers, events and ticks of a frame, then fills its render snapshot
+            auto simulate = [&]() -> bool {
+                ENGINE_PROFILE_SCOPE("Program::simulate");
 
-            ENGINE_INFO("Starting main loop...");
+                // Controls the time between updates.
+                float update_interval = 1000.0f / this->TARGET_UPS;
 
-            // Prepare for first loop iteration
-            Time::last_loop_time_ = Time::elapsedTimeMS();
+                // Measure the time since the last frame with the monotonic clock
+                Time::beginFrame();
+                if (fixed_step) {
+                    // Step exactly one update, so the run does not depend on how fast the machine is
+                    Time::delta_time_ = update_interval / 1000.0f * Time::getTimeScale();
+                    delta_time = update_interval;
+                }
+                else delta_time = Time::getDeltaTime() * 1000.0f;
 
-            // Main loop
-            while (!this->shouldAbort() && !this->shouldExit() && !window->shouldClose()) {
+                // Updates keep stepping while paused, so actors that cannot pause still tick
+                timestep_.setInterval(update_interval);
+                timestep_.setMaxSteps(MAX_UPF);
+                timestep_.setBudget(this->UPDATE_BUDGET);
+                timestep_.advance(fixed_step ? delta_time : Time::getStepTime() * 1000.0f);
 
-                delta_time = Time::getUpTime();
-                accumulator += delta_time;
+                RenderSnapshot& snapshot = exchange_.begin();
 
-                Time::delta_time_ = delta_time / 1000.0f;
+                // Call the timers that expired since the last frame, including delayed pushes
+                {
+                    ENGINE_PROFILE_SCOPE("Timers::advance");
+                    Timers::advance(delta_time);
+                }
+
+                // Push the recorded events of this frame
+                if (replaying && !replay.beginFrame()) {
+                    ENGINE_INFO("Replay complete: {0}.", replay.stats().summary());
+                    exit(0);
+                    return false;
+                }
 
                 // Handle event buffer and event dispatchers
                 EventDispatcher::run(0);
 
-                //ENGINE_DEBUG("DT {2} ACC {0} UP-INT {1}", accumulator, update_interval, delta_time);
-
-                int update_count = 0;
+                //ENGINE_DEBUG("DT {2} ACC {0} UP-INT {1}", timestep_.accumulator(), update_interval, delta_time);
 
-                // Manage update rate
-                while (accumulator >= update_interval && update_count < MAX_UPF) {
+                // Manage update rate, dropping the updates that do not fit in the frame
+                int64_t tick_start = Time::nowNS();
+                while (timestep_.step()) {
+                    ENGINE_PROFILE_SCOPE("Program::tick");
 
                     // Only update logic if the game is not paused
                     if (!Time::isPaused()) {
@@ -108,58 +289,268 @@ namespace seedengine {
                         //ENGINE_DEBUG("Update!");
                     }
 
+                    // Update components, keeping actors that cannot pause running while paused
+                    tick_scheduler_.tick(Time::isPaused());
+
                     this->current_ups_ = 1000.0f / update_interval;
-                    accumulator -= update_interval;
-                    update_count++;
                 }
-
-
+                timestep_.endFrame();
+                stats_.record(FrameStage::TICK, Time::nowNS() - tick_start);
+
+                // Copy the state needed to render the frame, between the last two updates
+                snapshot.setAlpha(static_cast<float>(timestep_.alpha()));
+                EventDispatcher::force<EngineSnapshotEvent>(snapshot);
+
+                return true;
+            };
+
+            // Schedules streamed assets on the simulation, handing the reads that finished over to upload
+            auto schedule = [&]() {
+                if (window == nullptr) return;
+                ENGINE_PROFILE_SCOPE("AssetStreamer::schedule");
+                streamer_.schedule();
+            };
+
+            // Uploads the streamed assets handed over, which needs the graphics context of this thread
+            auto upload = [&]() {
+                if (window == nullptr) return;
+                ENGINE_PROFILE_SCOPE("AssetStreamer::upload");
+                streamer_.upload();
+            };
+
+            // Renders a snapshot. The renderer is handed the snapshot directly, and render events are
+            // forced here when this is the dispatch thread, or pushed to it by pushRenderEvents().
+            auto present = [&](const RenderSnapshot& snapshot) {
+                ENGINE_PROFILE_SCOPE("Program::present");
+                bool dispatch = EventDispatcher::isDispatchThread();
 
                 // Run pre-render logic
 
-                EventDispatcher::force<EnginePreRenderEvent>();
+                int64_t stage_start = Time::nowNS();
+                renderer_.prepare();
+                if (dispatch) EventDispatcher::force<EnginePreRenderEvent>(snapshot.frame());
+                int64_t stage_end = Time::nowNS();
+                stats_.record(FrameStage::PRE_RENDER, stage_end - stage_start);
 
                 // Run render pass
 
-                EventDispatcher::force<EngineRenderEvent>();
+                stage_start = stage_end;
+                if (headless_renderer) headless_renderer->render(snapshot);
+                else renderer_.render(&snapshot);
+                if (dispatch) EventDispatcher::force<EngineRenderEvent>(&snapshot, snapshot.frame());
 
                 // Run post-render logic
 
-                EventDispatcher::force<EnginePostRenderEvent>();
-
-                // Update window
+                if (dispatch) EventDispatcher::force<EnginePostRenderEvent>(snapshot.frame());
+                stats_.record(FrameStage::RENDER, Time::nowNS() - stage_start);
+
+                // Stop once the requested number of headless frames has been rendered
+                if (headless_frames > 0 && exchange_.rendered() + 1 >= headless_frames) exit(0);
+            };
+
+            // Hands the render events of a frame to the simulation thread, which runs them at the start
+            // of its next frame. Pushes may wait for the simulation, so the snapshot must be released.
+            auto pushRenderEvents = [&](uint64_t frame) {
+                EventDispatcher::push<EnginePreRenderEvent>(frame);
+                EventDispatcher::push<EngineRenderEvent>(nullptr, frame);
+                EventDispatcher::push<EnginePostRenderEvent>(frame);
+            };
+
+            // Shows the rendered frame and polls the window. Input callbacks push events, which may
+            // wait for the simulation, so the snapshot must be released first.
+            auto swap = [&]() {
+                if (window == nullptr) return;
+                ENGINE_PROFILE_SCOPE("Window::update");
+                int64_t swap_start = Time::nowNS();
                 window->update();
+                stats_.record(FrameStage::SWAP, Time::nowNS() - swap_start);
+            };
+
+            // Waits out the rest of a frame when vsync is enabled, or headless at a set rate
+            auto pace = [&](int64_t frame_start) {
+                ENGINE_PROFILE_SCOPE("Program::pace");
+                if (window != nullptr && window->isVSync()) {
+                    int64_t loop_slot = static_cast<int64_t>(1000000000.0 / this->TARGET_FPS);
+                    pacer_.waitUntil(frame_start + loop_slot);
+                }
+                else if (headless_ && headless_rate > 0.0) {
+                    pacer_.waitUntil(frame_start + static_cast<int64_t>(1000000000.0 / headless_rate));
+                }
+            };
+
+            // Frame times are kept over a rolling window, and may be logged or written out as they come
+            stats_.reset(static_cast<size_t>(std::max(util::DEFAULTS.getInt("Stats", "window_frames"), 1)));
+            stats_.setHitchThreshold(static_cast<uint64_t>(std::max(util::DEFAULTS.getFloat("Stats", "hitch_ms"), 0.0f) * 1000000.0));
+            string stats_csv = util::DEFAULTS.getString("Stats", "csv_path");
+            if (!stats_csv.empty()) stats_.startCsv(stats_csv);
+            int64_t stats_log_ns = static_cast<int64_t>(util::DEFAULTS.getFloat("Stats", "log_interval_s") * 1000000000.0);
+            int64_t last_stats_log = Time::nowNS();
+            int64_t last_frame_start = -1;
+
+            // Steady state frames may be held to a number of allocations in each subsystem
+            int memory_frame_limit = util::DEFAULTS.getInt("Debug", "memory_frame_limit");
+            uint64_t memory_warmup_frames = static_cast<uint64_t>(std::max(util::DEFAULTS.getInt("Debug", "memory_warmup_frames"), 1));
+
+            // Ends the frame before the one starting now in the stats
+            auto measure = [&](int64_t frame_start) {
+                if (last_frame_start >= 0) {
+                    stats_.endFrame(frame_start - last_frame_start);
+                    this->current_fps_ = static_cast<float>(stats_.fps());
+                }
+                last_frame_start = frame_start;
+                if (memory_frame_limit >= 0 && stats_.frames() >= memory_warmup_frames) {
+                    MemoryTracker::setFrameLimit(static_cast<uint64_t>(memory_frame_limit));
+                }
+                MemoryTracker::endFrame();
+                if (stats_log_ns > 0 && frame_start - last_stats_log >= stats_log_ns) {
+                    ENGINE_INFO("Frame stats: {0}.", stats_.summary());
+                    last_stats_log = frame_start;
+                }
+                if (profile_frames > 0 && stats_.frames() >= profile_frames) writeProfile();
+            };
 
-                this->current_fps_ = 1000.0f / delta_time;
+            ENGINE_INFO("Starting main loop{0}...", pipelined ? " with pipelined simulation" : "");
 
-                //ENGINE_DEBUG("FPS: {0}", this->current_fps_);
+            // Prepare for first loop iteration, so loading is not counted as frame time
+            Time::frame_start_ns_ = Time::nowNS();
+
+            if (!pipelined) {
+
+                // Main loop
+                while (!this->shouldAbort() && !this->shouldExit() && (window == nullptr || !window->shouldClose())) {
+
+                    measure(Time::nowNS());
+
+                    // Apply config changes at the frame boundary
+                    util::DEFAULTS.dispatchChanges();
+                    applyWindowChanges();
+
+                    if (!simulate()) break;
+
+                    // Render the frame just simulated
+                    schedule();
+                    upload();
+                    exchange_.publish();
+                    present(*exchange_.acquire());
+                    exchange_.release();
+                    swap();
+
+                    // Frames are timed before any vsync wait
+                    if (replaying) replay.endFrame();
+                    if (recorder.isRecording()) recorder.nextFrame();
+
+                    //ENGINE_DEBUG("FPS: {0}", this->current_fps_);
+
+                    // Sync time if vsync is enabled
+                    pace(Time::getFrameStartNS());
 
-                // Sync time if vsync is enabled
-                if (window->isVSync()) {
-                    //ENGINE_DEBUG("Applying VSync...");
-                    float loop_slot = 1000.0f / this->TARGET_FPS;
-                    float end_time = Time::getLastLoopTime() + loop_slot;
-                    while (Time::elapsedTimeMS().count() < end_time) {
-                        //ENGINE_DEBUG("Sleeping on main loop thread...");
-                        //std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                        //ENGINE_DEBUG("Main loop thread is awake.");
-                    }
                 }
 
             }
+            else {
+
+                // Hand the simulation to the thread that runs the events, the window and graphics context stay here
+                {
+                    std::lock_guard<std::mutex> guard(handoff_mu);
+                    simulation_body = [&]() {
+                        Profiler::setThreadName("Simulation");
+                        try {
+                            loadGame();
+                            while (!this->shouldAbort() && !this->shouldExit()) {
+                                // Apply config changes at the frame boundary, the window changes are left to the renderer
+                                util::DEFAULTS.dispatchChanges();
+
+                                if (!simulate()) break;
+                                schedule();
+                                if (!exchange_.publish()) break;
+
+                                // Frames are timed up to the hand off, as rendering overlaps the next frame
+                                if (replaying) replay.endFrame();
+                                if (recorder.isRecording()) recorder.nextFrame();
+                            }
+                        }
+                        catch (std::exception& e) {
+                            abort(-1, e.what());
+                        }
+                        exchange_.close();
+                    };
+                }
+                handoff_cv.notify_all();
+
+                // The simulation uses the locals of run(), so it is stopped before they unwind
+                try {
+
+                    // Render loop
+                    while (!this->shouldAbort() && !this->shouldExit() && (window == nullptr || !window->shouldClose())) {
 
-            ENGINE_INFO("Closing main window...");
-            // Close the window
-            window->close();
+                        int64_t render_start = Time::nowNS();
+                        measure(render_start);
 
-            ENGINE_DEBUG("Cleaning up memory...");
-            // Delete any consumed memory
-            delete window;
+                        // Apply the window changes dispatched by the simulation
+                        applyWindowChanges();
+
+                        // Render the last published frame while the simulation runs the next one
+                        const RenderSnapshot* snapshot = exchange_.acquire();
+                        if (snapshot == nullptr) break;
+                        uint64_t frame = snapshot->frame();
+                        present(*snapshot);
+                        exchange_.release();
+
+                        // The simulation may be waiting to publish until here, and pushing or uploading
+                        // may wait for it to drain the event channel, so they run once the snapshot is released
+                        pushRenderEvents(frame);
+
+                        // Upload the streamed assets handed over by the simulation between frames
+                        upload();
+                        swap();
+
+                        // Sync time if vsync is enabled
+                        pace(render_start);
+
+                    }
+
+                }
+                catch (...) {
+                    stopSimulation();
+                    throw;
+                }
+                stopSimulation();
+
+            }
+
+            writeProfile();
+
+            if (tick_scheduler_.tickTimes().count() > 0) ENGINE_INFO("Component ticks: {0}.", tick_scheduler_.summary());
+            if (stats_.frames() > 0) ENGINE_INFO("Frame stats: {0}.", stats_.summary());
+            stats_.stopCsv();
+            if (timestep_.steps() > 0) ENGINE_INFO("Fixed timestep: {0}.", timestep_.summary());
+            if (exchange_.rendered() > 0) ENGINE_INFO("Frame pipeline: {0}.", exchange_.summary());
+            if (pacer_.errors().count() > 0) ENGINE_INFO("Frame pacing: {0}.", pacer_.summary());
+            if (headless_renderer) ENGINE_INFO("Headless frames: {0}.", headless_renderer->summary());
+            ENGINE_INFO("Memory: {0}.", MemoryTracker::summary());
+
+            if (window != nullptr) {
+                ENGINE_INFO("Closing main window...");
+                // Close the window
+                window->close();
+
+                ENGINE_DEBUG("Cleaning up memory...");
+                // Delete any consumed memory
+                delete window;
+            }
 
         }
         catch (std::exception& e) {
             abort(-1, e.what());
         }
+        stopSimulation();
+
+    #if ENGINE_PROFILE_DISPATCH
+        DispatchProfiler::report(util::DEFAULTS.getString("Debug", "dispatch_report"));
+    #endif
+
+        for (unsigned int subscription : subscriptions) util::DEFAULTS.unsubscribe(subscription);
+        util::DEFAULTS.unwatch();
 
         if (this->shouldAbort()) {
             *exit_code = this->abort_code_;
@@ -170,6 +561,17 @@ namespace seedengine {
             ENGINE_INFO("Execution complete. Exiting execution thread.");
         }
 
+        // Finish the queued jobs before the assets they may use are unloaded
+        jobs::stop();
+
+        // Every engine thread has stopped, so this thread takes the events back and runs those left
+        // over, such as the render events of the last pipelined frames
+        EventDispatcher::setDispatchThread();
+        EventDispatcher::run(0);
+
+        // Drop the timers left over from this run
+        Timers::clear();
+
         AssetLibrary<Mesh>::unloadAll();
         AssetLibrary<Image>::unloadAll();
 
@@ -182,6 +584,7 @@ namespace seedengine {
         std::lock_guard<std::mutex> gaurd(mu);
         this->abort_code_ = error;
         this->abort_flag_ = true;
+        game_loaded_.notify_all();
         if (msg != "") ENGINE_ERROR("Aborting program: " + msg);
         else ENGINE_ERROR("Aborting program...");
     }
@@ -190,6 +593,7 @@ namespace seedengine {
         std::lock_guard<std::mutex> gaurd(mu);
         this->exit_code_ = exit_code;
         this->exit_flag_ = true;
+        game_loaded_.notify_all();
         ENGINE_INFO("Exiting program...");
     }
 
@@ -198,6 +602,7 @@ namespace seedengine {
         ENGINE_INFO("Loading Game...");
         if (this->game_ == nullptr) {
             this->game_ = new int(0);
+            game_loaded_.notify_all();
         }
         else {
             ENGINE_WARN("A game has already been loaded to the program. Aborting current application, relaunching with new game.");
@@ -0,0 +1,418 @@
+#include "Record.hpp"
+
+namespace seedengine {
+
+    namespace {
+
+        using util::BinaryWriter;
+        using util::BinaryReader;
+
+        /** Writes a button state as a single byte. */
+        inline void writeState(BinaryWriter& out, input::ButtonState state) {
+            out.write(static_cast<uint8_t>(state));
+        }
+
+        /** Reads a button state written by writeState(). */
+        inline bool readState(BinaryReader& in, input::ButtonState& state) {
+            uint8_t value;
+            if (!in.read(value)) return false;
+            state = static_cast<input::ButtonState>(value);
+            return true;
+        }
+
+        /** Reads an unsigned integer written as a varint. */
+        inline bool readUint(BinaryReader& in, unsigned int& out) {
+            uint64_t value;
+            if (!in.readVarint(value)) return false;
+            out = static_cast<unsigned int>(value);
+            return true;
+        }
+
+        /** Writes the fields of events that only carry their window. */
+        void writeNothing(const Event& e, BinaryWriter& out) {}
+
+        /** Registers the codecs of the input and window events. */
+        void registerEngineCodecs() {
+
+            // Mouse
+
+            EventRecorder::registerCodec<MouseMovedEvent>(
+                [](const Event& e, BinaryWriter& out) {
+                    const MouseMovedEvent& event = static_cast<const MouseMovedEvent&>(e);
+                    out.write(event.x());
+                    out.write(event.y());
+                },
+                [](BinaryReader& in, Window* window) {
+                    float x, y;
+                    if (!in.read(x) || !in.read(y)) return false;
+                    EventDispatcher::push<MouseMovedEvent>(x, y);
+                    return true;
+                });
+            EventRecorder::registerCodec<MouseButtonEvent>(
+                [](const Event& e, BinaryWriter& out) {
+                    const MouseButtonEvent& event = static_cast<const MouseButtonEvent&>(e);
+                    out.writeVarint(event.buttonId());
+                    writeState(out, event.state());
+                    out.writeVarint(event.mods());
+                },
+                [](BinaryReader& in, Window* window) {
+                    unsigned int button, mods;
+                    input::ButtonState state;
+                    if (!readUint(in, button) || !readState(in, state) || !readUint(in, mods)) return false;
+                    EventDispatcher::push<MouseButtonEvent>(button, state, mods);
+                    return true;
+                });
+            EventRecorder::registerCodec<MouseScrolledEvent>(
+                [](const Event& e, BinaryWriter& out) {
+                    const MouseScrolledEvent& event = static_cast<const MouseScrolledEvent&>(e);
+                    out.write(event.x_offset());
+                    out.write(event.y_offset());
+                },
+                [](BinaryReader& in, Window* window) {
+                    float x, y;
+                    if (!in.read(x) || !in.read(y)) return false;
+                    EventDispatcher::push<MouseScrolledEvent>(x, y);
+                    return true;
+                });
+
+            // Keyboard
+
+            EventRecorder::registerCodec<KeyboardEvent>(
+                [](const Event& e, BinaryWriter& out) {
+                    const KeyboardEvent& event = static_cast<const KeyboardEvent&>(e);
+                    out.writeVarint(event.keycode());
+                    out.writeVarint(event.repeat());
+                    writeState(out, event.state());
+                    out.writeVarint(event.mods());
+                },
+                [](BinaryReader& in, Window* window) {
+                    unsigned int keycode, repeat, mods;
+                    input::ButtonState state;
+                    if (!readUint(in, keycode) || !readUint(in, repeat) || !readState(in, state) || !readUint(in, mods)) return false;
+                    EventDispatcher::push<KeyboardEvent>(keycode, repeat, state, mods);
+                    return true;
+                });
+
+            // Controller
+
+            EventRecorder::registerCodec<ControllerButtonEvent>(
+                [](const Event& e, BinaryWriter& out) {
+                    const ControllerButtonEvent& event = static_cast<const ControllerButtonEvent&>(e);
+                    out.writeVarint(event.controllerId());
+                    out.writeVarint(event.buttonId());
+                    writeState(out, event.state());
+                },
+                [](BinaryReader& in, Window* window) {
+                    unsigned int controller, button;
+                    input::ButtonState state;
+                    if (!readUint(in, controller) || !readUint(in, button) || !readState(in, state)) return false;
+                    EventDispatcher::push<ControllerButtonEvent>(controller, button, state);
+                    return true;
+                });
+            EventRecorder::registerCodec<ControllerAxisEvent>(
+                [](const Event& e, BinaryWriter& out) {
+                    const ControllerAxisEvent& event = static_cast<const ControllerAxisEvent&>(e);
+                    out.writeVarint(event.controllerId());
+                    out.writeVarint(event.axisId());
+                    out.write(event.x());
+                    out.write(event.y());
+                },
+                [](BinaryReader& in, Window* window) {
+                    unsigned int controller, axis;
+                    float x, y;
+                    if (!readUint(in, controller) || !readUint(in, axis) || !in.read(x) || !in.read(y)) return false;
+                    EventDispatcher::push<ControllerAxisEvent>(controller, axis, x, y);
+                    return true;
+                });
+
+            // Window
+
+            EventRecorder::registerCodec<WindowResizeEvent>(
+                [](const Event& e, BinaryWriter& out) {
+                    const WindowResizeEvent& event = static_cast<const WindowResizeEvent&>(e);
+                    out.writeVarint(event.width());
+                    out.writeVarint(event.height());
+                },
+                [](BinaryReader& in, Window* window) {
+                    unsigned int width, height;
+                    if (!readUint(in, width) || !readUint(in, height)) return false;
+                    EventDispatcher::push<WindowResizeEvent>(window, width, height);
+                    return true;
+                });
+            EventRecorder::registerCodec<WindowPositionEvent>(
+                [](const Event& e, BinaryWriter& out) {
+                    const WindowPositionEvent& event = static_cast<const WindowPositionEvent&>(e);
+                    out.writeVarint(event.x());
+                    out.writeVarint(event.y());
+                },
+                [](BinaryReader& in, Window* window) {
+                    unsigned int x, y;
+                    if (!readUint(in, x) || !readUint(in, y)) return false;
+                    EventDispatcher::push<WindowPositionEvent>(window, x, y);
+                    return true;
+                });
+            EventRecorder::registerCodec<WindowFocusEvent>(
+                [](const Event& e, BinaryWriter& out) {
+                    out.write(static_cast<uint8_t>(static_cast<const WindowFocusEvent&>(e).hasFocus()));
+                },
+                [](BinaryReader& in, Window* window) {
+                    uint8_t focus;
+                    if (!in.read(focus)) return false;
+                    EventDispatcher::push<WindowFocusEvent>(window, focus != 0);
+                    return true;
+                });
+            EventRecorder::registerCodec<WindowMinimizeEvent>(
+                [](const Event& e, BinaryWriter& out) {
+                    out.write(static_cast<uint8_t>(static_cast<const WindowMinimizeEvent&>(e).minimized()));
+                },
+                [](BinaryReader& in, Window* window) {
+                    uint8_t minimized;
+                    if (!in.read(minimized)) return false;
+                    EventDispatcher::push<WindowMinimizeEvent>(window, minimized != 0);
+                    return true;
+                });
+            EventRecorder::registerCodec<WindowMaximizeEvent>(
+                [](const Event& e, BinaryWriter& out) {
+                    out.write(static_cast<uint8_t>(static_cast<const WindowMaximizeEvent&>(e).maximized()));
+                },
+                [](BinaryReader& in, Window* window) {
+                    uint8_t maximized;
+                    if (!in.read(maximized)) return false;
+                    EventDispatcher::push<WindowMaximizeEvent>(window, maximized != 0);
+                    return true;
+                });
+            EventRecorder::registerCodec<WindowConentScaleEvent>(
+                [](const Event& e, BinaryWriter& out) {
+                    const WindowConentScaleEvent& event = static_cast<const WindowConentScaleEvent&>(e);
+                    out.write(event.x_scale());
+                    out.write(event.y_scale());
+                },
+                [](BinaryReader& in, Window* window) {
+                    float x, y;
+                    if (!in.read(x) || !in.read(y)) return false;
+                    EventDispatcher::push<WindowConentScaleEvent>(window, x, y);
+                    return true;
+                });
+            EventRecorder::registerCodec<WindowCloseEvent>(writeNothing,
+                [](BinaryReader& in, Window* window) {
+                    EventDispatcher::push<WindowCloseEvent>(window);
+                    return true;
+                });
+            EventRecorder::registerCodec<WindowRefreshEvent>(writeNothing,
+                [](BinaryReader& in, Window* window) {
+                    EventDispatcher::push<WindowRefreshEvent>(window);
+                    return true;
+                });
+        }
+
+        /**
+         * @brief Returns the codec of each event, indexed by event ID.
+         *
+         * @return std::vector<EventCodec>& The registered codecs.
+         */
+        std::vector<EventCodec>& codecs() {
+            static std::vector<EventCodec> table;
+            static bool registered = false;
+            if (!registered) {
+                registered = true;
+                registerEngineCodecs();
+            }
+            return table;
+        }
+
+    }
+
+    // Event Recorder
+
+    void EventRecorder::registerCodec(unsigned int event_id, EventCodec codec) {
+        std::vector<EventCodec>& table = codecs();
+        if (event_id >= table.size()) table.resize(event_id + 1);
+        table[event_id] = codec;
+    }
+
+    const EventCodec* EventRecorder::codecFor(unsigned int event_id) {
+        std::vector<EventCodec>& table = codecs();
+        if (event_id >= table.size() || table[event_id].write == nullptr) return nullptr;
+        return &table[event_id];
+    }
+
+    EventRecorder::~EventRecorder() {
+        stop();
+    }
+
+    bool EventRecorder::start(const string& path) {
+        stop();
+        file_.open(path, std::ios::binary | std::ios::trunc);
+        if (!file_.is_open()) {
+            ENGINE_WARN("Could not open event log {0} for recording.", path);
+            return false;
+        }
+        buffer_.clear();
+        uint32_t magic = MAGIC;
+        buffer_.write(magic);
+        buffer_.writeVarint(VERSION);
+        start_ = std::chrono::steady_clock::now();
+        frame_ = 0;
+        last_frame_ = 0;
+        last_time_ = 0;
+        recorded_ = 0;
+        skipped_ = 0;
+        EventDispatcher::setObserver([this](Event& e) { this->record(e); });
+        ENGINE_INFO("Recording events to {0}.", path);
+        return true;
+    }
+
+    void EventRecorder::stop() {
+        if (!file_.is_open()) return;
+        EventDispatcher::setObserver(EventDeligate());
+        // The end record holds the number of frames, as the last frames may have no events
+        uint64_t time = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start_).count());
+        buffer_.writeVarint(frame_ - last_frame_);
+        buffer_.writeVarint(time - last_time_);
+        buffer_.writeVarint(0);
+        flush();
+        file_.close();
+        ENGINE_INFO("Recorded {0} events over {1} frames, skipped {2} events without a codec.", recorded_, frame_, skipped_);
+    }
+
+    void EventRecorder::nextFrame() {
+        frame_++;
+        if (buffer_.size() >= FLUSH_SIZE) flush();
+    }
+
+    void EventRecorder::record(const Event& e) {
+        unsigned int event_id = e.getId();
+        const EventCodec* codec = codecFor(event_id);
+        if (codec == nullptr) {
+            skipped_++;
+            return;
+        }
+        uint64_t time = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start_).count());
+        payload_.clear();
+        codec->write(e, payload_);
+        const std::vector<uint8_t>& payload = payload_.data();
+        buffer_.writeVarint(frame_ - last_frame_);
+        buffer_.writeVarint(time - last_time_);
+        buffer_.writeVarint(event_id);
+        buffer_.writeVarint(payload.size());
+        buffer_.writeBytes(payload.data(), payload.size());
+        last_frame_ = frame_;
+        last_time_ = time;
+        recorded_++;
+    }
+
+    void EventRecorder::flush() {
+        const std::vector<uint8_t>& data = buffer_.data();
+        file_.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        buffer_.clear();
+    }
+
+    // Replay Stats
+
+    string ReplayStats::summary() const {
+        std::ostringstream out;
+        out << frames << " frames, " << events << " events, mean " << mean_ms << " ms, p50 " << p50_ms
+            << " ms, p99 " << p99_ms << " ms, max " << max_ms << " ms, total " << total_ms << " ms";
+        return out.str();
+    }
+
+    // Event Replay
+
+    bool EventReplay::load(const string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            ENGINE_WARN("Could not open event log {0} for replay.", path);
+            return false;
+        }
+        data_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        records_.clear();
+        frames_ = 0;
+
+        util::BinaryReader reader(data_);
+        uint32_t magic;
+        uint64_t version;
+        if (!reader.read(magic) || magic != EventRecorder::MAGIC || !reader.readVarint(version) || version > EventRecorder::VERSION) {
+            ENGINE_WARN("{0} is not an event log this build can replay.", path);
+            data_.clear();
+            return false;
+        }
+
+        uint64_t frame = 0;
+        bool ended = false;
+        while (reader.position() < data_.size()) {
+            uint64_t frame_delta, time_delta, event_id, size;
+            if (!reader.readVarint(frame_delta) || !reader.readVarint(time_delta) || !reader.readVarint(event_id)) break;
+            frame += frame_delta;
+            if (event_id == 0) {
+                ended = true;
+                break;
+            }
+            if (!reader.readVarint(size)) break;
+            Record record;
+            record.frame = frame;
+            record.event_id = static_cast<unsigned int>(event_id);
+            record.offset = reader.position();
+            record.size = static_cast<size_t>(size);
+            // The fields are read when the event is replayed
+            if (!reader.skipBytes(record.size)) break;
+            records_.push_back(record);
+        }
+        frames_ = frame;
+        if (!ended) {
+            // A log cut short by a crash still replays up to its last event
+            ENGINE_WARN("Event log {0} is incomplete, replaying the first {1} events.", path, records_.size());
+            if (!records_.empty()) frames_ = records_.back().frame + 1;
+        }
+        rewind();
+        return true;
+    }
+
+    bool EventReplay::beginFrame() {
+        if (frame_ >= frames_) return false;
+        while (cursor_ < records_.size() && records_[cursor_].frame == frame_) {
+            const Record& record = records_[cursor_++];
+            const EventCodec* codec = EventRecorder::codecFor(record.event_id);
+            if (codec == nullptr || codec->replay == nullptr) continue;
+            util::BinaryReader reader(data_.data() + record.offset, record.size);
+            if (codec->replay(reader, window_)) replayed_++;
+        }
+        frame_start_ = std::chrono::steady_clock::now();
+        return true;
+    }
+
+    void EventReplay::endFrame() {
+        auto end = std::chrono::steady_clock::now();
+        frame_times_.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - frame_start_).count()));
+        frame_++;
+    }
+
+    ReplayStats EventReplay::run(const FrameFunction& frame) {
+        while (beginFrame()) {
+            frame(frame_);
+            endFrame();
+        }
+        return stats();
+    }
+
+    void EventReplay::rewind() {
+        frame_ = 0;
+        cursor_ = 0;
+        replayed_ = 0;
+        frame_times_.clear();
+    }
+
+    ReplayStats EventReplay::stats() const {
+        ReplayStats stats;
+        stats.frames = frame_times_.count();
+        stats.events = replayed_;
+        stats.total_ms = frame_times_.total() / 1000000.0;
+        stats.mean_ms = frame_times_.mean() / 1000000.0;
+        stats.p50_ms = frame_times_.percentile(0.5) / 1000000.0;
+        stats.p99_ms = frame_times_.percentile(0.99) / 1000000.0;
+        stats.max_ms = frame_times_.max() / 1000000.0;
+        return stats;
+    }
+
+}
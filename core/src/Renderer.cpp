@@ -9,19 +9,13 @@ namespace seedengine {
         depth_test_ = true;
 
         filled_texture_slots_ = 0;
-        
-        // Bind pre-render event deligate
-        EventDispatcher::registerDeligate(EnginePreRenderEvent::EVENT_ID, [this](Event & e) {
-            this->prepare(static_cast<EnginePreRenderEvent&>(e));
-        });
-
-        // Bind render event deligate
-        EventDispatcher::registerDeligate(EngineRenderEvent::EVENT_ID, [this](Event& e) {
-            this->render(static_cast<EngineRenderEvent&>(e));
-        });
     }
 
-    void Renderer::render(EngineRenderEvent& e) {
+    void Renderer::render(const RenderSnapshot* snapshot) {
+        ENGINE_PROFILE_SCOPE("Renderer::render");
+        MemoryTagScope memory_tag(MemoryTag::RENDER);
+        if (!enabled_) return;
+        snapshot_ = snapshot;
         unsigned int render_mode = static_cast<unsigned int>(options_.render_mode_);
         if (CHECK_FLAG(render_mode, RenderFlag::SURFACE)) {
             if (CHECK_FLAG(render_mode, RenderFlag::LIGHTING)) deferredRender();
@@ -33,9 +27,11 @@ namespace seedengine {
         if (options_.gui_flag_) guiRender();
 
         consoleRender();
+        snapshot_ = nullptr;
     }
 
-    void Renderer::prepare(EnginePreRenderEvent& e) {
+    void Renderer::prepare() {
+        if (!enabled_) return;
         if (depth_test_) enableDepthTest();
         else disableDepthTest();
 
@@ -150,8 +146,6 @@ namespace seedengine {
             #if ENGINE_GRAPHICS_API == ENGINE_GRAPHICS_OPGL
                 //ENGINE_DEBUG("OPGL Unlit Render");
                 
-                auto m = AssetLibrary<Mesh>::request(CORE_PATH("data/assets/models/primatives/cube.mesh"));
-
                 Shader* s = new Shader(
                     CORE_PATH("data/assets/shaders/test.vs.glsl"),
                     CORE_PATH("data/assets/shaders/test.fs.glsl"),
@@ -161,18 +155,53 @@ namespace seedengine {
                 
                 s->start();
 
-                Transform t(
-                    glm::vec3(0, 0, -5),
-                    glm::vec3(45, 45, 45),
-                    glm::vec3(1, 1, 1)
-                );
-                Camera cam = Camera(CameraProperties(CameraMode::PERSPECTIVE));
-                
+                if (snapshot_ != nullptr && snapshot_->drawCount() > 0) {
+                    // Draw the frame state handed over by the simulation
+                    s->loadUniform("projection_mat", snapshot_->projection());
+                    s->loadUniform("view_mat", snapshot_->view());
+                    for (const DrawItem& item : snapshot_->draws()) {
+                        s->loadUniform("transformation_mat", item.model);
+                        drawMesh(*item.mesh);
+                    }
+                }
+                else {
+                    // Nothing was submitted, so draw the test cube
+                    auto m = AssetLibrary<Mesh>::request(CORE_PATH("data/assets/models/primatives/cube.mesh"));
+
+                    Transform t(
+                        glm::vec3(0, 0, -5),
+                        glm::vec3(45, 45, 45),
+                        glm::vec3(1, 1, 1)
+                    );
+                    Camera cam = Camera(CameraProperties(CameraMode::PERSPECTIVE));
+
+                    s->loadUniform("transformation_mat", t.getTransformationMatrix());
+                    s->loadUniform("projection_mat", cam.getProjectionMatrix());
+                    s->loadUniform("view_mat", cam.getViewMatrix());
 
-                glBindVertexArray(m->vao_);
+                    drawMesh(*m);
+                }
+
+                s->stop();
+
+                delete s;
+
+            // Check for Vulkan
+            #elif ENGINE_GRAPHICS_API == ENGINE_GRAPHICS_VLKN
+            // Check for DirectX
+            #elif ENGINE_GRAPHICS_API == ENGINE_GRAPHICS_D3DX
+            // Check for Metal
+            #elif ENGINE_GRAPHICS_API == ENGINE_GRAPHICS_METL
+            #endif
+    }
+
+    void Renderer::drawMesh(const Mesh& mesh) {
+        // Check for OpenGL
+            #if ENGINE_GRAPHICS_API == ENGINE_GRAPHICS_OPGL
+                glBindVertexArray(mesh.vao_);
                 //glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m->indices_buffer_);
                 //glEnableVertexAttribArray(0);
-                for (int vaa = 0; vaa < (int)m->vertex_buffers_.size(); vaa++) {
+                for (int vaa = 0; vaa < (int)mesh.vertex_buffers_.size(); vaa++) {
                     glEnableVertexAttribArray(vaa);
 
                     //TODO: Handle raw shaders with variable inputs from the game engine side
@@ -182,31 +211,21 @@ namespace seedengine {
 
                 }
 
-                s->loadUniform("transformation_mat", t.getTransformationMatrix());
-                s->loadUniform("projection_mat", cam.getProjectionMatrix());
-                s->loadUniform("view_mat", cam.getViewMatrix());
-
-                if (m->data() == nullptr) ENGINE_WARN("Mesh data not loaded.");
+                if (!mesh.isLoaded()) ENGINE_WARN("Mesh data not loaded.");
                 else {
                     glDrawElements(
                         GL_TRIANGLES,
-                        m->data()->indices.size(),
+                        mesh.indexCount(),
                         GL_UNSIGNED_INT,
                         (void*)0
                     );
                 }
 
-
-                for (int vaa = 0; vaa < (int)m->vertex_buffers_.size(); vaa++) {
+                for (int vaa = 0; vaa < (int)mesh.vertex_buffers_.size(); vaa++) {
                     glDisableVertexAttribArray(vaa);
                 }
                 //glDisableVertexAttribArray(0);
                 glBindVertexArray(0);
-
-                s->stop();
-
-                delete s;
-
             // Check for Vulkan
             #elif ENGINE_GRAPHICS_API == ENGINE_GRAPHICS_VLKN
             // Check for DirectX
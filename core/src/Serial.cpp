@@ -0,0 +1,128 @@
+#include "Serial.hpp"
+
+namespace seedengine {
+
+    namespace util {
+
+        // Binary Writer
+
+        void BinaryWriter::writeBytes(const void* data, size_t size) {
+            alignBits();
+            if (size == 0) return;
+            size_t at = buffer_.size();
+            buffer_.resize(at + size);
+            std::memcpy(&buffer_[at], data, size);
+        }
+
+        void BinaryWriter::writeVarint(uint64_t value) {
+            alignBits();
+            uint8_t bytes[10];
+            size_t count = 0;
+            while (value >= 0x80) {
+                bytes[count++] = static_cast<uint8_t>(value | 0x80);
+                value >>= 7;
+            }
+            bytes[count++] = static_cast<uint8_t>(value);
+            buffer_.insert(buffer_.end(), bytes, bytes + count);
+        }
+
+        void BinaryWriter::writeSignedVarint(int64_t value) {
+            writeVarint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+        }
+
+        void BinaryWriter::writeBits(uint32_t value, unsigned int count) {
+            if (count == 0) return;
+            if (count < 32) value &= (1u << count) - 1;
+            bit_buffer_ |= static_cast<uint64_t>(value) << bit_count_;
+            bit_count_ += count;
+            while (bit_count_ >= 8) {
+                buffer_.push_back(static_cast<uint8_t>(bit_buffer_));
+                bit_buffer_ >>= 8;
+                bit_count_ -= 8;
+            }
+        }
+
+        void BinaryWriter::alignBits() {
+            if (bit_count_ == 0) return;
+            buffer_.push_back(static_cast<uint8_t>(bit_buffer_));
+            bit_buffer_ = 0;
+            bit_count_ = 0;
+        }
+
+        void BinaryWriter::write(const string& value) {
+            writeVarint(value.size());
+            writeBytes(value.data(), value.size());
+        }
+
+        // Binary Reader
+
+        bool BinaryReader::readBytes(void* out, size_t size) {
+            alignBits();
+            if (failed_ || size > size_ - pos_) return fail();
+            if (size == 0) return true;
+            std::memcpy(out, data_ + pos_, size);
+            pos_ += size;
+            return true;
+        }
+
+        bool BinaryReader::skipBytes(size_t size) {
+            alignBits();
+            if (failed_ || size > size_ - pos_) return fail();
+            pos_ += size;
+            return true;
+        }
+
+        bool BinaryReader::readVarint(uint64_t& out) {
+            alignBits();
+            if (failed_) return false;
+            uint64_t value = 0;
+            for (unsigned int shift = 0; shift < 64; shift += 7) {
+                if (pos_ >= size_) return fail();
+                uint8_t byte = data_[pos_++];
+                value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0) {
+                    out = value;
+                    return true;
+                }
+            }
+            // More than ten bytes is never written by a writer
+            return fail();
+        }
+
+        bool BinaryReader::readSignedVarint(int64_t& out) {
+            uint64_t value;
+            if (!readVarint(value)) return false;
+            out = static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+            return true;
+        }
+
+        bool BinaryReader::readBits(uint32_t& out, unsigned int count) {
+            if (failed_) return false;
+            while (bit_count_ < count) {
+                if (pos_ >= size_) return fail();
+                bit_buffer_ |= static_cast<uint64_t>(data_[pos_++]) << bit_count_;
+                bit_count_ += 8;
+            }
+            out = static_cast<uint32_t>(count < 32 ? bit_buffer_ & ((1u << count) - 1) : bit_buffer_);
+            bit_buffer_ >>= count;
+            bit_count_ -= count;
+            return true;
+        }
+
+        void BinaryReader::alignBits() {
+            bit_buffer_ = 0;
+            bit_count_ = 0;
+        }
+
+        bool BinaryReader::read(string& out) {
+            uint64_t size;
+            if (!readVarint(size)) return false;
+            if (size > size_ - pos_) return fail();
+            out.assign(reinterpret_cast<const char*>(data_ + pos_), static_cast<size_t>(size));
+            pos_ += static_cast<size_t>(size);
+            return true;
+        }
+
+    }
+
+}
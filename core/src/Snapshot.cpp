@@ -0,0 +1,135 @@
+#include "Snapshot.hpp"
+
+namespace seedengine {
+
+    // Render Snapshot
+
+    void RenderSnapshot::setCamera(const Camera& camera) {
+        setCamera(camera.getViewMatrix(), camera.getProjectionMatrix(), camera.transform().getPosition());
+    }
+
+    void RenderSnapshot::setCamera(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& position) {
+        view_ = view;
+        projection_ = projection;
+        camera_position_ = position;
+        has_camera_ = true;
+    }
+
+    void RenderSnapshot::clear() {
+        draws_.clear();
+        view_ = glm::mat4(1.0f);
+        projection_ = glm::mat4(1.0f);
+        camera_position_ = glm::vec3(0.0f);
+        has_camera_ = false;
+        alpha_ = 1.0f;
+    }
+
+    // Frame Exchange
+
+    RenderSnapshot& FrameExchange::begin() {
+        std::lock_guard<std::mutex> guard(mu_);
+        // The back snapshot is only touched by the simulation between begin() and publish()
+        RenderSnapshot& snapshot = buffers_[back_];
+        snapshot.clear();
+        snapshot.frame_ = next_frame_++;
+        snapshot.simulation_start_ns_ = Time::nowNS();
+        return snapshot;
+    }
+
+    bool FrameExchange::publish() {
+        int64_t now = Time::nowNS();
+        std::unique_lock<std::mutex> lock(mu_);
+        simulation_.record(static_cast<uint64_t>(now - buffers_[back_].simulation_start_ns_));
+
+        // The front snapshot can only be replaced once the renderer has taken and finished it
+        changed_.wait(lock, [this]() { return closed_ || (!ready_ && !reading_); });
+        if (closed_) return false;
+        publish_wait_ns_ += Time::nowNS() - now;
+
+        back_ ^= 1;
+        ready_ = true;
+        changed_.notify_all();
+        return true;
+    }
+
+    const RenderSnapshot* FrameExchange::acquire() {
+        int64_t now = Time::nowNS();
+        std::unique_lock<std::mutex> lock(mu_);
+        changed_.wait(lock, [this]() { return closed_ || ready_; });
+        // A snapshot published before closing is still rendered
+        if (!ready_) return nullptr;
+        render_start_ns_ = Time::nowNS();
+        acquire_wait_ns_ += render_start_ns_ - now;
+
+        ready_ = false;
+        reading_ = true;
+        return &buffers_[back_ ^ 1];
+    }
+
+    void FrameExchange::release() {
+        int64_t now = Time::nowNS();
+        std::lock_guard<std::mutex> guard(mu_);
+        if (!reading_) return;
+
+        render_.record(static_cast<uint64_t>(now - render_start_ns_));
+        latency_.record(static_cast<uint64_t>(now - buffers_[back_ ^ 1].simulation_start_ns_));
+        if (last_release_ns_ >= 0) intervals_.record(static_cast<uint64_t>(now - last_release_ns_));
+        else first_release_ns_ = now;
+        last_release_ns_ = now;
+
+        reading_ = false;
+        changed_.notify_all();
+    }
+
+    void FrameExchange::close() {
+        std::lock_guard<std::mutex> guard(mu_);
+        closed_ = true;
+        changed_.notify_all();
+    }
+
+    void FrameExchange::reset() {
+        std::lock_guard<std::mutex> guard(mu_);
+        buffers_[0].clear();
+        buffers_[1].clear();
+        back_ = 0;
+        ready_ = false;
+        reading_ = false;
+        closed_ = false;
+        next_frame_ = 0;
+        render_start_ns_ = 0;
+        first_release_ns_ = -1;
+        last_release_ns_ = -1;
+        latency_.clear();
+        intervals_.clear();
+        simulation_.clear();
+        render_.clear();
+        publish_wait_ns_ = 0;
+        acquire_wait_ns_ = 0;
+    }
+
+    bool FrameExchange::isClosed() const {
+        std::lock_guard<std::mutex> guard(mu_);
+        return closed_;
+    }
+
+    double FrameExchange::throughput() const {
+        std::lock_guard<std::mutex> guard(mu_);
+        if (intervals_.count() == 0 || last_release_ns_ <= first_release_ns_) return 0.0;
+        return intervals_.count() * 1000000000.0 / static_cast<double>(last_release_ns_ - first_release_ns_);
+    }
+
+    string FrameExchange::summary() const {
+        double fps = throughput();
+        std::lock_guard<std::mutex> guard(mu_);
+        std::ostringstream out;
+        out << latency_.count() << " frames at " << fps
+            << " fps, latency p50 " << latency_.percentile(0.5) / 1000000.0
+            << " ms, p99 " << latency_.percentile(0.99) / 1000000.0
+            << " ms, simulation p50 " << simulation_.percentile(0.5) / 1000000.0
+            << " ms, render p50 " << render_.percentile(0.5) / 1000000.0
+            << " ms, simulation waited " << publish_wait_ns_ / 1000000.0
+            << " ms, renderer waited " << acquire_wait_ns_ / 1000000.0 << " ms";
+        return out.str();
+    }
+
+}
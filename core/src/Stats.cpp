@@ -0,0 +1,278 @@
+#include "Stats.hpp"
+
+namespace seedengine {
+
+    namespace util {
+
+        // Histogram
+
+        Histogram::Histogram() : buckets_(BUCKETS, 0) {}
+
+        void Histogram::record(uint64_t value) {
+            buckets_[bucketOf(value)]++;
+            count_++;
+            total_ += value;
+            if (value < min_) min_ = value;
+            if (value > max_) max_ = value;
+        }
+
+        void Histogram::merge(const Histogram& other) {
+            for (unsigned int i = 0; i < BUCKETS; i++) buckets_[i] += other.buckets_[i];
+            count_ += other.count_;
+            total_ += other.total_;
+            if (other.count_ > 0 && other.min_ < min_) min_ = other.min_;
+            if (other.max_ > max_) max_ = other.max_;
+        }
+
+        void Histogram::clear() {
+            std::fill(buckets_.begin(), buckets_.end(), 0);
+            count_ = 0;
+            total_ = 0;
+            min_ = ~0ull;
+            max_ = 0;
+        }
+
+        uint64_t Histogram::percentile(double fraction) const {
+            if (count_ == 0) return 0;
+            if (fraction < 0.0) fraction = 0.0;
+            if (fraction > 1.0) fraction = 1.0;
+            // The rank of the value, counting from 1
+            uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(count_)));
+            if (rank == 0) rank = 1;
+            uint64_t seen = 0;
+            for (unsigned int i = 0; i < BUCKETS; i++) {
+                seen += buckets_[i];
+                if (seen >= rank) return std::min(std::max(upperBound(i), min_), max_);
+            }
+            return max_;
+        }
+
+        unsigned int Histogram::bucketOf(uint64_t value) {
+            if (value < SUB_BUCKETS) return static_cast<unsigned int>(value);
+            // Find the highest set bit
+            unsigned int msb = 0;
+            for (uint64_t v = value; v > 1; v >>= 1) msb++;
+            unsigned int shift = msb - SUB_BUCKET_BITS;
+            return (shift + 1) * SUB_BUCKETS + static_cast<unsigned int>((value >> shift) - SUB_BUCKETS);
+        }
+
+        uint64_t Histogram::upperBound(unsigned int bucket) {
+            if (bucket < SUB_BUCKETS) return bucket;
+            unsigned int shift = bucket / SUB_BUCKETS - 1;
+            uint64_t lower = static_cast<uint64_t>(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+            return lower + ((1ull << shift) - 1);
+        }
+
+        // Rolling Window
+
+        RollingWindow::RollingWindow(size_t capacity)
+            : values_(std::max<size_t>(capacity, 1), 0), sorted_(std::max<size_t>(capacity, 1), 0) {}
+
+        void RollingWindow::record(uint64_t value) {
+            if (size_ == values_.size()) total_ -= values_[next_];
+            else size_++;
+            values_[next_] = value;
+            total_ += value;
+            next_ = (next_ + 1) % values_.size();
+        }
+
+        void RollingWindow::clear() {
+            next_ = 0;
+            size_ = 0;
+            total_ = 0;
+        }
+
+        uint64_t RollingWindow::at(size_t index) const {
+            if (index >= size_) throw std::out_of_range("Rolling window index out of range.");
+            size_t oldest = size_ == values_.size() ? next_ : 0;
+            return values_[(oldest + index) % values_.size()];
+        }
+
+        uint64_t RollingWindow::latest() const {
+            if (size_ == 0) return 0;
+            return values_[(next_ + values_.size() - 1) % values_.size()];
+        }
+
+        uint64_t RollingWindow::max() const {
+            if (size_ == 0) return 0;
+            return *std::max_element(values_.begin(), values_.begin() + size_);
+        }
+
+        uint64_t RollingWindow::percentile(double fraction) const {
+            if (size_ == 0) return 0;
+            if (fraction < 0.0) fraction = 0.0;
+            if (fraction > 1.0) fraction = 1.0;
+            // The rank of the value, counting from 1
+            size_t rank = static_cast<size_t>(std::ceil(fraction * static_cast<double>(size_)));
+            if (rank == 0) rank = 1;
+            std::copy(values_.begin(), values_.begin() + size_, sorted_.begin());
+            std::nth_element(sorted_.begin(), sorted_.begin() + (rank - 1), sorted_.begin() + size_);
+            return sorted_[rank - 1];
+        }
+
+        size_t RollingWindow::countAbove(uint64_t threshold) const {
+            return static_cast<size_t>(std::count_if(values_.begin(), values_.begin() + size_,
+                [threshold](uint64_t value) { return value > threshold; }));
+        }
+
+    }
+
+    // Frame Stats
+
+    FrameStats::FrameStats(size_t window) {
+        reset(window);
+    }
+
+    FrameStats::~FrameStats() {
+        stopCsv();
+    }
+
+    void FrameStats::reset(size_t window) {
+        std::lock_guard<std::mutex> guard(mu_);
+        pending_.fill(0);
+        windows_.assign(STAGES, util::RollingWindow(window));
+        histograms_.assign(STAGES, util::Histogram());
+        recent_hitches_ = util::RollingWindow(window);
+        hitches_ = 0;
+        frames_ = 0;
+    }
+
+    void FrameStats::setHitchThreshold(uint64_t threshold_ns) {
+        std::lock_guard<std::mutex> guard(mu_);
+        hitch_threshold_ns_ = threshold_ns;
+    }
+
+    void FrameStats::record(FrameStage stage, int64_t ns) {
+        if (ns <= 0) return;
+        std::lock_guard<std::mutex> guard(mu_);
+        pending_[static_cast<unsigned int>(stage)] += static_cast<uint64_t>(ns);
+    }
+
+    void FrameStats::endFrame(int64_t frame_ns) {
+        std::lock_guard<std::mutex> guard(mu_);
+        pending_[static_cast<unsigned int>(FrameStage::FRAME)] = static_cast<uint64_t>(std::max<int64_t>(frame_ns, 0));
+
+        // Judge the frame against the frames before it
+        uint64_t threshold = hitchThreshold();
+        bool hitch = threshold > 0 && pending_[0] > threshold;
+        if (hitch) hitches_++;
+        recent_hitches_.record(hitch ? 1 : 0);
+
+        for (unsigned int i = 0; i < STAGES; i++) {
+            windows_[i].record(pending_[i]);
+            histograms_[i].record(pending_[i]);
+        }
+        if (csv_.is_open()) {
+            csv_ << frames_;
+            for (unsigned int i = 0; i < STAGES; i++) csv_ << "," << pending_[i] / 1000000.0;
+            csv_ << "," << (hitch ? 1 : 0) << "\n";
+        }
+        pending_.fill(0);
+        frames_++;
+    }
+
+    bool FrameStats::startCsv(const string& path) {
+        std::lock_guard<std::mutex> guard(mu_);
+        if (csv_.is_open()) csv_.close();
+        csv_.open(path, std::ios::out | std::ios::trunc);
+        if (!csv_.is_open()) {
+            ENGINE_WARN("Could not open frame stats file {0}.", path);
+            return false;
+        }
+        csv_ << "frame";
+        for (unsigned int i = 0; i < STAGES; i++) csv_ << "," << stageName(static_cast<FrameStage>(i)) << "_ms";
+        csv_ << ",hitch" << std::endl;
+        return true;
+    }
+
+    void FrameStats::stopCsv() {
+        std::lock_guard<std::mutex> guard(mu_);
+        if (csv_.is_open()) csv_.close();
+    }
+
+    double FrameStats::mean(FrameStage stage) const {
+        std::lock_guard<std::mutex> guard(mu_);
+        return windows_[static_cast<unsigned int>(stage)].mean();
+    }
+
+    uint64_t FrameStats::percentile(FrameStage stage, double fraction) const {
+        std::lock_guard<std::mutex> guard(mu_);
+        return windows_[static_cast<unsigned int>(stage)].percentile(fraction);
+    }
+
+    uint64_t FrameStats::max(FrameStage stage) const {
+        std::lock_guard<std::mutex> guard(mu_);
+        return windows_[static_cast<unsigned int>(stage)].max();
+    }
+
+    util::Histogram FrameStats::histogram(FrameStage stage) const {
+        std::lock_guard<std::mutex> guard(mu_);
+        return histograms_[static_cast<unsigned int>(stage)];
+    }
+
+    double FrameStats::fps() const {
+        std::lock_guard<std::mutex> guard(mu_);
+        double frame_ns = windows_[0].mean();
+        return frame_ns > 0.0 ? 1000000000.0 / frame_ns : 0.0;
+    }
+
+    uint64_t FrameStats::frames() const {
+        std::lock_guard<std::mutex> guard(mu_);
+        return frames_;
+    }
+
+    uint64_t FrameStats::hitches() const {
+        std::lock_guard<std::mutex> guard(mu_);
+        return hitches_;
+    }
+
+    size_t FrameStats::recentHitches() const {
+        std::lock_guard<std::mutex> guard(mu_);
+        return recent_hitches_.countAbove(0);
+    }
+
+    void FrameStats::report(std::ostream& out) const {
+        std::lock_guard<std::mutex> guard(mu_);
+        out << "Frames: " << frames_ << ", " << hitches_ << " hitches, " << recent_hitches_.countAbove(0)
+            << " in the last " << windows_[0].size() << " frames" << std::endl;
+        for (unsigned int i = 0; i < STAGES; i++) {
+            const util::RollingWindow& window = windows_[i];
+            out << "  " << stageName(static_cast<FrameStage>(i)) << ": mean " << window.mean() / 1000000.0
+                << " ms, p50 " << window.percentile(0.5) / 1000000.0
+                << " ms, p95 " << window.percentile(0.95) / 1000000.0
+                << " ms, p99 " << window.percentile(0.99) / 1000000.0
+                << " ms, max " << window.max() / 1000000.0 << " ms" << std::endl;
+        }
+    }
+
+    string FrameStats::summary() const {
+        std::lock_guard<std::mutex> guard(mu_);
+        const util::RollingWindow& frame = windows_[0];
+        std::ostringstream out;
+        out << (frame.mean() > 0.0 ? 1000000000.0 / frame.mean() : 0.0) << " fps, frame p50 "
+            << frame.percentile(0.5) / 1000000.0 << " ms, p95 " << frame.percentile(0.95) / 1000000.0
+            << " ms, p99 " << frame.percentile(0.99) / 1000000.0 << " ms, max " << frame.max() / 1000000.0
+            << " ms, " << recent_hitches_.countAbove(0) << " hitches in " << frame.size() << " frames, "
+            << hitches_ << " in total";
+        return out.str();
+    }
+
+    const char* FrameStats::stageName(FrameStage stage) {
+        switch (stage) {
+            case FrameStage::FRAME:      return "frame";
+            case FrameStage::TICK:       return "tick";
+            case FrameStage::PRE_RENDER: return "pre_render";
+            case FrameStage::RENDER:     return "render";
+            case FrameStage::SWAP:       return "swap";
+        }
+        return "unknown";
+    }
+
+    uint64_t FrameStats::hitchThreshold() const {
+        if (hitch_threshold_ns_ > 0) return hitch_threshold_ns_;
+        // Too few frames for a stable median
+        if (windows_[0].size() < 8) return 0;
+        return windows_[0].percentile(0.5) * 2;
+    }
+
+}
@@ -0,0 +1,250 @@
+#include "Streamer.hpp"
+
+namespace seedengine {
+
+    // File Stream Source
+
+    FileStreamSource::FileStreamSource() {
+        reader_ = std::thread(&FileStreamSource::readLoop, this);
+    }
+
+    FileStreamSource::~FileStreamSource() {
+        {
+            std::lock_guard<std::mutex> guard(mu_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        if (reader_.joinable()) reader_.join();
+    }
+
+    void FileStreamSource::begin(unsigned int id, const string& path, uint64_t) {
+        // The file is sized when it is opened, so the requested size is not needed
+        {
+            std::lock_guard<std::mutex> guard(mu_);
+            queued_.push_back(std::make_pair(id, path));
+        }
+        cv_.notify_one();
+    }
+
+    void FileStreamSource::cancel(unsigned int id) {
+        std::lock_guard<std::mutex> guard(mu_);
+        for (auto it = queued_.begin(); it != queued_.end(); ++it) {
+            if (it->first == id) {
+                queued_.erase(it);
+                finished_.push_back(id);
+                return;
+            }
+        }
+    }
+
+    void FileStreamSource::collect(std::vector<unsigned int>& completed) {
+        std::lock_guard<std::mutex> guard(mu_);
+        completed.insert(completed.end(), finished_.begin(), finished_.end());
+        finished_.clear();
+    }
+
+    bool FileStreamSource::take(unsigned int id, std::vector<char>& data) {
+        std::lock_guard<std::mutex> guard(mu_);
+        auto it = data_.find(id);
+        if (it == data_.end()) return false;
+        data.swap(it->second);
+        data_.erase(it);
+        return true;
+    }
+
+    void FileStreamSource::readLoop() {
+        while (true) {
+            std::pair<unsigned int, string> next;
+            {
+                std::unique_lock<std::mutex> lock(mu_);
+                cv_.wait(lock, [this]() { return stop_ || !queued_.empty(); });
+                if (stop_) return;
+                next = queued_.front();
+                queued_.pop_front();
+            }
+
+            // Read the whole file, leaving it empty if it could not be read
+            std::vector<char> data;
+            std::ifstream file(next.second, std::ios::in | std::ios::binary | std::ios::ate);
+            if (file) {
+                std::streamoff size = file.tellg();
+                data.resize(static_cast<size_t>(size));
+                file.seekg(0, std::ios::beg);
+                if (!file.read(data.data(), size)) data.clear();
+            }
+
+            std::lock_guard<std::mutex> guard(mu_);
+            if (!data.empty()) data_[next.first].swap(data);
+            finished_.push_back(next.first);
+        }
+    }
+
+    // Asset Streamer
+
+    AssetStreamer::AssetStreamer(StreamSource* source, uint64_t max_io_bytes, uint64_t max_upload_bytes)
+        : source_(source), max_io_bytes_(max_io_bytes), max_upload_bytes_(max_upload_bytes),
+            viewer_(0.0f, 0.0f, 0.0f) {
+
+    }
+
+    unsigned int AssetStreamer::request(const string& path, StreamPriority priority, const glm::vec3& position,
+            UploadFunction upload, uint64_t bytes) {
+        Request r;
+        r.id = next_id_++;
+        r.path = path;
+        r.priority = priority;
+        r.position = position;
+        glm::vec3 offset = position - viewer_;
+        r.distance = std::sqrt(offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+        r.bytes = (bytes == 0) ? AssetManifest::size(path) : bytes;
+        r.state = StreamState::PENDING;
+        r.upload = upload;
+        requests_[r.id] = r;
+        return r.id;
+    }
+
+    bool AssetStreamer::cancel(unsigned int id) {
+        auto it = requests_.find(id);
+        if (it == requests_.end() || it->second.state == StreamState::UPLOADING) return false;
+        if (it->second.state == StreamState::READING) {
+            // The bytes stay outstanding until the source reports the read as finished
+            abandoned_[id] = it->second.bytes;
+            source_->cancel(id);
+        }
+        finished_[id] = std::make_pair(StreamState::CANCELLED, updates_);
+        requests_.erase(it);
+        return true;
+    }
+
+    void AssetStreamer::setPriority(unsigned int id, StreamPriority priority) {
+        auto it = requests_.find(id);
+        if (it != requests_.end()) it->second.priority = priority;
+    }
+
+    void AssetStreamer::setViewerPosition(const glm::vec3& position) {
+        viewer_ = position;
+        for (auto& entry : requests_) {
+            glm::vec3 offset = entry.second.position - viewer_;
+            entry.second.distance = std::sqrt(offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+        }
+    }
+
+    void AssetStreamer::update() {
+        schedule();
+        upload();
+        completeUploads();
+    }
+
+    void AssetStreamer::schedule() {
+        updates_++;
+        completeUploads();
+
+        // Forget finished requests that have been reported for long enough
+        for (auto it = finished_.begin(); it != finished_.end();) {
+            if (updates_ - it->second.second > FINISHED_UPDATES) it = finished_.erase(it);
+            else ++it;
+        }
+
+        // Collect finished reads
+        completed_.clear();
+        source_->collect(completed_);
+        for (unsigned int id : completed_) {
+            auto abandoned = abandoned_.find(id);
+            if (abandoned != abandoned_.end()) {
+                source_->take(id, discarded_);
+                discarded_.clear();
+                outstanding_bytes_ -= abandoned->second;
+                abandoned_.erase(abandoned);
+                continue;
+            }
+            auto it = requests_.find(id);
+            if (it == requests_.end() || it->second.state != StreamState::READING) continue;
+            outstanding_bytes_ -= it->second.bytes;
+            source_->take(id, it->second.data);
+            it->second.state = StreamState::READY;
+        }
+
+        order_.clear();
+        for (auto& entry : requests_) order_.push_back(&entry.second);
+        std::sort(order_.begin(), order_.end(), &AssetStreamer::before);
+
+        // Top the upload queue up to one frame's budget in priority order
+        {
+            std::lock_guard<std::mutex> guard(uploads_mu_);
+            for (Request* r : order_) {
+                if (r->state != StreamState::READY) continue;
+                bool critical = r->priority == StreamPriority::CRITICAL;
+                if (!critical && queued_bytes_ != 0 && queued_bytes_ + r->bytes > max_upload_bytes_) continue;
+                uploads_.push_back(Upload { r->id, r->bytes, critical, r->path, std::move(r->data), r->upload });
+                r->state = StreamState::UPLOADING;
+                queued_bytes_ += r->bytes;
+            }
+        }
+
+        // Start new reads in priority order within the I/O budget
+        for (Request* r : order_) {
+            if (r->state != StreamState::PENDING) continue;
+            if (outstanding_bytes_ != 0 && outstanding_bytes_ + r->bytes > max_io_bytes_) break;
+            r->state = StreamState::READING;
+            outstanding_bytes_ += r->bytes;
+            source_->begin(r->id, r->path, r->bytes);
+        }
+    }
+
+    size_t AssetStreamer::upload() {
+        // Take the uploads that fit this frame's budget, leaving the rest queued
+        uint64_t bytes = 0;
+        {
+            std::lock_guard<std::mutex> guard(uploads_mu_);
+            while (!uploads_.empty()) {
+                Upload& next = uploads_.front();
+                if (!next.critical && !uploading_.empty() && bytes + next.bytes > max_upload_bytes_) break;
+                bytes += next.bytes;
+                uploading_.push_back(std::move(next));
+                uploads_.pop_front();
+            }
+            queued_bytes_ -= bytes;
+        }
+        uploaded_bytes_ = bytes;
+
+        // Upload without the lock, so scheduling is not held up by the graphics driver
+        for (Upload& upload : uploading_) {
+            upload.upload(upload.path, upload.data);
+            uploading_ids_.push_back(upload.id);
+        }
+        size_t uploaded = uploading_.size();
+        uploading_.clear();
+
+        std::lock_guard<std::mutex> guard(uploads_mu_);
+        uploaded_.insert(uploaded_.end(), uploading_ids_.begin(), uploading_ids_.end());
+        uploading_ids_.clear();
+        return uploaded;
+    }
+
+    void AssetStreamer::completeUploads() {
+        {
+            std::lock_guard<std::mutex> guard(uploads_mu_);
+            completing_.swap(uploaded_);
+        }
+        for (unsigned int id : completing_) {
+            requests_.erase(id);
+            finished_[id] = std::make_pair(StreamState::COMPLETE, updates_);
+        }
+        completing_.clear();
+    }
+
+    StreamState AssetStreamer::state(unsigned int id) const {
+        auto it = requests_.find(id);
+        if (it != requests_.end()) return it->second.state;
+        auto finished = finished_.find(id);
+        if (finished != finished_.end()) return finished->second.first;
+        return StreamState::UNKNOWN;
+    }
+
+    bool AssetStreamer::before(const Request* a, const Request* b) {
+        if (a->priority != b->priority) return a->priority < b->priority;
+        if (a->distance != b->distance) return a->distance < b->distance;
+        return a->id < b->id;
+    }
+
+}
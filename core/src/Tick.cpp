@@ -0,0 +1,302 @@
+#include "Tick.hpp"
+
+namespace seedengine {
+
+    // Tick Access
+
+    TickAccess& TickAccess::setName(const string& name) {
+        name_ = name;
+        return *this;
+    }
+
+    TickAccess& TickAccess::reads(const string& data) {
+        insert(reads_, dataId(data));
+        declared_ = true;
+        return *this;
+    }
+
+    TickAccess& TickAccess::writes(const string& data) {
+        insert(writes_, dataId(data));
+        declared_ = true;
+        return *this;
+    }
+
+    TickAccess& TickAccess::perActor(bool per_actor) {
+        per_actor_ = per_actor;
+        return *this;
+    }
+
+    bool TickAccess::conflictsWith(const TickAccess& other) const {
+        if (!declared_ || !other.declared_) return true;
+        return intersects(writes_, other.writes_) || intersects(writes_, other.reads_) || intersects(reads_, other.writes_);
+    }
+
+    uint32_t TickAccess::dataId(const string& data) {
+        static std::mutex mu;
+        static std::unordered_map<string, uint32_t> ids;
+        std::lock_guard<std::mutex> guard(mu);
+        auto it = ids.find(data);
+        if (it != ids.end()) return it->second;
+        uint32_t id = static_cast<uint32_t>(ids.size());
+        ids.emplace(data, id);
+        return id;
+    }
+
+    void TickAccess::insert(std::vector<uint32_t>& ids, uint32_t id) {
+        auto it = std::lower_bound(ids.begin(), ids.end(), id);
+        if (it == ids.end() || *it != id) ids.insert(it, id);
+    }
+
+    bool TickAccess::intersects(const std::vector<uint32_t>& a, const std::vector<uint32_t>& b) {
+        auto i = a.begin();
+        auto j = b.begin();
+        while (i != a.end() && j != b.end()) {
+            if (*i < *j) i++;
+            else if (*j < *i) j++;
+            else return true;
+        }
+        return false;
+    }
+
+    // Tick Scheduler
+
+    void TickScheduler::add(Actor& actor) {
+        if (std::find(actors_.begin(), actors_.end(), &actor) == actors_.end()) actors_.push_back(&actor);
+    }
+
+    void TickScheduler::remove(Actor& actor) {
+        actors_.erase(std::remove(actors_.begin(), actors_.end(), &actor), actors_.end());
+    }
+
+    size_t TickScheduler::tick(bool paused) {
+        ENGINE_PROFILE_SCOPE("TickScheduler::tick");
+        MemoryTagScope memory_tag(MemoryTag::SCENE);
+        int64_t start = Time::nowNS();
+
+        // Collect the components of each type, keeping the memory of the lists between ticks
+        for (const std::unique_ptr<Group>& group : groups_) group->components.clear();
+        size_t count = 0;
+        for (Actor* actor : actors_) {
+            // Keep the state before the tick, so rendering can blend between the two
+            actor->previous_transform_ = actor->transform();
+            if (!actor->active() || actor->actor_properties_.never_ticks_) continue;
+            if (paused && actor->actor_properties_.can_pause_) continue;
+            for (const std::unique_ptr<Component>& component : actor->components_) {
+                std::type_index type(typeid(*component));
+                auto it = group_index_.find(type);
+                if (it == group_index_.end()) {
+                    // First component of its type, so read the access of the type
+                    size_t index = groups_.size();
+                    groups_.emplace_back(new Group(type, index));
+                    component->declareAccess(groups_.back()->access);
+                    if (groups_.back()->access.name().empty()) groups_.back()->access.setName(type.name());
+                    it = group_index_.emplace(type, index).first;
+                }
+                groups_[it->second]->components.push_back(component.get());
+                count++;
+            }
+        }
+
+        // Each group waits for every earlier group it conflicts with
+        active_.clear();
+        for (const std::unique_ptr<Group>& group : groups_) {
+            group->predecessors.clear();
+            group->successors.clear();
+            if (group->components.empty()) continue;
+            for (Group* earlier : active_) {
+                if (group->access.conflictsWith(earlier->access)) {
+                    group->predecessors.push_back(earlier->index);
+                    earlier->successors.push_back(group.get());
+                }
+            }
+            active_.push_back(group.get());
+        }
+        for (Group* group : active_) group->remaining.store(group->predecessors.size());
+
+        // Start the groups without dependencies, the rest start as their last dependency ends
+        jobs::Counter counter;
+        for (Group* group : active_) {
+            if (group->predecessors.empty()) {
+                jobs::run([this, group, &counter]() { runGroup(*group, counter); }, counter);
+            }
+        }
+        jobs::wait(counter);
+
+        tick_times_.record(static_cast<uint64_t>(Time::nowNS() - start));
+        return count;
+    }
+
+    void TickScheduler::runGroup(Group& group, jobs::Counter& counter) {
+        // Groups live as long as the scheduler, so their names outlive a capture
+        ENGINE_PROFILE_SCOPE(group.access.name().c_str());
+        MemoryTagScope memory_tag(MemoryTag::SCENE);
+        int64_t start = Time::nowNS();
+        if (group.access.isPerActor() && group.components.size() > 1) {
+            TrackedVector<Component*, MemoryTag::SCENE>& components = group.components;
+            jobs::parallelFor(0, components.size(), [&components](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) components[i]->update();
+            });
+        }
+        else {
+            for (Component* component : group.components) component->update();
+        }
+        group.times.record(static_cast<uint64_t>(Time::nowNS() - start));
+
+        for (Group* successor : group.successors) {
+            if (successor->remaining.fetch_sub(1) == 1) {
+                jobs::run([this, successor, &counter]() { runGroup(*successor, counter); }, counter);
+            }
+        }
+    }
+
+    std::vector<size_t> TickScheduler::criticalPath(double* length_ns) const {
+        // Groups only depend on earlier groups, so one pass in order finds the longest chain
+        std::vector<double> finish(groups_.size(), 0.0);
+        std::vector<size_t> previous(groups_.size(), groups_.size());
+        size_t last = groups_.size();
+        for (size_t i = 0; i < groups_.size(); i++) {
+            const Group& group = *groups_[i];
+            if (group.components.empty()) continue;
+            double before = 0.0;
+            for (size_t p : group.predecessors) {
+                if (finish[p] > before) {
+                    before = finish[p];
+                    previous[i] = p;
+                }
+            }
+            finish[i] = before + group.times.mean();
+            if (last == groups_.size() || finish[i] > finish[last]) last = i;
+        }
+
+        std::vector<size_t> path;
+        for (size_t i = last; i < groups_.size(); i = previous[i]) path.push_back(i);
+        std::reverse(path.begin(), path.end());
+        if (length_ns != nullptr) *length_ns = last < groups_.size() ? finish[last] : 0.0;
+        return path;
+    }
+
+    void TickScheduler::report(std::ostream& out) const {
+        out << "Tick: " << tick_times_.count() << " ticks, mean " << tick_times_.mean() / 1000.0
+            << " us, p99 " << tick_times_.percentile(0.99) / 1000.0 << " us" << std::endl;
+        for (const std::unique_ptr<Group>& group : groups_) {
+            out << "  " << group->access.name() << ": " << group->components.size() << " components"
+                << (group->access.isPerActor() ? " in parallel" : "")
+                << ", mean " << group->times.mean() / 1000.0
+                << " us, p99 " << group->times.percentile(0.99) / 1000.0
+                << " us, max " << group->times.max() / 1000.0 << " us";
+            if (!group->predecessors.empty()) {
+                out << ", after";
+                for (size_t p : group->predecessors) out << " " << groups_[p]->access.name();
+            }
+            out << std::endl;
+        }
+
+        double length = 0.0;
+        std::vector<size_t> path = criticalPath(&length);
+        out << "  Critical path (" << length / 1000.0 << " us):";
+        for (size_t i = 0; i < path.size(); i++) out << (i == 0 ? " " : " -> ") << groups_[path[i]]->access.name();
+        out << std::endl;
+    }
+
+    string TickScheduler::summary() const {
+        double length = 0.0;
+        std::vector<size_t> path = criticalPath(&length);
+        std::ostringstream out;
+        out << tick_times_.count() << " ticks of " << active_.size() << " component groups, p50 "
+            << tick_times_.percentile(0.5) / 1000.0 << " us, critical path " << length / 1000.0 << " us through";
+        for (size_t i = 0; i < path.size(); i++) out << (i == 0 ? " " : " -> ") << groups_[path[i]]->access.name();
+        return out.str();
+    }
+
+    void TickScheduler::resetTimings() {
+        for (const std::unique_ptr<Group>& group : groups_) group->times.clear();
+        tick_times_.clear();
+    }
+
+    // Fixed Timestep
+
+    const double FixedTimestep::COST_SMOOTHING = 0.1;
+
+    void FixedTimestep::setInterval(double interval_ms) {
+        interval_ms_ = std::max(interval_ms, 0.001);
+    }
+
+    void FixedTimestep::setMaxSteps(int max_steps) {
+        max_steps_ = std::max(max_steps, 1);
+    }
+
+    void FixedTimestep::setBudget(double budget_ms) {
+        budget_ms_ = std::max(budget_ms, 0.0);
+    }
+
+    void FixedTimestep::advance(double delta_ms) {
+        accumulator_ += std::max(delta_ms, 0.0);
+        frame_steps_ = 0;
+        step_start_ns_ = -1;
+
+        // Only run the steps that fit in the budget, as each one late makes the next frame longer
+        step_limit_ = max_steps_;
+        if (step_cost_ms_ > 0.0) {
+            double budget = budget_ms_ > 0.0 ? budget_ms_ : interval_ms_;
+            double affordable = std::floor(budget / step_cost_ms_);
+            if (affordable < step_limit_) step_limit_ = std::max(static_cast<int>(affordable), 1);
+        }
+    }
+
+    bool FixedTimestep::step() {
+        int64_t now = Time::nowNS();
+        if (step_start_ns_ >= 0) recordCost(now - step_start_ns_);
+        step_start_ns_ = -1;
+        if (accumulator_ < interval_ms_ || frame_steps_ >= step_limit_) return false;
+
+        accumulator_ -= interval_ms_;
+        frame_steps_++;
+        steps_++;
+        step_start_ns_ = now;
+        return true;
+    }
+
+    void FixedTimestep::endFrame() {
+        if (step_start_ns_ >= 0) recordCost(Time::nowNS() - step_start_ns_);
+        step_start_ns_ = -1;
+        steps_per_frame_.record(static_cast<uint64_t>(frame_steps_));
+
+        // Drop the whole steps that did not fit, keeping the part of a step left for the alpha
+        behind_ = accumulator_ >= interval_ms_;
+        if (behind_) {
+            double whole = std::floor(accumulator_ / interval_ms_);
+            dropped_ += static_cast<uint64_t>(whole);
+            dropped_frames_++;
+            accumulator_ -= whole * interval_ms_;
+        }
+        alpha_ = accumulator_ / interval_ms_;
+    }
+
+    void FixedTimestep::reset() {
+        accumulator_ = 0.0;
+        alpha_ = 0.0;
+        step_cost_ms_ = 0.0;
+        frame_steps_ = 0;
+        step_limit_ = max_steps_;
+        behind_ = false;
+        step_start_ns_ = -1;
+        steps_ = 0;
+        dropped_ = 0;
+        dropped_frames_ = 0;
+        steps_per_frame_.clear();
+    }
+
+    string FixedTimestep::summary() const {
+        std::ostringstream out;
+        out << steps_ << " steps of " << interval_ms_ << " ms over " << steps_per_frame_.count() << " frames, "
+            << dropped_ << " dropped in " << dropped_frames_ << " frames, step cost " << step_cost_ms_ << " ms";
+        return out.str();
+    }
+
+    void FixedTimestep::recordCost(int64_t cost_ns) {
+        double cost = cost_ns / 1000000.0;
+        if (step_cost_ms_ <= 0.0) step_cost_ms_ = cost;
+        else step_cost_ms_ += (cost - step_cost_ms_) * COST_SMOOTHING;
+    }
+
+}
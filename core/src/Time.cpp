@@ -3,16 +3,40 @@
 namespace seedengine {
 
     float Time::delta_time_ = 0;
+    double Time::smoothed_delta_ = 0;
+    float Time::smoothing_ = 0.1f;
     bool Time::paused_ = false;
 
     float Time::time_scale_ = 1;
     float Time::last_time_scale_ = 1;
-    std::chrono::milliseconds Time::start_time_ = currentSysTimeMS();
-    std::chrono::milliseconds Time::last_loop_time_ = start_time_;
+    Time::Clock::time_point Time::start_time_ = Time::Clock::now();
+    int64_t Time::frame_start_ns_ = 0;
+    int64_t Time::frame_time_ns_ = 0;
+    uint64_t Time::frame_index_ = 0;
 
     void Time::start() {
-        Time::start_time_ = Time::currentSysTimeMS();
-        Time::last_loop_time_ = std::chrono::milliseconds(0);
+        Time::start_time_ = Clock::now();
+        Time::frame_start_ns_ = 0;
+        Time::frame_time_ns_ = 0;
+        Time::frame_index_ = 0;
+        Time::smoothed_delta_ = 0;
+        Time::delta_time_ = 0;
+    }
+
+    void Time::beginFrame() {
+        int64_t now = nowNS();
+        frame_time_ns_ = now - frame_start_ns_;
+        frame_start_ns_ = now;
+        frame_index_++;
+        double seconds = frame_time_ns_ / 1000000000.0;
+        // The first frame seeds the average so it does not ramp up from zero
+        if (frame_index_ == 1) smoothed_delta_ = seconds;
+        else smoothed_delta_ += (seconds - smoothed_delta_) * smoothing_;
+        delta_time_ = static_cast<float>(seconds * time_scale_);
+    }
+
+    void Time::setDeltaSmoothing(float weight) {
+        smoothing_ = std::min(std::max(weight, 0.0f), 1.0f);
     }
 
     bool Time::togglePause() {
@@ -41,11 +65,21 @@ namespace seedengine {
     }
 
     float Time::getUpTime() {
-        float time = (float)(Time::elapsedTimeMS().count());
-        float deltaTime = time - Time::last_loop_time_.count();
-        std::chrono::milliseconds llt((int)(time));
-        Time::last_loop_time_ = llt;
-        return deltaTime * Time::getTimeScale();
+        return static_cast<float>((nowNS() - frame_start_ns_) / 1000000.0) * Time::getTimeScale();
+    }
+
+    int64_t Time::nowNS() {
+        using namespace std::chrono;
+        return static_cast<int64_t>(duration_cast<nanoseconds>(Clock::now() - start_time_).count());
+    }
+
+    int64_t Time::nowUS() {
+        using namespace std::chrono;
+        return static_cast<int64_t>(duration_cast<microseconds>(Clock::now() - start_time_).count());
+    }
+
+    double Time::elapsedSeconds() {
+        return std::chrono::duration<double>(Clock::now() - start_time_).count();
     }
 
     std::chrono::milliseconds Time::currentSysTimeMS() {
@@ -54,7 +88,8 @@ namespace seedengine {
     }
 
     std::chrono::milliseconds Time::elapsedTimeMS() {
-        return currentSysTimeMS() - start_time_;
+        using namespace std::chrono;
+        return duration_cast<milliseconds>(Clock::now() - start_time_);
     }
 
     std::chrono::seconds Time::currentSysTimeS() {
@@ -64,11 +99,11 @@ namespace seedengine {
 
     std::chrono::seconds Time::elapsedTimeS() {
         using namespace std::chrono;
-        return duration_cast<seconds>(currentSysTimeMS() - start_time_);
+        return duration_cast<seconds>(Clock::now() - start_time_);
     }
 
     float Time::msToSec(long ms) {
         return ms / 1000.0f;
     }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,237 @@
+#include "Timer.hpp"
+#include "Event.hpp"
+
+namespace seedengine {
+
+    namespace {
+
+        /** Returns the index of the highest set bit of a non-zero value. */
+        inline unsigned int highestBit(uint64_t value) {
+        #if defined(__GNUC__) || defined(__clang__)
+            return 63 - static_cast<unsigned int>(__builtin_clzll(value));
+        #else
+            unsigned int bit = 0;
+            while (value >>= 1) bit++;
+            return bit;
+        #endif
+        }
+
+        /** Returns the index of the lowest set bit of a non-zero value. */
+        inline unsigned int lowestBit(uint64_t value) {
+        #if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned int>(__builtin_ctzll(value));
+        #else
+            unsigned int bit = 0;
+            while ((value & 1) == 0) {
+                value >>= 1;
+                bit++;
+            }
+            return bit;
+        #endif
+        }
+
+    }
+
+    // Timer Wheel
+
+    const uint32_t TimerWheel::NONE;
+
+    TimerWheel::TimerWheel() : slots_(2 * LEVELS * SLOTS, NONE) {
+        for (unsigned int i = 0; i < LEVELS; i++) occupied_[i] = 0;
+    }
+
+    TimerId TimerWheel::schedule(uint64_t delay, Callback callback) {
+        // Longer delays would not fit in the top level
+        const uint64_t max_delay = (1ull << (SLOT_BITS * LEVELS)) - 1;
+        if (delay == 0) delay = 1;
+        if (delay > max_delay) delay = max_delay;
+
+        uint32_t index;
+        if (free_ != NONE) {
+            index = free_;
+            free_ = nodes_[index].next;
+        }
+        else {
+            index = static_cast<uint32_t>(nodes_.size());
+            nodes_.push_back(Node());
+        }
+        Node& node = nodes_[index];
+        node.deadline = now_ + delay;
+        node.callback = std::move(callback);
+        insert(index);
+        pending_++;
+        return (static_cast<uint64_t>(node.generation & 0x7fffffff) << 32) | (static_cast<uint64_t>(index) + 1);
+    }
+
+    bool TimerWheel::cancel(TimerId id) {
+        uint32_t index = find(id);
+        if (index == NONE) return false;
+        unlink(index);
+        release(index);
+        return true;
+    }
+
+    bool TimerWheel::active(TimerId id) const {
+        return find(id) != NONE;
+    }
+
+    size_t TimerWheel::advance(uint64_t ticks) {
+        uint64_t target = now_ + ticks;
+        size_t expired = 0;
+        while (true) {
+
+            // Find the occupied slot that starts soonest, preferring higher levels on ties so
+            // their timers are moved down before the lower slot expires
+            bool found = false;
+            uint64_t start = 0;
+            unsigned int level = 0;
+            unsigned int slot = 0;
+            for (unsigned int l = 0; l < LEVELS; l++) {
+                if (occupied_[l] == 0) continue;
+                unsigned int shift = l * SLOT_BITS;
+                unsigned int current = static_cast<unsigned int>((now_ >> shift) & (SLOTS - 1));
+                uint64_t later = occupied_[l] & (~0ull << current);
+                if (later == 0) continue;
+                unsigned int s = lowestBit(later);
+                uint64_t base = now_ & ~((1ull << (shift + SLOT_BITS)) - 1);
+                uint64_t slot_start = base + (static_cast<uint64_t>(s) << shift);
+                if (!found || slot_start <= start) {
+                    found = true;
+                    start = slot_start;
+                    level = l;
+                    slot = s;
+                }
+            }
+            if (!found || start > target) break;
+            if (start > now_) now_ = start;
+
+            uint32_t& head = slots_[2 * (level * SLOTS + slot)];
+            if (level == 0) {
+                // Every timer in a slot of the lowest level expires on this tick
+                while (head != NONE) {
+                    uint32_t index = head;
+                    unlink(index);
+                    Callback callback = std::move(nodes_[index].callback);
+                    release(index);
+                    expired++;
+                    callback();
+                }
+            }
+            else {
+                // Move the timers of the slot down to the levels matching their deadlines
+                while (head != NONE) {
+                    uint32_t index = head;
+                    unlink(index);
+                    insert(index);
+                }
+            }
+        }
+        now_ = target;
+        return expired;
+    }
+
+    void TimerWheel::clear() {
+        for (uint32_t i = 0; i < nodes_.size(); i++) {
+            if (nodes_[i].slot == NONE) continue;
+            unlink(i);
+            release(i);
+        }
+    }
+
+    void TimerWheel::insert(uint32_t index) {
+        Node& node = nodes_[index];
+        // The level is the highest group of bits in which the deadline differs from now
+        uint64_t differing = (node.deadline ^ now_) | (SLOTS - 1);
+        unsigned int level = highestBit(differing) / SLOT_BITS;
+        if (level >= LEVELS) level = LEVELS - 1;
+        unsigned int slot = static_cast<unsigned int>((node.deadline >> (level * SLOT_BITS)) & (SLOTS - 1));
+        node.slot = level * SLOTS + slot;
+
+        // Append to the slot, so timers with the same deadline expire in the order they were scheduled
+        uint32_t& head = slots_[2 * node.slot];
+        uint32_t& tail = slots_[2 * node.slot + 1];
+        node.prev = tail;
+        node.next = NONE;
+        if (tail != NONE) nodes_[tail].next = index;
+        else head = index;
+        tail = index;
+        occupied_[level] |= 1ull << slot;
+    }
+
+    void TimerWheel::unlink(uint32_t index) {
+        Node& node = nodes_[index];
+        uint32_t& head = slots_[2 * node.slot];
+        uint32_t& tail = slots_[2 * node.slot + 1];
+        if (node.prev != NONE) nodes_[node.prev].next = node.next;
+        else head = node.next;
+        if (node.next != NONE) nodes_[node.next].prev = node.prev;
+        else tail = node.prev;
+        if (head == NONE) occupied_[node.slot / SLOTS] &= ~(1ull << (node.slot % SLOTS));
+        node.prev = NONE;
+        node.next = NONE;
+        node.slot = NONE;
+    }
+
+    void TimerWheel::release(uint32_t index) {
+        Node& node = nodes_[index];
+        node.callback = nullptr;
+        node.slot = NONE;
+        node.generation++;
+        node.next = free_;
+        free_ = index;
+        pending_--;
+    }
+
+    uint32_t TimerWheel::find(TimerId id) const {
+        uint64_t low = id & 0xffffffffull;
+        if (low == 0 || low > nodes_.size()) return NONE;
+        uint32_t index = static_cast<uint32_t>(low - 1);
+        const Node& node = nodes_[index];
+        if (node.slot == NONE || (node.generation & 0x7fffffff) != ((id >> 32) & 0x7fffffff)) return NONE;
+        return index;
+    }
+
+    // Timers
+
+    TimerWheel Timers::time_wheel;
+    TimerWheel Timers::frame_wheel;
+    double Timers::carry_ms = 0.0;
+
+    TimerId Timers::after(float seconds, Callback callback) {
+        assert(EventDispatcher::isDispatchThread() && "Timers may only be used on the dispatch thread.");
+        double ms = std::ceil(static_cast<double>(seconds) * 1000.0);
+        return time_wheel.schedule(ms > 0.0 ? static_cast<uint64_t>(ms) : 0, std::move(callback));
+    }
+
+    TimerId Timers::afterFrames(unsigned int frames, Callback callback) {
+        assert(EventDispatcher::isDispatchThread() && "Timers may only be used on the dispatch thread.");
+        return frame_wheel.schedule(frames, std::move(callback)) | FRAME_TIMER;
+    }
+
+    bool Timers::cancel(TimerId id) {
+        assert(EventDispatcher::isDispatchThread() && "Timers may only be used on the dispatch thread.");
+        if ((id & FRAME_TIMER) != 0) return frame_wheel.cancel(id & ~FRAME_TIMER);
+        return time_wheel.cancel(id);
+    }
+
+    size_t Timers::advance(float delta_ms) {
+        assert(EventDispatcher::isDispatchThread() && "Timers may only be used on the dispatch thread.");
+        if (delta_ms > 0.0f) carry_ms += delta_ms;
+        uint64_t ticks = static_cast<uint64_t>(carry_ms);
+        carry_ms -= static_cast<double>(ticks);
+        size_t expired = frame_wheel.advance(1);
+        return expired + time_wheel.advance(ticks);
+    }
+
+    size_t Timers::pending() {
+        return time_wheel.pending() + frame_wheel.pending();
+    }
+
+    void Timers::clear() {
+        assert(EventDispatcher::isDispatchThread() && "Timers may only be used on the dispatch thread.");
+        time_wheel.clear();
+        frame_wheel.clear();
+        carry_ms = 0.0;
+    }
+
+}
@@ -22,4 +22,11 @@ namespace seedengine {
         updateTransformation();
     }
 
+    Transform Transform::interpolate(const Transform& from, const Transform& to, float alpha) {
+        return Transform(
+            glm::mix(from.position_, to.position_, alpha),
+            glm::slerp(from.rotation_, to.rotation_, alpha),
+            glm::mix(from.scale_, to.scale_, alpha));
+    }
+
 }
\ No newline at end of file
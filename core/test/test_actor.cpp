@@ -3,8 +3,72 @@
 #include <iostream>
 #include <gtest/gtest.h>
 #include "Actor.hpp"
+#include "Tick.hpp"
+
+namespace {
+
+    class CounterComponent : public seedengine::Component {
+    public:
+        CounterComponent(seedengine::Actor& actor) : Component(actor) {}
+        void update() override { count++; }
+        int count = 0;
+    };
+
+}
 
 TEST(ActorTest, GeneralTest) {
     using namespace seedengine;
     
-}
\ No newline at end of file
+}
+
+TEST(ActorTest, ComponentTest) {
+    using namespace seedengine;
+
+    Actor actor;
+    EXPECT_EQ(actor.getComponent<CounterComponent>(), nullptr);
+
+    CounterComponent& first = actor.addComponent<CounterComponent>();
+    actor.addComponent<CounterComponent>();
+    EXPECT_EQ(actor.getComponent<CounterComponent>(), &first);
+    EXPECT_EQ(actor.getComponents<CounterComponent>().size(), 2u);
+
+    first.update();
+    EXPECT_EQ(first.count, 1);
+}
+
+TEST(ActorTest, PauseTest) {
+    using namespace seedengine;
+
+    Actor game;
+    CounterComponent& game_counter = game.addComponent<CounterComponent>();
+    Actor menu(Transform(), ActorProperties(false, false));
+    CounterComponent& menu_counter = menu.addComponent<CounterComponent>();
+    TickScheduler scheduler;
+    scheduler.add(game);
+    scheduler.add(menu);
+
+    // Pausing stops scaled time, but updates still step from unscaled time
+    if (!Time::isPaused()) Time::togglePause();
+    Time::beginFrame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    Time::beginFrame();
+    EXPECT_EQ(Time::getDeltaTime(), 0.0f);
+    EXPECT_GE(Time::getStepTime(), 0.005f);
+
+    FixedTimestep timestep;
+    timestep.setInterval(1.0);
+    timestep.setMaxSteps(5);
+    timestep.advance(Time::getStepTime() * 1000.0f);
+    while (timestep.step()) scheduler.tick(Time::isPaused());
+    timestep.endFrame();
+
+    // Only the actor that cannot pause was ticked
+    EXPECT_EQ(game_counter.count, 0);
+    EXPECT_EQ(menu_counter.count, 5);
+
+    Time::togglePause();
+    EXPECT_FALSE(Time::isPaused());
+    EXPECT_EQ(Time::getTimeScale(), 1.0f);
+    scheduler.tick(Time::isPaused());
+    EXPECT_EQ(game_counter.count, 1);
+}
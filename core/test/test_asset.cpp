@@ -38,4 +38,32 @@ TEST(AssetTest, LoadTest) {
     EXPECT_NE(AssetLibrary<Image>::load(CORE_PATH("data/confictura_flame_icon.png")), nullptr);
     EXPECT_NE(AssetLibrary<Image>::load(CORE_PATH("data/confictura_flame_icon.png")), nullptr);
 
-}
\ No newline at end of file
+}
+
+TEST(AssetTest, ResidencyTest) {
+    using namespace seedengine;
+
+    auto tex = AssetLibrary<Image>::load(CORE_PATH("data/confictura_flame_icon.png"));
+    ASSERT_NE(tex, nullptr);
+    EXPECT_NE(tex->residentData(), nullptr);
+    EXPECT_EQ(tex->residentBytes(), tex->fullBytes());
+
+    // Discarding the CPU copy keeps the asset loaded
+    tex->setResidency(ResidencyPolicy::DISCARD);
+    EXPECT_TRUE(tex->isLoaded());
+    EXPECT_EQ(tex->residentData(), nullptr);
+    EXPECT_EQ(tex->residentBytes(), 0u);
+    EXPECT_GE(AssetLibrary<Image>::savedBytes(), tex->fullBytes());
+    EXPECT_NE(AssetLibrary<Image>::request(CORE_PATH("data/confictura_flame_icon.png")), nullptr);
+
+    // The CPU copy is reloaded on demand
+    EXPECT_NE(tex->data(), nullptr);
+    EXPECT_EQ(tex->residentBytes(), tex->fullBytes());
+    tex->releaseData();
+    EXPECT_EQ(tex->residentData(), nullptr);
+
+    tex->setResidency(ResidencyPolicy::KEEP);
+    EXPECT_NE(tex->data(), nullptr);
+    EXPECT_EQ(residencyFromString("compact"), ResidencyPolicy::COMPACT);
+
+}
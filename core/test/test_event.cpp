@@ -4,7 +4,624 @@
 #include <gtest/gtest.h>
 #include "Event.hpp"
 
+namespace {
+
+    using namespace seedengine;
+
+    /** A mouse moved event that is never coalesced. */
+    class RawMouseMovedEvent : public MouseMovedEvent {
+    public:
+        using MouseMovedEvent::MouseMovedEvent;
+        static const EventCoalescing COALESCING = EventCoalescing::NONE;
+    };
+
+    /** A mouse scrolled event that is never coalesced. */
+    class RawMouseScrolledEvent : public MouseScrolledEvent {
+    public:
+        using MouseScrolledEvent::MouseScrolledEvent;
+        static const EventCoalescing COALESCING = EventCoalescing::NONE;
+    };
+
+}
+
 TEST(EventTest, GeneralTest) {
     using namespace seedengine;
-    
-}
\ No newline at end of file
+
+}
+
+TEST(EventTest, QueueTest) {
+    using namespace seedengine;
+
+    EventQueue queue;
+    for (int i = 0; i < 4; i++) queue.emplace<MouseScrolledEvent>(static_cast<float>(i), 0.0f);
+    queue.emplace<KeyboardEvent>(1, 0, input::ButtonState::PRESSED, 0);
+    ASSERT_EQ(queue.size(), 5u);
+
+    // Destroyed events are removed in bulk, keeping the order of the rest
+    queue.destroy(0);
+    queue.destroy(2);
+    queue.compact();
+    ASSERT_EQ(queue.size(), 3u);
+    EXPECT_FLOAT_EQ(static_cast<MouseScrolledEvent*>(queue.at(0))->x_offset(), 1.0f);
+    EXPECT_FLOAT_EQ(static_cast<MouseScrolledEvent*>(queue.at(1))->x_offset(), 3.0f);
+    EXPECT_TRUE(queue.at(2)->getId() == KeyboardEvent::EVENT_ID);
+
+    // Once warm, filling and draining the queue reuses the same pages
+    queue.clear();
+    EXPECT_TRUE(queue.empty());
+    for (int frame = 0; frame < 3; frame++) {
+        for (int i = 0; i < 2000; i++) queue.emplace<MouseMovedEvent>(0.5f, 0.5f);
+        queue.clear();
+    }
+    size_t pages = queue.pages();
+    EXPECT_GT(pages, 1u);
+    for (int frame = 0; frame < 3; frame++) {
+        for (int i = 0; i < 2000; i++) queue.emplace<MouseMovedEvent>(0.5f, 0.5f);
+        queue.clear();
+    }
+    EXPECT_EQ(queue.pages(), pages);
+}
+
+TEST(EventTest, DispatchTest) {
+    using namespace seedengine;
+
+    std::vector<unsigned int> buttons;
+    EventSubscription subscription = EventDispatcher::subscribe(MouseButtonEvent::EVENT_ID, [&buttons](Event& e) {
+        buttons.push_back(static_cast<MouseButtonEvent&>(e).buttonId());
+        // Events pushed during a run wait for the next run
+        if (buttons.size() == 1) EventDispatcher::push<MouseButtonEvent>(9, input::ButtonState::PRESSED, 0);
+    });
+
+    EventDispatcher::push<MouseButtonEvent>(1, input::ButtonState::PRESSED, 0);
+    EventDispatcher::push<WindowRefreshEvent>(nullptr);
+    EventDispatcher::push<MouseButtonEvent>(2, input::ButtonState::RELEASED, 0);
+
+    // Filtered out events stay queued
+    EventDispatcher::run(static_cast<unsigned int>(EventType::MOUSE));
+    ASSERT_EQ(buttons.size(), 2u);
+    EXPECT_EQ(buttons[0], 1u);
+    EXPECT_EQ(buttons[1], 2u);
+    EXPECT_EQ(EventDispatcher::pending(), 2u);
+
+    EXPECT_EQ(EventDispatcher::pending(static_cast<unsigned int>(EventType::WINDOW)), 1u);
+    EventDispatcher::run(0);
+    ASSERT_EQ(buttons.size(), 3u);
+    EXPECT_EQ(buttons[2], 9u);
+    EXPECT_EQ(EventDispatcher::pending(), 0u);
+}
+
+TEST(EventTest, CoalesceTest) {
+    using namespace seedengine;
+
+    std::vector<float> scrolls;
+    std::vector<unsigned int> widths;
+    EventSubscription scroll = EventDispatcher::subscribe(MouseScrolledEvent::EVENT_ID, [&scrolls](Event& e) {
+        scrolls.push_back(static_cast<MouseScrolledEvent&>(e).y_offset());
+    });
+    EventSubscription resize = EventDispatcher::subscribe(WindowResizeEvent::EVENT_ID, [&widths](Event& e) {
+        widths.push_back(static_cast<WindowResizeEvent&>(e).width());
+    });
+    Window* first = reinterpret_cast<Window*>(0x10);
+    Window* second = reinterpret_cast<Window*>(0x20);
+    size_t coalesced = EventDispatcher::coalesced();
+
+    // Scroll deltas accumulate and sizes keep the latest value, per window
+    for (int i = 0; i < 10; i++) {
+        EventDispatcher::push<MouseScrolledEvent>(0.0f, 1.0f);
+        EventDispatcher::push<WindowResizeEvent>(first, 100 + i, 100);
+    }
+    EventDispatcher::push<WindowResizeEvent>(second, 50, 50);
+    EXPECT_EQ(EventDispatcher::pending(), 3u);
+    EXPECT_EQ(EventDispatcher::coalesced() - coalesced, 18u);
+
+    EventDispatcher::run(0);
+    ASSERT_EQ(scrolls.size(), 1u);
+    EXPECT_FLOAT_EQ(scrolls[0], 10.0f);
+    ASSERT_EQ(widths.size(), 2u);
+    EXPECT_EQ(widths[0], 109u);
+    EXPECT_EQ(widths[1], 50u);
+
+    // Run events are never combined with new ones
+    EventDispatcher::push<MouseScrolledEvent>(0.0f, 2.0f);
+    EventDispatcher::run(0);
+    ASSERT_EQ(scrolls.size(), 2u);
+    EXPECT_FLOAT_EQ(scrolls[1], 2.0f);
+
+    // Events pushed by a deligate of the same type are run next time, not merged into the running one
+    std::vector<float> moves;
+    EventSubscription move = EventDispatcher::subscribe(MouseMovedEvent::EVENT_ID, [&moves](Event& e) {
+        moves.push_back(static_cast<MouseMovedEvent&>(e).x());
+        if (moves.size() == 1) EventDispatcher::push<MouseMovedEvent>(99.0f, 0.0f);
+    });
+    EventDispatcher::push<MouseMovedEvent>(1.0f, 0.0f);
+    EventDispatcher::run(0);
+    ASSERT_EQ(moves.size(), 1u);
+    EXPECT_FLOAT_EQ(moves[0], 1.0f);
+    EXPECT_EQ(EventDispatcher::pending(), 1u);
+    EventDispatcher::run(0);
+    ASSERT_EQ(moves.size(), 2u);
+    EXPECT_FLOAT_EQ(moves[1], 99.0f);
+}
+
+TEST(EventTest, CoalesceOrderTest) {
+    using namespace seedengine;
+
+    std::vector<string> order;
+    EventSubscription move = EventDispatcher::subscribe(MouseMovedEvent::EVENT_ID, [&order](Event& e) {
+        order.push_back("move " + std::to_string(static_cast<int>(static_cast<MouseMovedEvent&>(e).x())));
+    });
+    EventSubscription click = EventDispatcher::subscribe(MouseButtonEvent::EVENT_ID, [&order](Event& e) {
+        order.push_back("click");
+    });
+
+    // A move after a click is not combined with the move before it
+    EventDispatcher::push<MouseMovedEvent>(1.0f, 0.0f);
+    EventDispatcher::push<MouseMovedEvent>(2.0f, 0.0f);
+    EventDispatcher::push<MouseButtonEvent>(0, input::ButtonState::PRESSED, 0);
+    EventDispatcher::push<MouseMovedEvent>(3.0f, 0.0f);
+    EventDispatcher::push<MouseMovedEvent>(4.0f, 0.0f);
+    EXPECT_EQ(EventDispatcher::pending(), 3u);
+
+    EventDispatcher::run(0);
+    ASSERT_EQ(order.size(), 3u);
+    EXPECT_EQ(order[0], "move 2");
+    EXPECT_EQ(order[1], "click");
+    EXPECT_EQ(order[2], "move 4");
+}
+
+TEST(EventTest, SubscriptionTest) {
+    using namespace seedengine;
+
+    const unsigned int id = ClientEvent::EVENT_ID;
+    int first = 0;
+    int second = 0;
+    {
+        EventSubscription a = EventDispatcher::subscribe(id, [&first](Event& e) { first++; });
+        EventSubscription b;
+        {
+            // Handles can be moved without unbinding
+            EventSubscription inner = EventDispatcher::subscribe(id, [&second](Event& e) { second++; });
+            b = std::move(inner);
+            EXPECT_FALSE(inner.active());
+        }
+        EXPECT_EQ(EventDispatcher::deligateCount(id), 2u);
+        EventDispatcher::force<ClientEvent>();
+        EXPECT_EQ(first, 1);
+        EXPECT_EQ(second, 1);
+
+        b.reset();
+        EventDispatcher::force<ClientEvent>();
+        EXPECT_EQ(first, 2);
+        EXPECT_EQ(second, 1);
+    }
+    // Destroyed handles unbind their deligates
+    EXPECT_EQ(EventDispatcher::deligateCount(id), 0u);
+    EventDispatcher::force<ClientEvent>();
+    EXPECT_EQ(first, 2);
+
+    // Deligates bound or unbound during dispatch take effect afterwards
+    EventSubscription added;
+    EventSubscription self;
+    self = EventDispatcher::subscribe(id, [&](Event& e) {
+        first++;
+        self.reset();
+        added = EventDispatcher::subscribe(id, [&second](Event& e) { second++; });
+    });
+    EventDispatcher::force<ClientEvent>();
+    EXPECT_EQ(first, 3);
+    EXPECT_EQ(second, 1);
+    EventDispatcher::force<ClientEvent>();
+    EXPECT_EQ(first, 3);
+    EXPECT_EQ(second, 2);
+    EXPECT_EQ(EventDispatcher::deligateCount(id), 1u);
+}
+
+TEST(EventTest, ProfilerTest) {
+    using namespace seedengine;
+
+    const unsigned int id = ClientEvent::EVENT_ID;
+    const uint64_t token = ~0ull - 1;
+    DispatchProfiler::clear();
+    DispatchProfiler::setBudget(50000);
+    DispatchProfiler::name(token, "slow handler");
+
+    // Calls from 1 us to 100 us, half of them over the 50 us budget
+    for (uint64_t i = 1; i <= 100; i++) DispatchProfiler::record(id, token, i * 1000);
+    const DispatchProfiler::Entry* event = DispatchProfiler::event(id);
+    const DispatchProfiler::Entry* subscriber = DispatchProfiler::subscriber(token);
+    ASSERT_NE(event, nullptr);
+    ASSERT_NE(subscriber, nullptr);
+    EXPECT_EQ(event->times.count(), 100u);
+    EXPECT_GE(event->times.percentile(0.5), 50000u);
+    EXPECT_LE(event->times.percentile(0.5), 52000u);
+    EXPECT_GE(event->times.percentile(0.99), 99000u);
+    EXPECT_EQ(event->times.max(), 100000u);
+    EXPECT_EQ(event->slow_calls, 50u);
+    EXPECT_EQ(subscriber->name, "slow handler");
+    EXPECT_EQ(DispatchProfiler::slowCalls(), 50u);
+
+    std::ostringstream report;
+    DispatchProfiler::report(report);
+    EXPECT_NE(report.str().find("slow handler"), string::npos);
+
+#if ENGINE_PROFILE_DISPATCH
+    // Deligate calls are timed when profiling is built in
+    DispatchProfiler::clear();
+    EventSubscription timed = EventDispatcher::subscribe(id, [](Event& e) {}, "timed handler");
+    EventDispatcher::force<ClientEvent>();
+    ASSERT_NE(DispatchProfiler::event(id), nullptr);
+    EXPECT_EQ(DispatchProfiler::event(id)->times.count(), 1u);
+    std::ostringstream timed_report;
+    DispatchProfiler::report(timed_report);
+    EXPECT_NE(timed_report.str().find("timed handler"), string::npos);
+
+    // Unbound subscribers are forgotten
+    timed.reset();
+    std::ostringstream unbound_report;
+    DispatchProfiler::report(unbound_report);
+    EXPECT_EQ(unbound_report.str().find("timed handler"), string::npos);
+#endif
+
+    DispatchProfiler::clear();
+    DispatchProfiler::setBudget(0);
+    EXPECT_EQ(DispatchProfiler::event(id), nullptr);
+}
+
+TEST(EventTest, CategoryTest) {
+    using namespace seedengine;
+
+    std::vector<unsigned int> order;
+    EventSubscription keyboard = EventDispatcher::subscribe(KeyboardEvent::EVENT_ID, [&order](Event& e) {
+        order.push_back(static_cast<KeyboardEvent&>(e).keycode());
+    });
+    EventSubscription controller = EventDispatcher::subscribe(ControllerButtonEvent::EVENT_ID, [&order](Event& e) {
+        order.push_back(100 + static_cast<ControllerButtonEvent&>(e).buttonId());
+    });
+
+    EventDispatcher::push<KeyboardEvent>(1, 0, input::ButtonState::PRESSED, 0);
+    EventDispatcher::push<ControllerButtonEvent>(0, 1, input::ButtonState::PRESSED);
+    EventDispatcher::push<KeyboardEvent>(2, 0, input::ButtonState::RELEASED, 0);
+    EventDispatcher::push<ControllerButtonEvent>(0, 2, input::ButtonState::PRESSED);
+
+    // Filters only run matching categories, in push order within each category
+    EventDispatcher::run(static_cast<unsigned int>(EventType::CONTROLLER));
+    ASSERT_EQ(order.size(), 2u);
+    EXPECT_EQ(order[0], 101u);
+    EXPECT_EQ(order[1], 102u);
+    EXPECT_EQ(EventDispatcher::pending(static_cast<unsigned int>(EventType::PERIPHERAL)), 2u);
+
+    EventDispatcher::run(static_cast<unsigned int>(EventType::PERIPHERAL));
+    ASSERT_EQ(order.size(), 4u);
+    EXPECT_EQ(order[2], 1u);
+    EXPECT_EQ(order[3], 2u);
+    EXPECT_EQ(EventDispatcher::pending(), 0u);
+}
+
+TEST(EventTest, QueueBenchmark) {
+    using namespace seedengine;
+
+    const int frames = 200;
+    const int events_per_frame = 1000;
+    unsigned int handled = 0;
+    EventDispatcher::EventDeligate deligate = [&handled](Event& e) { handled++; };
+
+    // The previous design: a shared pointer per event in a standard queue
+    auto start = std::chrono::high_resolution_clock::now();
+    std::queue<std::shared_ptr<Event>> shared_queue;
+    for (int f = 0; f < frames; f++) {
+        for (int i = 0; i < events_per_frame; i++) {
+            shared_queue.push(std::make_shared<MouseMovedEvent>(0.5f, 0.5f));
+        }
+        while (!shared_queue.empty()) {
+            auto next = shared_queue.front();
+            shared_queue.pop();
+            deligate(*next);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double shared_s = std::chrono::duration<double>(end - start).count();
+
+    // The arena queue
+    start = std::chrono::high_resolution_clock::now();
+    EventQueue queue;
+    for (int f = 0; f < frames; f++) {
+        for (int i = 0; i < events_per_frame; i++) {
+            queue.emplace<MouseMovedEvent>(0.5f, 0.5f);
+        }
+        for (size_t i = 0; i < queue.size(); i++) {
+            deligate(*queue.at(i));
+            queue.destroy(i);
+        }
+        queue.compact();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double arena_s = std::chrono::duration<double>(end - start).count();
+
+    EXPECT_EQ(handled, 2u * frames * events_per_frame);
+    double total = static_cast<double>(frames) * events_per_frame;
+    std::cout << "Shared pointer queue: " << total / shared_s / 1e6 << " M events/s" << std::endl;
+    std::cout << "Arena queue: " << total / arena_s / 1e6 << " M events/s" << std::endl;
+}
+
+TEST(EventTest, FilterBenchmark) {
+    using namespace seedengine;
+
+    const int frames = 200;
+    const unsigned int filters[] = {
+        static_cast<unsigned int>(EventType::ENGINE),
+        static_cast<unsigned int>(EventType::CONTROLLER),
+        static_cast<unsigned int>(EventType::KEYBOARD),
+        static_cast<unsigned int>(EventType::WINDOW),
+        static_cast<unsigned int>(EventType::CLIENT),
+        static_cast<unsigned int>(EventType::MOUSE)
+    };
+
+    unsigned int handled = 0;
+    EventDispatcher::EventDeligate deligate = [&handled](Event& e) { handled++; };
+    std::map<const unsigned int, std::vector<EventDispatcher::EventDeligate>> registry;
+    const unsigned int ids[] = {
+        ControllerAxisEvent::EVENT_ID, KeyboardEvent::EVENT_ID, WindowRefreshEvent::EVENT_ID, ClientEvent::EVENT_ID
+    };
+    std::vector<EventSubscription> subscriptions;
+    for (unsigned int id : ids) {
+        registry[id].push_back(deligate);
+        subscriptions.push_back(EventDispatcher::subscribe(id, deligate));
+    }
+
+    auto pushFrame = [](EventQueue* queue) {
+        for (int i = 0; i < 1000; i++) {
+            if (i % 10 == 0) {
+                if (queue) queue->emplace<KeyboardEvent>(1, 0, input::ButtonState::PRESSED, 0);
+                else EventDispatcher::push<KeyboardEvent>(1, 0, input::ButtonState::PRESSED, 0);
+            }
+            else if (i % 10 == 1) {
+                if (queue) queue->emplace<WindowRefreshEvent>(nullptr);
+                else EventDispatcher::push<WindowRefreshEvent>(nullptr);
+            }
+            else if (i % 10 == 2) {
+                if (queue) queue->emplace<ClientEvent>();
+                else EventDispatcher::push<ClientEvent>();
+            }
+            else {
+                if (queue) queue->emplace<ControllerAxisEvent>(0u, 0u, 0.5f, 0.5f);
+                else EventDispatcher::push<ControllerAxisEvent>(0u, 0u, 0.5f, 0.5f);
+            }
+        }
+    };
+
+    // The previous design: every run scans the whole buffer
+    auto start = std::chrono::high_resolution_clock::now();
+    EventQueue single;
+    for (int f = 0; f < frames; f++) {
+        pushFrame(&single);
+        for (unsigned int filter : filters) {
+            size_t q_size = single.size();
+            for (size_t i = 0; i < q_size; i++) {
+                Event* next = single.at(i);
+                if (!next->isType(static_cast<EventType>(filter))) continue;
+                for (auto& d : registry[next->getId()]) d(*next);
+                single.destroy(i);
+            }
+            single.compact();
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double single_s = std::chrono::duration<double>(end - start).count();
+    unsigned int single_handled = handled;
+
+    // Category partitioned buffers
+    handled = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) {
+        pushFrame(nullptr);
+        for (unsigned int filter : filters) EventDispatcher::run(filter);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double partitioned_s = std::chrono::duration<double>(end - start).count();
+
+    EXPECT_EQ(handled, single_handled);
+    EXPECT_EQ(EventDispatcher::pending(), 0u);
+    std::cout << "Re-queueing single buffer: " << single_s * 1e6 / frames << " us/frame" << std::endl;
+    std::cout << "Category partitioned buffers: " << partitioned_s * 1e6 / frames << " us/frame" << std::endl;
+}
+
+TEST(EventTest, ChannelStressTest) {
+    using namespace seedengine;
+
+    const unsigned int producers = 4;
+    const unsigned int per_producer = 50000;
+
+    // Each producer sends its events in order, the axis ID holds the sequence number
+    std::vector<unsigned int> next(producers, 0);
+    unsigned int received = 0;
+    unsigned int out_of_order = 0;
+    EventSubscription subscription = EventDispatcher::subscribe(ControllerAxisEvent::EVENT_ID,
+            [&next, &received, &out_of_order](Event& e) {
+        ControllerAxisEvent& axis = static_cast<ControllerAxisEvent&>(e);
+        if (axis.axisId() != next[axis.controllerId()]) out_of_order++;
+        next[axis.controllerId()] = axis.axisId() + 1;
+        received++;
+    });
+
+    std::vector<std::thread> threads;
+    for (unsigned int p = 0; p < producers; p++) {
+        threads.push_back(std::thread([p, per_producer]() {
+            for (unsigned int i = 0; i < per_producer; i++) {
+                EventDispatcher::push<ControllerAxisEvent>(p, i, 0.0f, 0.0f);
+            }
+        }));
+    }
+    while (received < producers * per_producer) {
+        EventDispatcher::run(static_cast<unsigned int>(EventType::CONTROLLER));
+    }
+    for (std::thread& t : threads) t.join();
+
+    EXPECT_EQ(received, producers * per_producer);
+    EXPECT_EQ(out_of_order, 0u);
+    EXPECT_EQ(EventDispatcher::pending(), 0u);
+
+    // A full channel rejects non-blocking pushes instead of waiting
+    std::thread([]() {
+        for (size_t i = 0; i < EventChannel::CAPACITY; i++) {
+            EXPECT_TRUE(EventDispatcher::tryPush<ControllerAxisEvent>(0u, static_cast<unsigned int>(i), 0.0f, 0.0f));
+        }
+        EXPECT_FALSE(EventDispatcher::tryPush<ControllerAxisEvent>(0u, 0u, 0.0f, 0.0f));
+    }).join();
+    next.assign(producers, 0);
+    EventDispatcher::run(static_cast<unsigned int>(EventType::CONTROLLER));
+    EXPECT_EQ(received, producers * per_producer + EventChannel::CAPACITY);
+    std::cout << "Producers waited on a full channel " << EventDispatcher::backpressure() << " times." << std::endl;
+}
+
+TEST(EventTest, HandoffTest) {
+    using namespace seedengine;
+
+    // A thread chosen to run the events before it starts receives pushes from this one
+    std::atomic<bool> go(false);
+    unsigned int received = 0;
+    std::thread dispatcher([&go, &received]() {
+        while (!go) std::this_thread::yield();
+        EXPECT_TRUE(EventDispatcher::isDispatchThread());
+        EventSubscription subscription = EventDispatcher::subscribe(ControllerAxisEvent::EVENT_ID,
+            [&received](Event& e) { received++; });
+        EventDispatcher::run(static_cast<unsigned int>(EventType::CONTROLLER));
+    });
+    EventDispatcher::setDispatchThread(dispatcher.get_id());
+    EXPECT_FALSE(EventDispatcher::isDispatchThread());
+    EventDispatcher::push<ControllerAxisEvent>(0u, 0u, 0.0f, 0.0f);
+    go = true;
+    dispatcher.join();
+    EventDispatcher::setDispatchThread();
+
+    EXPECT_EQ(received, 1u);
+    EXPECT_TRUE(EventDispatcher::isDispatchThread());
+    EXPECT_EQ(EventDispatcher::pending(), 0u);
+}
+
+TEST(EventTest, ChannelBenchmark) {
+    using namespace seedengine;
+
+    const unsigned int total = 200000;
+    unsigned int received = 0;
+    EventSubscription subscription = EventDispatcher::subscribe(SystemEvent::EVENT_ID, [&received](Event& e) { received++; });
+
+    unsigned int max_producers = std::max(4u, std::min(8u, std::thread::hardware_concurrency()));
+    for (unsigned int producers = 1; producers <= max_producers; producers *= 2) {
+        received = 0;
+        unsigned int per_producer = total / producers;
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        for (unsigned int p = 0; p < producers; p++) {
+            threads.push_back(std::thread([per_producer]() {
+                for (unsigned int i = 0; i < per_producer; i++) {
+                    EventDispatcher::push<SystemEvent>();
+                }
+            }));
+        }
+        while (received < per_producer * producers) {
+            EventDispatcher::run(static_cast<unsigned int>(EventType::SYSTEM));
+        }
+        for (std::thread& t : threads) t.join();
+        auto end = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(end - start).count();
+        std::cout << producers << " producer(s): " << received / seconds / 1e6 << " M events/s" << std::endl;
+    }
+}
+
+TEST(EventTest, FrameBenchmark) {
+    using namespace seedengine;
+
+    const int frames = 100000;
+    const int ticks_per_frame = 3;
+    unsigned int calls = 0;
+
+    // The previous design: a shared event, a map lookup and a copied std::function per deligate
+    std::map<const unsigned int, std::vector<std::function<void(Event&)>>> registry;
+    const unsigned int ids[] = {
+        EngineTickEvent::EVENT_ID, EnginePreRenderEvent::EVENT_ID,
+        EngineRenderEvent::EVENT_ID, EnginePostRenderEvent::EVENT_ID
+    };
+    for (unsigned int id : ids) {
+        for (int i = 0; i < 2; i++) registry[id].push_back([&calls](Event& e) { calls++; });
+    }
+    auto force = [&registry](const std::shared_ptr<Event>& event) {
+        for (std::function<void(Event&)> deligate : registry[event->getId()]) deligate(*event);
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) {
+        for (int t = 0; t < ticks_per_frame; t++) force(std::make_shared<EngineTickEvent>(0.016f));
+        force(std::make_shared<EnginePreRenderEvent>());
+        force(std::make_shared<EngineRenderEvent>());
+        force(std::make_shared<EnginePostRenderEvent>());
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double before_s = std::chrono::duration<double>(end - start).count();
+    unsigned int before_calls = calls;
+
+    // Stack events and pre-resolved deligate lists
+    std::vector<EventSubscription> subscriptions;
+    for (unsigned int id : ids) {
+        for (int i = 0; i < 2; i++) subscriptions.push_back(EventDispatcher::subscribe(id, [&calls](Event& e) { calls++; }));
+    }
+    calls = 0;
+    start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) {
+        for (int t = 0; t < ticks_per_frame; t++) EventDispatcher::force<EngineTickEvent>(0.016f);
+        EventDispatcher::force<EnginePreRenderEvent>();
+        EventDispatcher::force<EngineRenderEvent>();
+        EventDispatcher::force<EnginePostRenderEvent>();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double after_s = std::chrono::duration<double>(end - start).count();
+
+    EXPECT_EQ(calls, before_calls);
+    std::cout << "Shared events with map lookup: " << before_s * 1e9 / frames << " ns/frame" << std::endl;
+    std::cout << "Compile-time dispatch: " << after_s * 1e9 / frames << " ns/frame" << std::endl;
+}
+
+TEST(EventTest, CoalesceBenchmark) {
+    using namespace seedengine;
+
+    const int frames = 1000;
+    unsigned int dispatched = 0;
+    float scrolled = 0.0f;
+    EventSubscription moved = EventDispatcher::subscribe(MouseMovedEvent::EVENT_ID, [&dispatched](Event& e) {
+        dispatched++;
+    });
+    EventSubscription scroll = EventDispatcher::subscribe(MouseScrolledEvent::EVENT_ID, [&dispatched, &scrolled](Event& e) {
+        scrolled += static_cast<MouseScrolledEvent&>(e).y_offset();
+        dispatched++;
+    });
+
+    // Heavy input: hundreds of movements and scroll ticks between frames
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) {
+        for (int i = 0; i < 200; i++) EventDispatcher::push<RawMouseMovedEvent>(0.5f, 0.5f);
+        for (int i = 0; i < 50; i++) EventDispatcher::push<RawMouseScrolledEvent>(0.0f, 1.0f);
+        EventDispatcher::run(0);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double raw_s = std::chrono::duration<double>(end - start).count();
+    unsigned int raw_dispatched = dispatched;
+    float raw_scrolled = scrolled;
+
+    dispatched = 0;
+    scrolled = 0.0f;
+    start = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < frames; f++) {
+        for (int i = 0; i < 200; i++) EventDispatcher::push<MouseMovedEvent>(0.5f, 0.5f);
+        for (int i = 0; i < 50; i++) EventDispatcher::push<MouseScrolledEvent>(0.0f, 1.0f);
+        EventDispatcher::run(0);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double coalesced_s = std::chrono::duration<double>(end - start).count();
+
+    // The same total scroll arrives in far fewer dispatches
+    EXPECT_EQ(dispatched, 2u * frames);
+    EXPECT_FLOAT_EQ(scrolled, raw_scrolled);
+    std::cout << "Uncoalesced: " << raw_dispatched / frames << " dispatches, "
+        << raw_s * 1e6 / frames << " us/frame" << std::endl;
+    std::cout << "Coalesced: " << dispatched / frames << " dispatches, "
+        << coalesced_s * 1e6 / frames << " us/frame" << std::endl;
+}
@@ -0,0 +1,70 @@
+// test_headless.cpp
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "Headless.hpp"
+
+TEST(HeadlessTest, HashTest) {
+    using namespace seedengine;
+
+    RenderSnapshot a, b;
+    a.setCamera(glm::mat4(2.0f), glm::mat4(3.0f), glm::vec3(0.0f));
+    b.setCamera(glm::mat4(2.0f), glm::mat4(3.0f), glm::vec3(0.0f));
+    for (int i = 0; i < 8; i++) {
+        a.submit(nullptr, glm::mat4(static_cast<float>(i)));
+        b.submit(nullptr, glm::mat4(static_cast<float>(i)));
+    }
+
+    // Identical frames hash the same
+    EXPECT_EQ(HeadlessRenderer::hash(a), HeadlessRenderer::hash(b));
+
+    // Moving a single draw changes the hash
+    b.clear();
+    b.setCamera(glm::mat4(2.0f), glm::mat4(3.0f), glm::vec3(0.0f));
+    for (int i = 0; i < 8; i++) b.submit(nullptr, glm::mat4(i == 5 ? 5.5f : static_cast<float>(i)));
+    EXPECT_NE(HeadlessRenderer::hash(a), HeadlessRenderer::hash(b));
+}
+
+TEST(HeadlessTest, RenderTest) {
+    using namespace seedengine;
+
+    RenderSnapshot snapshot;
+    snapshot.setCamera(glm::mat4(1.0f), glm::mat4(1.0f), glm::vec3(0.0f));
+    snapshot.submit(nullptr, glm::mat4(1.0f));
+    snapshot.submit(nullptr, glm::mat4(2.0f));
+
+    // Each rendered frame is counted and recorded
+    uint64_t checksum;
+    {
+        HeadlessRenderer renderer;
+        string path = CORE_PATH("data/test_headless.csv");
+        EXPECT_TRUE(renderer.record(path));
+        EXPECT_TRUE(renderer.isRecording());
+        renderer.render(snapshot);
+        renderer.render(snapshot);
+        renderer.stop();
+        EXPECT_FALSE(renderer.isRecording());
+        EXPECT_EQ(renderer.frames(), 2u);
+        EXPECT_EQ(renderer.drawCounts().total(), 4u);
+        checksum = renderer.checksum();
+
+        // A line for each frame after the header
+        std::ifstream file(path);
+        string line;
+        std::vector<string> lines;
+        while (std::getline(file, line)) lines.push_back(line);
+        file.close();
+        std::remove(path.c_str());
+        ASSERT_EQ(lines.size(), 3u);
+        EXPECT_EQ(lines[0], "frame,draws,hash");
+        EXPECT_EQ(lines[1], lines[2]);
+        EXPECT_EQ(lines[1].substr(0, 4), "0,2,");
+    }
+
+    // The same frames give the same checksum
+    HeadlessRenderer renderer;
+    renderer.render(snapshot);
+    renderer.render(snapshot);
+    EXPECT_EQ(renderer.checksum(), checksum);
+    std::cout << renderer.summary() << std::endl;
+}
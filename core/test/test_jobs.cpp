@@ -0,0 +1,157 @@
+// test_jobs.cpp
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "Jobs.hpp"
+#include "Time.hpp"
+
+TEST(JobsTest, QueueTest) {
+    using namespace seedengine;
+
+    std::vector<jobs::Job> items(1000);
+    jobs::WorkQueue queue;
+    EXPECT_EQ(queue.pop(), nullptr);
+    EXPECT_EQ(queue.steal(), nullptr);
+
+    // Grows past its initial capacity
+    for (jobs::Job& item : items) queue.push(&item);
+    EXPECT_EQ(queue.size(), items.size());
+
+    // The owner takes the newest job, thieves the oldest
+    EXPECT_EQ(queue.pop(), &items.back());
+    EXPECT_EQ(queue.steal(), &items.front());
+    EXPECT_EQ(queue.size(), items.size() - 2);
+
+    size_t taken = 0;
+    while (queue.pop() != nullptr) taken++;
+    EXPECT_EQ(taken, items.size() - 2);
+    EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(JobsTest, StealTest) {
+    using namespace seedengine;
+
+    const size_t count = 200000;
+    std::vector<jobs::Job> items(count);
+    std::vector<std::atomic<int>> taken(count);
+    for (std::atomic<int>& t : taken) t.store(0);
+
+    jobs::WorkQueue queue;
+    std::atomic<bool> done(false);
+    auto take = [&](jobs::Job* job) { taken[job - &items[0]].fetch_add(1); };
+
+    // Thieves race the owner for every job
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < 3; i++) {
+        thieves.emplace_back([&]() {
+            while (!done.load() || queue.size() > 0) {
+                if (jobs::Job* job = queue.steal()) take(job);
+                else std::this_thread::yield();
+            }
+        });
+    }
+    for (size_t i = 0; i < count; i++) {
+        queue.push(&items[i]);
+        if (i % 3 == 0) {
+            if (jobs::Job* job = queue.pop()) take(job);
+        }
+    }
+    while (jobs::Job* job = queue.pop()) take(job);
+    done.store(true);
+    for (std::thread& thief : thieves) thief.join();
+
+    // Every job was taken exactly once
+    size_t wrong = 0;
+    for (std::atomic<int>& t : taken) if (t.load() != 1) wrong++;
+    EXPECT_EQ(wrong, 0u);
+}
+
+TEST(JobsTest, RunTest) {
+    using namespace seedengine;
+
+    // Jobs run at once while the job system is stopped
+    int direct = 0;
+    jobs::run([&direct]() { direct++; });
+    EXPECT_EQ(direct, 1);
+
+    jobs::start(3);
+    EXPECT_TRUE(jobs::running());
+    EXPECT_EQ(jobs::workerCount(), 3u);
+
+    std::atomic<int> sum(0);
+    jobs::Counter counter;
+    for (int i = 1; i <= 10000; i++) jobs::run([&sum, i]() { sum.fetch_add(i); }, counter);
+    jobs::wait(counter);
+    EXPECT_TRUE(counter.done());
+    EXPECT_EQ(sum.load(), 50005000);
+
+    // Jobs that wait on jobs of their own help instead of blocking
+    std::atomic<int> leaves(0);
+    jobs::Counter outer;
+    for (int i = 0; i < 16; i++) {
+        jobs::run([&leaves]() {
+            jobs::Counter inner;
+            for (int j = 0; j < 64; j++) jobs::run([&leaves]() { leaves.fetch_add(1); }, inner);
+            jobs::wait(inner);
+        }, outer);
+    }
+    jobs::wait(outer);
+    EXPECT_EQ(leaves.load(), 16 * 64);
+
+    // Threads without a queue go through the shared queue
+    std::atomic<int> external(0);
+    jobs::Counter from_thread;
+    std::thread thread([&]() {
+        for (int i = 0; i < 100; i++) jobs::run([&external]() { external.fetch_add(1); }, from_thread);
+        jobs::wait(from_thread);
+    });
+    thread.join();
+    EXPECT_EQ(external.load(), 100);
+
+    // Every index is processed once
+    std::vector<int> hits(100000, 0);
+    jobs::parallelFor(0, hits.size(), [&hits](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) hits[i]++;
+    });
+    EXPECT_EQ(std::count(hits.begin(), hits.end(), 1), static_cast<long>(hits.size()));
+    EXPECT_GT(jobs::executed(), 10000u);
+
+    // Jobs still queued are run before stopping
+    std::atomic<int> late(0);
+    for (int i = 0; i < 100; i++) jobs::run([&late]() { late.fetch_add(1); });
+    jobs::stop();
+    EXPECT_FALSE(jobs::running());
+    EXPECT_EQ(late.load(), 100);
+}
+
+TEST(JobsTest, ScalingBenchmark) {
+    using namespace seedengine;
+
+    const size_t count = 1 << 20;
+    std::vector<float> values(count);
+    auto body = [&values](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            float x = static_cast<float>(i);
+            for (int k = 0; k < 32; k++) x = std::sqrt(x * 1.0001f + 1.0f);
+            values[i] = x;
+        }
+    };
+
+    unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "parallelFor over " << count << " items on " << cores << " cores:" << std::endl;
+    double base = 0.0;
+    for (unsigned int threads = 1; threads <= cores; threads++) {
+        jobs::start(threads - 1);
+        // Warm up the workers before timing
+        jobs::parallelFor(0, count / 16, body);
+
+        int64_t start = Time::nowNS();
+        for (int i = 0; i < 4; i++) jobs::parallelFor(0, count, body);
+        double ms = (Time::nowNS() - start) / 4000000.0;
+        if (threads == 1) base = ms;
+        std::cout << "  " << threads << " threads: " << ms << " ms, speedup " << base / ms
+                  << ", " << jobs::stolen() << " steals" << std::endl;
+        jobs::stop();
+    }
+    EXPECT_GT(values[count - 1], 0.0f);
+}
@@ -0,0 +1,84 @@
+// test_manifest.cpp
+
+#include <iostream>
+#include <thread>
+#include <gtest/gtest.h>
+#include "Manifest.hpp"
+
+TEST(ManifestTest, ScanTest) {
+    using namespace seedengine;
+
+    AssetManifest::clear();
+    EXPECT_GT(AssetManifest::scan(CORE_PATH("data")), 0u);
+
+    string icon = CORE_PATH("data/confictura_flame_icon.png");
+    EXPECT_TRUE(AssetManifest::covers(icon));
+    EXPECT_TRUE(AssetManifest::exists(icon));
+    EXPECT_FALSE(AssetManifest::exists(CORE_PATH("data/test_fail_x.png")));
+    EXPECT_EQ(AssetManifest::probesAvoided(), 1u);
+
+    ASSERT_NE(AssetManifest::find(icon), nullptr);
+    EXPECT_EQ(AssetManifest::find(icon)->type, AssetType::IMAGE);
+    EXPECT_GT(AssetManifest::size(icon), 0u);
+    EXPECT_EQ(AssetManifest::hash(icon), AssetManifest::hashFile(icon));
+
+    AssetManifest::clear();
+}
+
+TEST(ManifestTest, LoadTest) {
+    using namespace seedengine;
+
+    string manifest_path = CORE_PATH("data/test.manifest");
+    {
+        std::ofstream manifest(manifest_path);
+        manifest << "# Test manifest" << std::endl;
+        manifest << "12 ff 2 models/test.mesh" << std::endl;
+    }
+
+    AssetManifest::clear();
+    EXPECT_TRUE(AssetManifest::load(manifest_path));
+    EXPECT_TRUE(AssetManifest::exists(CORE_PATH("data/models/test.mesh")));
+    EXPECT_EQ(AssetManifest::size(CORE_PATH("data/models/test.mesh")), 12u);
+    EXPECT_EQ(AssetManifest::hash(CORE_PATH("data/models/test.mesh")), 0xffu);
+
+    // Files missing from a stale manifest are found on disk and added to it
+    EXPECT_EQ(AssetManifest::find(CORE_PATH("data/defaults.ini")), nullptr);
+    EXPECT_TRUE(AssetManifest::exists(CORE_PATH("data/defaults.ini")));
+    ASSERT_NE(AssetManifest::find(CORE_PATH("data/defaults.ini")), nullptr);
+    EXPECT_GT(AssetManifest::size(CORE_PATH("data/defaults.ini")), 0u);
+    EXPECT_FALSE(AssetManifest::exists(CORE_PATH("data/models/missing.mesh")));
+    EXPECT_FALSE(AssetManifest::load(CORE_PATH("data/missing.manifest")));
+
+    AssetManifest::clear();
+    std::remove(manifest_path.c_str());
+}
+
+TEST(ManifestTest, ConcurrentTest) {
+    using namespace seedengine;
+
+    AssetManifest::clear();
+    string manifest_path = CORE_PATH("data/test_concurrent.manifest");
+    {
+        std::ofstream manifest(manifest_path);
+        manifest << "12 ff 2 models/test.mesh" << std::endl;
+    }
+    ASSERT_TRUE(AssetManifest::load(manifest_path));
+
+    // Stale misses add entries while other threads look entries up
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 200; i++) {
+                EXPECT_TRUE(AssetManifest::exists(CORE_PATH("data/defaults.ini")));
+                EXPECT_TRUE(AssetManifest::exists(CORE_PATH("data/models/test.mesh")));
+                EXPECT_FALSE(AssetManifest::exists(CORE_PATH("data/models/missing.mesh")));
+                EXPECT_GT(AssetManifest::hash(CORE_PATH("data/defaults.ini")), 0u);
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    EXPECT_EQ(AssetManifest::count(), 2u);
+
+    AssetManifest::clear();
+    std::remove(manifest_path.c_str());
+}
@@ -0,0 +1,94 @@
+// test_memory.cpp
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "Memory.hpp"
+#include "Event.hpp"
+#include "Snapshot.hpp"
+
+TEST(MemoryTest, TrackerTest) {
+    using namespace seedengine;
+
+    // Other tests share the counters, so only the changes are checked
+    MemoryUsage before = MemoryTracker::usage(MemoryTag::SCENE);
+    {
+        TrackedVector<int, MemoryTag::SCENE> values;
+        values.reserve(100);
+        MemoryUsage usage = MemoryTracker::usage(MemoryTag::SCENE);
+        EXPECT_EQ(usage.live_bytes, before.live_bytes + 100 * sizeof(int));
+        EXPECT_EQ(usage.live_allocations, before.live_allocations + 1);
+        EXPECT_EQ(usage.allocations, before.allocations + 1);
+
+        // Both blocks are live while the vector moves, which the peak keeps
+        values.reserve(200);
+        usage = MemoryTracker::usage(MemoryTag::SCENE);
+        EXPECT_EQ(usage.live_bytes, before.live_bytes + 200 * sizeof(int));
+        EXPECT_EQ(usage.allocations, before.allocations + 2);
+        EXPECT_GE(usage.peak_bytes, before.live_bytes + 300 * sizeof(int));
+        EXPECT_GE(MemoryTracker::frameAllocations(MemoryTag::SCENE), 2u);
+    }
+    MemoryUsage after = MemoryTracker::usage(MemoryTag::SCENE);
+    EXPECT_EQ(after.live_bytes, before.live_bytes);
+    EXPECT_EQ(after.live_allocations, before.live_allocations);
+
+    // Resized memory keeps its contents and moves between tags
+    before = MemoryTracker::usage(MemoryTag::IMAGE);
+    unsigned char* memory = static_cast<unsigned char*>(MemoryTracker::allocate(16, MemoryTag::IMAGE));
+    ASSERT_NE(memory, nullptr);
+    for (int i = 0; i < 16; i++) memory[i] = static_cast<unsigned char>(i);
+    memory = static_cast<unsigned char*>(MemoryTracker::reallocate(memory, 4096, MemoryTag::IMAGE));
+    ASSERT_NE(memory, nullptr);
+    EXPECT_EQ(memory[15], 15);
+    EXPECT_EQ(MemoryTracker::usage(MemoryTag::IMAGE).live_bytes, before.live_bytes + 4096);
+    EXPECT_EQ(MemoryTracker::usage(MemoryTag::IMAGE).live_allocations, before.live_allocations + 1);
+    MemoryTracker::deallocate(memory);
+    MemoryTracker::deallocate(nullptr);
+    EXPECT_EQ(MemoryTracker::usage(MemoryTag::IMAGE).live_bytes, before.live_bytes);
+
+    // Global allocations only count against a scope when they are hooked
+    before = MemoryTracker::usage(MemoryTag::LOG);
+    {
+        MemoryTagScope scope(MemoryTag::LOG);
+        EXPECT_TRUE(MemoryTagScope::current() == MemoryTag::LOG);
+        std::unique_ptr<std::vector<int>> values(new std::vector<int>(64));
+        EXPECT_EQ(MemoryTracker::usage(MemoryTag::LOG).allocations - before.allocations, MemoryTracker::isHooked() ? 2u : 0u);
+    }
+    EXPECT_TRUE(MemoryTagScope::current() == MemoryTag::UNTAGGED);
+
+    EXPECT_STREQ(MemoryTracker::tagName(MemoryTag::MESH), "Assets/Mesh");
+    MemoryTracker::report(std::cout);
+    std::cout << MemoryTracker::summary() << std::endl;
+}
+
+TEST(MemoryTest, FrameLimitTest) {
+    using namespace seedengine;
+
+    // Steady state frames of the event queue and render snapshot allocate nothing
+    MemoryTracker::endFrame();
+    MemoryTracker::setFrameLimit(MemoryTag::EVENTS, 0);
+    MemoryTracker::setFrameLimit(MemoryTag::RENDER, 0);
+    uint64_t violations = MemoryTracker::violations();
+
+    EventQueue queue;
+    RenderSnapshot snapshot;
+    for (int frame = 0; frame < 8; frame++) {
+        for (int i = 0; i < 256; i++) {
+            queue.emplace<MouseScrolledEvent>(static_cast<float>(i), 0.0f);
+            snapshot.submit(nullptr, glm::mat4(static_cast<float>(i)));
+        }
+        queue.clear();
+        snapshot.clear();
+
+        // Only the first frame grows the queue and the draw list
+        EXPECT_EQ(MemoryTracker::endFrame(), frame > 0) << "frame " << frame;
+    }
+    EXPECT_EQ(MemoryTracker::violations(), violations + 1);
+    EXPECT_EQ(MemoryTracker::usage(MemoryTag::EVENTS).frame_allocations, 0u);
+
+    // Limits are lifted
+    MemoryTracker::setFrameLimit(MemoryTracker::NO_LIMIT);
+    queue.emplace<MouseScrolledEvent>(0.0f, 0.0f);
+    TrackedVector<int, MemoryTag::RENDER> values(16);
+    EXPECT_TRUE(MemoryTracker::endFrame());
+    EXPECT_EQ(MemoryTracker::usage(MemoryTag::RENDER).frame_allocations, 1u);
+}
@@ -0,0 +1,81 @@
+// test_pacer.cpp
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include <ctime>
+#include "Pacer.hpp"
+
+TEST(PacerTest, WaitTest) {
+    using namespace seedengine;
+
+    FramePacer pacer(500000);
+    int64_t start = Time::nowNS();
+
+    // A passed deadline returns at once
+    EXPECT_GE(pacer.waitUntil(start - 1000000), 1000000);
+
+    for (int i = 1; i <= 5; i++) {
+        int64_t deadline = start + i * 2000000;
+        EXPECT_GE(pacer.waitUntil(deadline), 0);
+        EXPECT_GE(Time::nowNS(), deadline);
+    }
+    EXPECT_EQ(pacer.errors().count(), 6u);
+    EXPECT_EQ(pacer.intervals().count(), 5u);
+    EXPECT_GT(pacer.sleptNS(), 0);
+
+    pacer.reset();
+    EXPECT_EQ(pacer.errors().count(), 0u);
+}
+
+TEST(PacerTest, PacingBenchmark) {
+    using namespace seedengine;
+
+    // 60 frames at 200 fps, each doing 1 ms of work
+    const int frames = 60;
+    const int64_t frame_ns = 5000000;
+    auto work = []() {
+        int64_t until = Time::nowNS() + 1000000;
+        while (Time::nowNS() < until) {}
+    };
+
+    // The old loop: spin on the clock until the deadline
+    util::Histogram busy_intervals;
+    double busy_mean = 0.0, busy_m2 = 0.0;
+    std::clock_t busy_cpu = std::clock();
+    int64_t frame_start = Time::nowNS();
+    int64_t last = -1;
+    for (int i = 0; i < frames; i++) {
+        work();
+        while (Time::nowNS() < frame_start + frame_ns) {}
+        int64_t now = Time::nowNS();
+        if (last >= 0) {
+            busy_intervals.record(static_cast<uint64_t>(now - last));
+            double delta = (now - last) - busy_mean;
+            busy_mean += delta / busy_intervals.count();
+            busy_m2 += delta * ((now - last) - busy_mean);
+        }
+        last = now;
+        frame_start += frame_ns;
+    }
+    busy_cpu = std::clock() - busy_cpu;
+
+    FramePacer pacer;
+    std::clock_t paced_cpu = std::clock();
+    frame_start = Time::nowNS();
+    for (int i = 0; i < frames; i++) {
+        work();
+        pacer.waitUntil(frame_start + frame_ns);
+        frame_start += frame_ns;
+    }
+    paced_cpu = std::clock() - paced_cpu;
+
+    double busy_deviation = std::sqrt(busy_m2 / (busy_intervals.count() - 1));
+    std::cout << "Busy wait: interval deviation " << busy_deviation / 1000.0 << " us, CPU "
+        << 1000.0 * busy_cpu / CLOCKS_PER_SEC << " ms" << std::endl;
+    std::cout << "Paced wait: interval deviation " << pacer.intervalDeviation() / 1000.0 << " us, CPU "
+        << 1000.0 * paced_cpu / CLOCKS_PER_SEC << " ms" << std::endl;
+    std::cout << "Pacer: " << pacer.summary() << std::endl;
+
+    EXPECT_EQ(pacer.intervals().count(), static_cast<uint64_t>(frames - 1));
+    EXPECT_LT(paced_cpu, busy_cpu);
+}
@@ -1,6 +1,7 @@
 // test_parser.cpp
 
 #include <iostream>
+#include <thread>
 #include <gtest/gtest.h>
 #include "Parser.hpp"
 
@@ -16,4 +17,248 @@ TEST(ParserTest, GeneralTest) {
     EXPECT_EQ(30.0f, upsd);
     EXPECT_EQ(upsd, ups);
     
-}
\ No newline at end of file
+}
+
+TEST(ParserTest, ValueTest) {
+    using namespace seedengine;
+
+    string path = CORE_PATH("data/test_parser.ini");
+    {
+        std::ofstream file(path);
+        file << "; Test configuration" << std::endl;
+        file << "[Test.Section]" << std::endl;
+        file << "  count = -12  # trailing comment" << std::endl;
+        file << "ratio = .5" << std::endl;
+        file << "enabled = TRUE" << std::endl;
+        file << "name = 'semi;colon # kept'" << std::endl;
+        file << "broken = 1.2.3" << std::endl;
+        file << "[ Other ]" << std::endl;
+        file << "count = 7" << std::endl;
+    }
+
+    util::IniParser parser(path);
+    EXPECT_EQ(parser.getInt("Test.Section", "count"), -12);
+    EXPECT_EQ(parser.getFloat("Test.Section", "ratio"), 0.5f);
+    EXPECT_TRUE(parser.getBool("Test.Section", "enabled"));
+    EXPECT_EQ(parser.getString("Test.Section", "name"), "semi;colon # kept");
+    EXPECT_EQ(parser.getInt("Other", "count"), 7);
+    EXPECT_FALSE(parser.has("Test.Section", "broken"));
+
+    // Looking up absent values does not intern their names
+    EXPECT_FALSE(parser.has("Test.Section", "absent_key"));
+    EXPECT_THROW(parser.getInt("Absent.Section", "count"), std::out_of_range);
+    EXPECT_EQ(util::IniParser::lookup("absent_key"), 0u);
+    EXPECT_EQ(util::IniParser::lookup("Absent.Section"), 0u);
+    EXPECT_EQ(util::IniParser::lookup("ratio"), util::IniParser::intern("ratio"));
+    EXPECT_THROW(parser.getFloat("Test.Section", "enabled"), std::out_of_range);
+    EXPECT_EQ(parser.table()->size(), 5u);
+
+    // Typed handles cache their value, integers may be read as floats
+    util::ConfigValue<float> count = parser.value<float>("Other", "count");
+    util::ConfigValue<string> name = parser.value<string>("Test.Section", "name");
+    EXPECT_EQ(count.get(), 7.0f);
+    EXPECT_EQ(static_cast<const string&>(name), "semi;colon # kept");
+    EXPECT_THROW(parser.value<int>("Other", "missing"), std::out_of_range);
+
+    std::remove(path.c_str());
+}
+
+TEST(ParserTest, InternTest) {
+    using namespace seedengine;
+
+    // Names interned on several threads keep one id each while the table grows
+    std::vector<std::thread> threads;
+    std::vector<std::vector<uint32_t>> ids(4);
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t, &ids]() {
+            for (int i = 0; i < 500; i++) {
+                string name = "intern_test_" + std::to_string(i);
+                ids[t].push_back(util::IniParser::intern(name));
+                EXPECT_EQ(util::IniParser::lookup(name), ids[t].back());
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    for (int t = 1; t < 4; t++) EXPECT_EQ(ids[t], ids[0]);
+    EXPECT_EQ(util::IniParser::nameOf(ids[0][42]), "intern_test_42");
+}
+
+TEST(ParserTest, ReloadTest) {
+    using namespace seedengine;
+
+    string path = CORE_PATH("data/test_reload.ini");
+    {
+        std::ofstream file(path);
+        file << "[Engine]" << std::endl << "target_fps = 60.0" << std::endl << "vsync = true" << std::endl;
+    }
+
+    util::IniParser parser(path);
+    util::ConfigValue<float> fps = parser.value<float>("Engine", "target_fps");
+    int fps_changes = 0, vsync_changes = 0;
+    parser.subscribe("Engine", "target_fps", [&fps_changes]() { fps_changes++; });
+    parser.subscribe("Engine", "vsync", [&vsync_changes]() { vsync_changes++; });
+    EXPECT_EQ(parser.dispatchChanges(), 0u);
+    EXPECT_FALSE(parser.reload());
+
+    {
+        std::ofstream file(path);
+        file << "[Engine]" << std::endl << "target_fps = 144.0" << std::endl << "vsync = true" << std::endl;
+    }
+    EXPECT_TRUE(parser.reload());
+    EXPECT_EQ(fps.get(), 144.0f);
+    EXPECT_EQ(parser.dispatchChanges(), 1u);
+    EXPECT_EQ(fps_changes, 1);
+    EXPECT_EQ(vsync_changes, 0);
+
+    // The watcher thread publishes changes in the background
+    parser.watch(5);
+    {
+        std::ofstream file(path);
+        file << "[Engine]" << std::endl << "target_fps = 30.00" << std::endl << "vsync = false" << std::endl;
+    }
+    for (int i = 0; i < 400 && fps.get() != 30.0f; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    parser.unwatch();
+    EXPECT_EQ(fps.get(), 30.0f);
+    EXPECT_EQ(parser.dispatchChanges(), 2u);
+    EXPECT_EQ(vsync_changes, 1);
+    EXPECT_GE(parser.generation(), 3u);
+
+    // Each thread reads its own copy of a handle
+    util::ConfigValue<float> fps_copy = fps;
+    std::thread reader([&fps_copy]() { EXPECT_EQ(fps_copy.get(), 30.0f); });
+    EXPECT_EQ(fps.get(), 30.0f);
+    reader.join();
+
+    // Another file replaces the values of the first
+    string other_path = CORE_PATH("data/test_reopen.ini");
+    {
+        std::ofstream file(other_path);
+        file << "[Engine]" << std::endl << "target_fps = 75.0" << std::endl << "vsync = false" << std::endl;
+    }
+    parser.reopen(other_path);
+    EXPECT_EQ(parser.filepath(), other_path);
+    EXPECT_EQ(fps.get(), 75.0f);
+    EXPECT_EQ(parser.dispatchChanges(), 1u);
+    EXPECT_EQ(vsync_changes, 1);
+    parser.reopen(path);
+    EXPECT_EQ(fps.get(), 30.0f);
+
+    std::remove(other_path.c_str());
+    std::remove(path.c_str());
+}
+
+TEST(ParserTest, ReaderTest) {
+    using namespace seedengine;
+
+    string path = CORE_PATH("data/test_reader.ini");
+    auto write = [&path](int value) {
+        std::ofstream file(path);
+        file << "[Engine]" << std::endl << "max_updates = " << value << std::endl;
+    };
+    write(1);
+    util::IniParser parser(path);
+
+    // A held table outlives the frame boundaries after it is replaced
+    util::IniParser::Reader held = parser.table();
+    write(22);
+    EXPECT_TRUE(parser.reload());
+    for (int i = 0; i < 3; i++) parser.dispatchChanges();
+    int value = 0;
+    EXPECT_TRUE(held->find(util::IniParser::lookup("Engine", "max_updates")) != nullptr);
+    EXPECT_TRUE(parser.find(util::IniParser::lookup("Engine", "max_updates"), value));
+    EXPECT_EQ(value, 22);
+
+    // Reads on other threads are not held up by reloads and never see a freed table
+    std::atomic<bool> done(false);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; t++) {
+        readers.emplace_back([&parser, &done]() {
+            while (!done) {
+                int updates = parser.getInt("Engine", "max_updates");
+                EXPECT_GT(updates, 0);
+            }
+        });
+    }
+    for (int i = 0; i < 200; i++) {
+        write(i % 2 == 0 ? 3 : 44);
+        EXPECT_TRUE(parser.reload());
+        parser.dispatchChanges();
+    }
+    done = true;
+    for (std::thread& reader : readers) reader.join();
+
+    std::remove(path.c_str());
+}
+
+TEST(ParserTest, CompiledTest) {
+    using namespace seedengine;
+
+    string path = CORE_PATH("data/test_compiled.ini");
+    string source_path = CORE_PATH("data/test_compiled_source.ini");
+    {
+        std::ofstream file(path);
+        file << "[Engine]" << std::endl << "target_fps = 10.0" << std::endl;
+    }
+    {
+        std::ofstream file(source_path);
+        file << "[Engine]" << std::endl << "target_fps = 20.0" << std::endl << "max_updates = 4" << std::endl;
+        file << "[Window]" << std::endl << "title = \"Compiled\"" << std::endl << "vsync = true" << std::endl;
+    }
+
+    // Compile a different file over the text file's blob, so reads show where values came from
+    util::IniParser source(source_path);
+    EXPECT_TRUE(source.compile(path + ".bin"));
+
+    util::ConfigBlob blob;
+    ASSERT_TRUE(blob.open(path + ".bin"));
+    EXPECT_EQ(blob.size(), 4u);
+    ASSERT_NE(blob.find("Window", "title"), nullptr);
+    util::ConfigEntry title;
+    blob.read(*blob.find("Window", "title"), title);
+    EXPECT_EQ(title.string_value, "Compiled");
+    EXPECT_EQ(blob.find("Window", "missing"), nullptr);
+    blob.close();
+
+    util::IniParser compiled(path);
+    EXPECT_EQ(compiled.getFloat("Engine", "target_fps"), 20.0f);
+    EXPECT_EQ(compiled.getInt("Engine", "max_updates"), 4);
+    EXPECT_TRUE(compiled.getBool("Window", "vsync"));
+    EXPECT_TRUE(compiled.isCompiled());
+
+    // Text files edited after compilation are preferred
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    {
+        std::ofstream file(path);
+        file << "[Engine]" << std::endl << "target_fps = 30.0" << std::endl;
+    }
+    util::IniParser edited(path);
+    EXPECT_EQ(edited.getFloat("Engine", "target_fps"), 30.0f);
+    EXPECT_FALSE(edited.isCompiled());
+
+    // Corrupt blobs are rejected and the text file is read instead
+    EXPECT_TRUE(source.compile(path + ".bin"));
+    {
+        std::fstream file(path + ".bin", std::ios::in | std::ios::out | std::ios::binary);
+        uint32_t name = 0xFFFFFF;
+        file.seekp(16 + offsetof(util::ConfigBlobEntry, name));
+        file.write(reinterpret_cast<const char*>(&name), sizeof(name));
+    }
+    EXPECT_FALSE(blob.open(path + ".bin"));
+    EXPECT_TRUE(source.compile(path + ".bin"));
+    {
+        std::fstream file(path + ".bin", std::ios::in | std::ios::out | std::ios::binary);
+        uint64_t hash = ~0ull;
+        file.seekp(16 + offsetof(util::ConfigBlobEntry, hash));
+        file.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+    }
+    EXPECT_FALSE(blob.open(path + ".bin"));
+    util::IniParser corrupt(path);
+    EXPECT_EQ(corrupt.getFloat("Engine", "target_fps"), 30.0f);
+    EXPECT_FALSE(corrupt.isCompiled());
+
+    std::remove(path.c_str());
+    std::remove((path + ".bin").c_str());
+    std::remove(source_path.c_str());
+}
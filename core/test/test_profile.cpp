@@ -0,0 +1,95 @@
+// test_profile.cpp
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "Profile.hpp"
+
+TEST(ProfileTest, CaptureTest) {
+    using namespace seedengine;
+
+    // Nothing is kept outside a capture
+    Profiler::stop();
+    Profiler::record("ignored", 0, 10);
+
+    Profiler::start(128);
+    EXPECT_TRUE(Profiler::isCapturing());
+    Profiler::setThreadName("Test \"Main\"");
+    {
+        ProfileScope outer("outer");
+        for (int i = 0; i < 3; i++) ProfileScope inner("inner");
+    }
+
+    // Each thread records into its own buffer, without locking
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; t++) {
+        threads.emplace_back([t]() {
+            Profiler::setThreadName("Test Worker " + std::to_string(t));
+            for (int i = 0; i < 100; i++) ProfileScope scope("work");
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    // A full buffer drops scopes instead of growing
+    for (int i = 0; i < 130; i++) Profiler::record("overflow", 0, 1);
+    Profiler::stop();
+    {
+        ProfileScope late("late");
+    }
+
+    std::vector<ProfileEvent> events = Profiler::events();
+    EXPECT_EQ(events.size(), 428u);
+    EXPECT_EQ(Profiler::recorded(), 428u);
+    EXPECT_EQ(Profiler::dropped(), 6u);
+    size_t outer = 0, inner = 0, work = 0;
+    for (const ProfileEvent& event : events) {
+        EXPECT_LE(event.start_ns, event.end_ns);
+        string name = event.name;
+        if (name == "outer") { outer++; EXPECT_EQ(event.depth, 0u); }
+        if (name == "inner") { inner++; EXPECT_EQ(event.depth, 1u); }
+        if (name == "work") work++;
+        EXPECT_NE(name, "late");
+        EXPECT_NE(name, "ignored");
+    }
+    EXPECT_EQ(outer, 1u);
+    EXPECT_EQ(inner, 3u);
+    EXPECT_EQ(work, 300u);
+
+    // Written as Chrome trace events, with the thread names as metadata
+    std::ostringstream trace;
+    Profiler::writeTrace(trace);
+    string json = trace.str();
+    EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+    EXPECT_NE(json.find("\"name\":\"outer\",\"cat\":\"engine\",\"ph\":\"X\""), string::npos);
+    EXPECT_NE(json.find("\"args\":{\"name\":\"Test \\\"Main\\\"\"}"), string::npos);
+    EXPECT_NE(json.find("Test Worker 2"), string::npos);
+    EXPECT_NE(json.find("\"displayTimeUnit\":\"ms\"}"), string::npos);
+    size_t complete = 0;
+    for (size_t at = json.find("\"ph\":\"X\""); at != string::npos; at = json.find("\"ph\":\"X\"", at + 1)) complete++;
+    EXPECT_EQ(complete, 428u);
+
+    Profiler::report(std::cout);
+
+    // A new capture starts over
+    Profiler::start(128);
+    Profiler::record("again", 0, 1);
+    Profiler::stop();
+    EXPECT_EQ(Profiler::recorded(), 1u);
+    EXPECT_EQ(Profiler::dropped(), 0u);
+}
+
+TEST(ProfileTest, MacroTest) {
+    using namespace seedengine;
+
+    Profiler::start();
+    {
+        ENGINE_PROFILE_SCOPE("macro");
+        ENGINE_PROFILE_FUNCTION();
+    }
+    Profiler::stop();
+#if ENGINE_PROFILE
+    EXPECT_EQ(Profiler::recorded(), 2u);
+#else
+    // Compiled out
+    EXPECT_EQ(Profiler::recorded(), 0u);
+#endif
+}
@@ -1,10 +1,105 @@
 // test_program.cpp
 
 #include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <thread>
 #include <gtest/gtest.h>
 #include "Program.hpp"
 
 TEST(ProgramTest, GeneralTest) {
     using namespace seedengine;
     
-}
\ No newline at end of file
+}
+
+/** Points the defaults at a modified copy of defaults.ini, restoring them when it goes out of scope. */
+class ScopedDefaults final {
+
+public:
+
+    ScopedDefaults(const std::vector<std::pair<std::string, std::string>>& values) {
+        original_ = seedengine::util::DEFAULTS.filepath();
+        path_ = testing::TempDir() + "test_program_defaults.ini";
+
+        // Replace the value of each key, keeping its comment out
+        std::ifstream in(original_);
+        std::ofstream out(path_, std::ios::trunc);
+        std::string line;
+        while (std::getline(in, line)) {
+            for (const std::pair<std::string, std::string>& value : values) {
+                if (line.compare(0, value.first.size() + 3, value.first + " = ") == 0) line = value.first + " = " + value.second;
+            }
+            out << line << '\n';
+        }
+        out.close();
+        seedengine::util::DEFAULTS.reopen(path_);
+    }
+
+    ~ScopedDefaults() {
+        seedengine::util::DEFAULTS.reopen(original_);
+        std::remove(path_.c_str());
+    }
+
+private:
+
+    std::string path_;
+    std::string original_;
+
+};
+
+TEST(ProgramTest, PipelinedTest) {
+    using namespace seedengine;
+
+    ScopedDefaults defaults({
+        { "pipelined", "true" },
+        { "headless", "true" },
+        { "headless_rate", "0.0" },
+        { "headless_frames", "30" },
+        { "watch_interval_ms", "0" }
+    });
+    ASSERT_TRUE(util::DEFAULTS.getBool("Engine", "pipelined"));
+
+    // Subscribe and unsubscribe every tick while the render thread presents the last frame
+    int ticks = 0, snapshots = 0;
+    EventSubscription snapshot_subscription;
+    EventSubscription tick_subscription = EventDispatcher::subscribe(EngineTickEvent::EVENT_ID, [&](Event& e) {
+        ticks++;
+        snapshot_subscription = EventDispatcher::subscribe(EngineSnapshotEvent::EVENT_ID, [&](Event& e) { snapshots++; });
+        EventSubscription extra = EventDispatcher::subscribe(EngineTickEvent::EVENT_ID, [](Event& e) {});
+    });
+
+    // Render events are run on the simulation thread, tagged with the frame they were rendered in
+    int renders = 0;
+    bool render_on_simulation = true;
+    uint64_t last_render_frame = 0;
+    std::thread::id render_event_thread;
+    EventSubscription pre_render_subscription = EventDispatcher::subscribe(EnginePreRenderEvent::EVENT_ID, [&](Event& e) {
+        if (render_event_thread == std::thread::id()) render_event_thread = std::this_thread::get_id();
+    });
+    EventSubscription render_subscription = EventDispatcher::subscribe(EngineRenderEvent::EVENT_ID, [&](Event& e) {
+        EngineRenderEvent& render = static_cast<EngineRenderEvent&>(e);
+        renders++;
+        render_on_simulation = render_on_simulation && EventDispatcher::isDispatchThread() && render.snapshot() == nullptr;
+        EXPECT_GE(render.frame(), last_render_frame);
+        last_render_frame = render.frame();
+    });
+
+    int code = -1;
+    {
+        Program program;
+        program.loadGame();
+        program.run(&code);
+        EXPECT_GT(program.getStats().frames(), 0u);
+    }
+    tick_subscription.reset();
+    snapshot_subscription.reset();
+    pre_render_subscription.reset();
+    render_subscription.reset();
+
+    EXPECT_EQ(code, 0);
+    EXPECT_GT(ticks, 0);
+    EXPECT_GT(snapshots, 0);
+    EXPECT_GT(renders, 0);
+    EXPECT_TRUE(render_on_simulation);
+    EXPECT_NE(render_event_thread, std::this_thread::get_id());
+}
@@ -0,0 +1,94 @@
+// test_record.cpp
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "Record.hpp"
+
+TEST(RecordTest, ReplayTest) {
+    using namespace seedengine;
+
+    string path = CORE_PATH("data/test_record.sevt");
+    EventDispatcher::run(0);
+
+    // Every handled event is logged with the frame it ran in
+    uint64_t frame = 0;
+    std::vector<string> log;
+    EventSubscription keys = EventDispatcher::subscribe(KeyboardEvent::EVENT_ID, [&](Event& e) {
+        KeyboardEvent& key = static_cast<KeyboardEvent&>(e);
+        log.push_back(std::to_string(frame) + " key " + std::to_string(key.keycode()) + " " + std::to_string(key.mods()));
+    });
+    EventSubscription buttons = EventDispatcher::subscribe(MouseButtonEvent::EVENT_ID, [&](Event& e) {
+        MouseButtonEvent& button = static_cast<MouseButtonEvent&>(e);
+        log.push_back(std::to_string(frame) + " button " + std::to_string(button.buttonId()) +
+            (button.state() == input::ButtonState::PRESSED ? " pressed" : " released"));
+    });
+    EventSubscription axes = EventDispatcher::subscribe(ControllerAxisEvent::EVENT_ID, [&](Event& e) {
+        ControllerAxisEvent& axis = static_cast<ControllerAxisEvent&>(e);
+        log.push_back(std::to_string(frame) + " axis " + std::to_string(axis.axisId()) + " " + std::to_string(axis.x()));
+    });
+
+    {
+        EventRecorder recorder;
+        ASSERT_TRUE(recorder.start(path));
+        for (frame = 0; frame < 12; frame++) {
+            if (frame == 1) EventDispatcher::push<KeyboardEvent>(65u, 0u, input::ButtonState::PRESSED, 2u);
+            if (frame == 4) {
+                EventDispatcher::push<MouseButtonEvent>(1u, input::ButtonState::PRESSED, 0u);
+                EventDispatcher::push<ControllerAxisEvent>(0u, 3u, -0.5f, 0.25f);
+                EventDispatcher::push<MouseButtonEvent>(1u, input::ButtonState::RELEASED, 0u);
+            }
+            // Client events have no codec and are skipped
+            if (frame == 6) EventDispatcher::push<ClientEvent>();
+            if (frame == 7) EventDispatcher::push<KeyboardEvent>(300u, 1u, input::ButtonState::RELEASED, 0u);
+            EventDispatcher::run(0);
+            recorder.nextFrame();
+        }
+        EXPECT_EQ(recorder.recorded(), 5u);
+        EXPECT_EQ(recorder.skipped(), 1u);
+    }
+    std::vector<string> recorded = log;
+    log.clear();
+    ASSERT_EQ(recorded.size(), 5u);
+
+    EventReplay replay;
+    ASSERT_TRUE(replay.load(path));
+    EXPECT_EQ(replay.frames(), 12u);
+    EXPECT_EQ(replay.events(), 5u);
+
+    // Replayed events run in the same frames and order as they were recorded
+    ReplayStats stats = replay.run([&](uint64_t f) {
+        frame = f;
+        EventDispatcher::run(0);
+    });
+    EXPECT_EQ(log, recorded);
+    EXPECT_EQ(stats.frames, 12u);
+    EXPECT_EQ(stats.events, 5u);
+    EXPECT_FALSE(replay.beginFrame());
+
+    // A rewound replay runs the same stream again
+    log.clear();
+    replay.rewind();
+    replay.run([&](uint64_t f) {
+        frame = f;
+        EventDispatcher::run(0);
+    });
+    EXPECT_EQ(log, recorded);
+    std::cout << "Replay: " << stats.summary() << std::endl;
+
+    std::remove(path.c_str());
+}
+
+TEST(RecordTest, InvalidLogTest) {
+    using namespace seedengine;
+
+    string path = CORE_PATH("data/test_record_invalid.sevt");
+    {
+        std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        file << "not an event log";
+    }
+    EventReplay replay;
+    EXPECT_FALSE(replay.load(path));
+    EXPECT_FALSE(replay.beginFrame());
+    EXPECT_FALSE(replay.load(CORE_PATH("data/missing.sevt")));
+    std::remove(path.c_str());
+}
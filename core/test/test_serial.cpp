@@ -0,0 +1,262 @@
+// test_serial.cpp
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "Serial.hpp"
+#include "Transform.hpp"
+
+namespace {
+
+    /** A plain particle, serialized with memcpy. */
+    struct Particle {
+        float position[3];
+        float velocity[3];
+        float life;
+        uint32_t flags;
+    };
+
+    /** The first version of a save record. */
+    struct RecordV1 {
+        int32_t health = 0;
+        float speed = 0.0f;
+    };
+
+    /** The second version of a save record, adding a name and a flag. */
+    struct RecordV2 {
+        int32_t health = 0;
+        float speed = 0.0f;
+        string name = "default";
+        bool visible = true;
+    };
+
+}
+
+namespace seedengine {
+
+    template <>
+    struct Serial<RecordV1> {
+        ENGINE_SERIAL_BODY(1)
+        template <class V>
+        static void fields(V& v, RecordV1& r) {
+            v.field(1, r.health);
+            v.field(1, r.speed);
+        }
+    };
+
+    template <>
+    struct Serial<RecordV2> {
+        ENGINE_SERIAL_BODY(2)
+        template <class V>
+        static void fields(V& v, RecordV2& r) {
+            v.field(1, r.health);
+            v.field(1, r.speed);
+            v.field(2, r.name);
+            v.bits(2, r.visible, 1);
+        }
+    };
+
+}
+
+TEST(SerialTest, StreamTest) {
+    using namespace seedengine;
+    using namespace seedengine::util;
+
+    BinaryWriter writer;
+    writer.writeVarint(0);
+    writer.writeVarint(300);
+    writer.writeVarint(0xffffffffffffffffull);
+    writer.writeSignedVarint(-1);
+    writer.writeSignedVarint(-1000000);
+    writer.writeBits(5, 3);
+    writer.writeBits(1, 1);
+    writer.writeBits(0x1ffff, 17);
+    writer.write(string("seed"));
+    EXPECT_EQ(writer.data()[0], 0u);
+    EXPECT_EQ(writer.data()[1], 0xacu);
+
+    BinaryReader reader(writer.data());
+    uint64_t u;
+    int64_t s;
+    uint32_t bits;
+    string text;
+    EXPECT_TRUE(reader.readVarint(u));
+    EXPECT_EQ(u, 0u);
+    EXPECT_TRUE(reader.readVarint(u));
+    EXPECT_EQ(u, 300u);
+    EXPECT_TRUE(reader.readVarint(u));
+    EXPECT_EQ(u, 0xffffffffffffffffull);
+    EXPECT_TRUE(reader.readSignedVarint(s));
+    EXPECT_EQ(s, -1);
+    EXPECT_TRUE(reader.readSignedVarint(s));
+    EXPECT_EQ(s, -1000000);
+    EXPECT_TRUE(reader.readBits(bits, 3));
+    EXPECT_EQ(bits, 5u);
+    EXPECT_TRUE(reader.readBits(bits, 1));
+    EXPECT_EQ(bits, 1u);
+    EXPECT_TRUE(reader.readBits(bits, 17));
+    EXPECT_EQ(bits, 0x1ffffu);
+    EXPECT_TRUE(reader.read(text));
+    EXPECT_EQ(text, "seed");
+    EXPECT_EQ(reader.position(), writer.size());
+
+    // Reading past the end fails
+    EXPECT_FALSE(reader.readVarint(u));
+    EXPECT_FALSE(reader.good());
+
+    // Counts that could not fit in the stream fail without allocating, even if count * size overflows
+    BinaryWriter lists;
+    lists.writeVarint((1ull << 62) + 1);
+    lists.writeVarint(1000000000);
+    lists.write(string("seed"));
+    BinaryReader list_reader(lists.data());
+    std::vector<uint64_t> values;
+    EXPECT_FALSE(list_reader.read(values));
+    EXPECT_TRUE(values.empty());
+    BinaryReader string_reader(lists.data());
+    string_reader.readVarint(u);
+    std::vector<string> strings;
+    EXPECT_FALSE(string_reader.read(strings));
+    EXPECT_TRUE(strings.empty());
+}
+
+TEST(SerialTest, VersionTest) {
+    using namespace seedengine;
+    using namespace seedengine::util;
+
+    std::vector<RecordV2> records(3);
+    records[1].health = -7;
+    records[1].name = "second";
+    records[1].visible = false;
+
+    BinaryWriter writer;
+    writer.write(records);
+    writer.write(Transform(glm::vec3(1.0f, 2.0f, 3.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(2.0f, 2.0f, 2.0f)));
+
+    // A newer reader gets every field back
+    {
+        BinaryReader reader(writer.data());
+        std::vector<RecordV2> read;
+        Transform transform;
+        EXPECT_TRUE(reader.read(read));
+        EXPECT_TRUE(reader.read(transform));
+        ASSERT_EQ(read.size(), 3u);
+        EXPECT_EQ(read[1].health, -7);
+        EXPECT_EQ(read[1].name, "second");
+        EXPECT_FALSE(read[1].visible);
+        EXPECT_TRUE(read[2].visible);
+        EXPECT_FLOAT_EQ(transform.getPosition().y, 2.0f);
+        EXPECT_FLOAT_EQ(transform.getScale().z, 2.0f);
+    }
+
+    // An older reader skips the fields it does not know
+    {
+        BinaryReader reader(writer.data());
+        std::vector<RecordV1> read;
+        Transform transform;
+        EXPECT_TRUE(reader.read(read));
+        EXPECT_TRUE(reader.read(transform));
+        ASSERT_EQ(read.size(), 3u);
+        EXPECT_EQ(read[1].health, -7);
+        EXPECT_FLOAT_EQ(transform.getPosition().z, 3.0f);
+    }
+
+    // A newer reader leaves fields missing from older streams at their defaults
+    {
+        BinaryWriter old_writer;
+        RecordV1 old;
+        old.health = 42;
+        old_writer.write(old);
+        BinaryReader reader(old_writer.data());
+        RecordV2 read;
+        EXPECT_TRUE(reader.read(read));
+        EXPECT_EQ(read.health, 42);
+        EXPECT_EQ(read.name, "default");
+        EXPECT_TRUE(read.visible);
+    }
+}
+
+TEST(SerialTest, ThroughputBenchmark) {
+    using namespace seedengine;
+    using namespace seedengine::util;
+
+    const size_t count = 100000;
+    std::vector<Particle> particles(count);
+    for (size_t i = 0; i < count; i++) {
+        for (int j = 0; j < 3; j++) {
+            particles[i].position[j] = static_cast<float>(i + j);
+            particles[i].velocity[j] = static_cast<float>(j) * 0.5f;
+        }
+        particles[i].life = 1.0f;
+        particles[i].flags = static_cast<uint32_t>(i);
+    }
+    const double megabytes = static_cast<double>(count * sizeof(Particle)) / (1024.0 * 1024.0);
+
+    auto time = [](const std::function<void()>& f) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 10; i++) f();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double>(end - start).count() / 10.0;
+    };
+
+    // Naive path: every field byte swapped and appended on its own
+    std::vector<uint8_t> naive;
+    double naive_s = time([&]() {
+        naive.clear();
+        for (const Particle& p : particles) {
+            const float* floats = p.position;
+            for (int j = 0; j < 7; j++) {
+                uint32_t f = htonf(j < 3 ? floats[j] : (j < 6 ? p.velocity[j - 3] : p.life));
+                const uint8_t* b = reinterpret_cast<const uint8_t*>(&f);
+                for (size_t k = 0; k < sizeof(f); k++) naive.push_back(b[k]);
+            }
+            uint32_t flags = htonl(p.flags);
+            const uint8_t* b = reinterpret_cast<const uint8_t*>(&flags);
+            for (size_t k = 0; k < sizeof(flags); k++) naive.push_back(b[k]);
+        }
+    });
+
+    BinaryWriter writer;
+    double write_s = time([&]() {
+        writer.clear();
+        writer.write(particles);
+    });
+
+    // Naive path: every field read and byte swapped on its own
+    std::vector<Particle> naive_read;
+    double naive_read_s = time([&]() {
+        naive_read.clear();
+        for (size_t offset = 0; offset + 8 * sizeof(uint32_t) <= naive.size();) {
+            Particle p;
+            uint32_t fields[8];
+            for (int j = 0; j < 8; j++) {
+                uint8_t* b = reinterpret_cast<uint8_t*>(&fields[j]);
+                for (size_t k = 0; k < sizeof(uint32_t); k++) b[k] = naive[offset++];
+            }
+            for (int j = 0; j < 3; j++) {
+                p.position[j] = ntohf(fields[j]);
+                p.velocity[j] = ntohf(fields[j + 3]);
+            }
+            p.life = ntohf(fields[6]);
+            p.flags = ntohl(fields[7]);
+            naive_read.push_back(p);
+        }
+    });
+
+    std::vector<Particle> read;
+    double read_s = time([&]() {
+        BinaryReader reader(writer.data());
+        reader.read(read);
+    });
+
+    ASSERT_EQ(naive_read.size(), count);
+    EXPECT_EQ(naive_read[count - 1].flags, particles[count - 1].flags);
+    EXPECT_EQ(naive_read[count - 1].velocity[2], particles[count - 1].velocity[2]);
+    ASSERT_EQ(read.size(), count);
+    EXPECT_EQ(read[count - 1].flags, particles[count - 1].flags);
+    EXPECT_EQ(naive.size(), writer.size() - 3);
+
+    std::cout << "Naive field writes: " << megabytes / naive_s << " MB/s" << std::endl;
+    std::cout << "Bulk writes: " << megabytes / write_s << " MB/s" << std::endl;
+    std::cout << "Naive field reads: " << megabytes / naive_read_s << " MB/s" << std::endl;
+    std::cout << "Bulk reads: " << megabytes / read_s << " MB/s" << std::endl;
+}
@@ -0,0 +1,127 @@
+// test_snapshot.cpp
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "Snapshot.hpp"
+
+TEST(SnapshotTest, ExchangeTest) {
+    using namespace seedengine;
+
+    FrameExchange exchange;
+
+    // Run serially, one frame at a time
+    for (uint64_t i = 0; i < 3; i++) {
+        RenderSnapshot& snapshot = exchange.begin();
+        EXPECT_EQ(snapshot.frame(), i);
+        EXPECT_EQ(snapshot.drawCount(), 0u);
+        EXPECT_FALSE(snapshot.hasCamera());
+        snapshot.setCamera(glm::mat4(2.0f), glm::mat4(3.0f), glm::vec3(1.0f, 2.0f, 3.0f));
+        snapshot.submit(nullptr, glm::mat4(static_cast<float>(i)));
+        EXPECT_TRUE(exchange.publish());
+
+        const RenderSnapshot* front = exchange.acquire();
+        ASSERT_NE(front, nullptr);
+        EXPECT_EQ(front, &snapshot);
+        EXPECT_EQ(front->frame(), i);
+        ASSERT_EQ(front->drawCount(), 1u);
+        EXPECT_EQ(front->draws()[0].model[0][0], static_cast<float>(i));
+        EXPECT_TRUE(front->hasCamera());
+        EXPECT_EQ(front->cameraPosition().z, 3.0f);
+        exchange.release();
+    }
+    EXPECT_EQ(exchange.rendered(), 3u);
+    EXPECT_EQ(exchange.intervals().count(), 2u);
+    EXPECT_EQ(exchange.simulationTimes().count(), 3u);
+
+    // Closing wakes both sides
+    exchange.close();
+    EXPECT_TRUE(exchange.isClosed());
+    EXPECT_EQ(exchange.acquire(), nullptr);
+    exchange.begin();
+    EXPECT_FALSE(exchange.publish());
+
+    exchange.reset();
+    EXPECT_FALSE(exchange.isClosed());
+    EXPECT_EQ(exchange.rendered(), 0u);
+    EXPECT_EQ(exchange.begin().frame(), 0u);
+}
+
+TEST(SnapshotTest, PipelineTest) {
+    using namespace seedengine;
+
+    const uint64_t frames = 200;
+    const size_t draws = 64;
+    FrameExchange exchange;
+
+    // Every draw of a frame is stamped with its frame, so a snapshot changed while it is
+    // being rendered shows up as a mixed draw list
+    std::thread simulation([&]() {
+        for (uint64_t i = 0; i < frames; i++) {
+            RenderSnapshot& snapshot = exchange.begin();
+            for (size_t d = 0; d < draws; d++) snapshot.submit(nullptr, glm::mat4(static_cast<float>(snapshot.frame())));
+            if (!exchange.publish()) break;
+        }
+        exchange.close();
+    });
+
+    uint64_t expected = 0;
+    bool consistent = true;
+    while (const RenderSnapshot* snapshot = exchange.acquire()) {
+        EXPECT_EQ(snapshot->frame(), expected++);
+        if (snapshot->drawCount() != draws) consistent = false;
+        for (int pass = 0; pass < 4; pass++) {
+            for (const DrawItem& item : snapshot->draws()) {
+                if (item.model[0][0] != static_cast<float>(snapshot->frame())) consistent = false;
+            }
+            std::this_thread::yield();
+        }
+        exchange.release();
+    }
+    simulation.join();
+
+    EXPECT_TRUE(consistent);
+    EXPECT_EQ(expected, frames);
+    EXPECT_EQ(exchange.rendered(), frames);
+}
+
+TEST(SnapshotTest, PipelineBenchmark) {
+    using namespace seedengine;
+
+    // Sleeps stand in for the work of each side, so the overlap shows even on one core
+    const int frames = 60;
+    const std::chrono::microseconds simulate_time(2000);
+    const std::chrono::microseconds render_time(2000);
+
+    FrameExchange serial;
+    for (int i = 0; i < frames; i++) {
+        serial.begin();
+        std::this_thread::sleep_for(simulate_time);
+        serial.publish();
+        serial.acquire();
+        std::this_thread::sleep_for(render_time);
+        serial.release();
+    }
+
+    FrameExchange pipelined;
+    std::thread simulation([&]() {
+        for (int i = 0; i < frames; i++) {
+            pipelined.begin();
+            std::this_thread::sleep_for(simulate_time);
+            if (!pipelined.publish()) break;
+        }
+        pipelined.close();
+    });
+    while (pipelined.acquire() != nullptr) {
+        std::this_thread::sleep_for(render_time);
+        pipelined.release();
+    }
+    simulation.join();
+
+    std::cout << "Serial:    " << serial.summary() << std::endl;
+    std::cout << "Pipelined: " << pipelined.summary() << std::endl;
+
+    EXPECT_EQ(serial.rendered(), static_cast<uint64_t>(frames));
+    EXPECT_EQ(pipelined.rendered(), static_cast<uint64_t>(frames));
+    // Overlapping the two sides renders more frames per second
+    EXPECT_GT(pipelined.throughput(), serial.throughput() * 1.2);
+}
@@ -0,0 +1,135 @@
+// test_stats.cpp
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "Stats.hpp"
+
+TEST(StatsTest, HistogramTest) {
+    using namespace seedengine;
+    using namespace seedengine::util;
+
+    Histogram histogram;
+    EXPECT_EQ(histogram.percentile(0.5), 0u);
+
+    // Small values are counted exactly
+    for (uint64_t i = 1; i <= 10; i++) histogram.record(i);
+    EXPECT_EQ(histogram.count(), 10u);
+    EXPECT_EQ(histogram.percentile(0.5), 5u);
+    EXPECT_EQ(histogram.percentile(1.0), 10u);
+    EXPECT_EQ(histogram.min(), 1u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 5.5);
+
+    // Large values are within the bucket resolution
+    histogram.clear();
+    for (uint64_t i = 1; i <= 1000; i++) histogram.record(i * 1000);
+    uint64_t p50 = histogram.percentile(0.5);
+    uint64_t p99 = histogram.percentile(0.99);
+    EXPECT_GE(p50, 500000u);
+    EXPECT_LE(p50, 500000u * 103 / 100);
+    EXPECT_GE(p99, 990000u);
+    EXPECT_LE(p99, 990000u * 103 / 100);
+    EXPECT_EQ(histogram.percentile(1.0), 1000000u);
+    EXPECT_EQ(histogram.max(), 1000000u);
+
+    const unsigned int buckets = Histogram::BUCKETS;
+    // Every value lands in a bucket whose upper bound covers it
+    for (uint64_t value : {0ull, 31ull, 32ull, 63ull, 64ull, 1000ull, 123456789ull, ~0ull}) {
+        unsigned int bucket = Histogram::bucketOf(value);
+        EXPECT_LT(bucket, buckets);
+        EXPECT_GE(Histogram::upperBound(bucket), value);
+        if (bucket > 0) {
+            EXPECT_LT(Histogram::upperBound(bucket - 1), value);
+        }
+    }
+
+    Histogram other;
+    other.record(5000000);
+    histogram.merge(other);
+    EXPECT_EQ(histogram.count(), 1001u);
+    EXPECT_EQ(histogram.max(), 5000000u);
+}
+
+TEST(StatsTest, RollingWindowTest) {
+    using namespace seedengine;
+    using namespace seedengine::util;
+
+    RollingWindow window(4);
+    EXPECT_EQ(window.percentile(0.5), 0u);
+    EXPECT_EQ(window.latest(), 0u);
+
+    for (uint64_t i = 1; i <= 3; i++) window.record(i * 10);
+    EXPECT_EQ(window.size(), 3u);
+    EXPECT_EQ(window.at(0), 10u);
+    EXPECT_DOUBLE_EQ(window.mean(), 20.0);
+
+    // Once full, the oldest values are replaced
+    for (uint64_t i = 4; i <= 6; i++) window.record(i * 10);
+    EXPECT_EQ(window.size(), 4u);
+    EXPECT_EQ(window.at(0), 30u);
+    EXPECT_EQ(window.latest(), 60u);
+    EXPECT_DOUBLE_EQ(window.mean(), 45.0);
+    EXPECT_EQ(window.max(), 60u);
+    EXPECT_EQ(window.percentile(0.5), 40u);
+    EXPECT_EQ(window.percentile(1.0), 60u);
+    EXPECT_EQ(window.countAbove(40), 2u);
+    EXPECT_THROW(window.at(4), std::out_of_range);
+
+    // Percentiles leave the order of the values alone
+    EXPECT_EQ(window.at(3), 60u);
+
+    window.clear();
+    EXPECT_EQ(window.size(), 0u);
+    EXPECT_EQ(window.max(), 0u);
+}
+
+TEST(StatsTest, FrameStatsTest) {
+    using namespace seedengine;
+
+    FrameStats stats(100);
+    string path = CORE_PATH("data/test_frame_stats.csv");
+    EXPECT_TRUE(stats.startCsv(path));
+
+    // Steady 10 ms frames with one 50 ms hitch
+    for (int i = 0; i < 50; i++) {
+        stats.record(FrameStage::TICK, 2000000);
+        stats.record(FrameStage::TICK, 1000000);
+        stats.record(FrameStage::RENDER, 4000000);
+        stats.endFrame(i == 40 ? 50000000 : 10000000);
+    }
+    stats.stopCsv();
+
+    EXPECT_EQ(stats.frames(), 50u);
+    EXPECT_EQ(stats.hitches(), 1u);
+    EXPECT_EQ(stats.recentHitches(), 1u);
+    EXPECT_EQ(stats.percentile(FrameStage::FRAME, 0.5), 10000000u);
+    EXPECT_EQ(stats.percentile(FrameStage::FRAME, 0.99), 50000000u);
+    EXPECT_EQ(stats.max(FrameStage::FRAME), 50000000u);
+    EXPECT_DOUBLE_EQ(stats.mean(FrameStage::TICK), 3000000.0);
+    EXPECT_EQ(stats.percentile(FrameStage::SWAP, 0.5), 0u);
+    EXPECT_EQ(stats.histogram(FrameStage::RENDER).count(), 50u);
+    EXPECT_NEAR(stats.fps(), 1000000000.0 / 10800000.0, 1e-6);
+
+    // A header and a line for each frame
+    std::ifstream file(path);
+    string line;
+    std::vector<string> lines;
+    while (std::getline(file, line)) lines.push_back(line);
+    file.close();
+    std::remove(path.c_str());
+    ASSERT_EQ(lines.size(), 51u);
+    EXPECT_EQ(lines[0], "frame,frame_ms,tick_ms,pre_render_ms,render_ms,swap_ms,hitch");
+    EXPECT_EQ(lines[1], "0,10,3,0,4,0,0");
+    EXPECT_EQ(lines[41], "40,50,3,0,4,0,1");
+
+    // A set threshold replaces the rolling median
+    stats.setHitchThreshold(5000000);
+    stats.endFrame(6000000);
+    EXPECT_EQ(stats.hitches(), 2u);
+
+    stats.report(std::cout);
+    std::cout << stats.summary() << std::endl;
+
+    stats.reset(10);
+    EXPECT_EQ(stats.frames(), 0u);
+    EXPECT_EQ(stats.fps(), 0.0);
+}
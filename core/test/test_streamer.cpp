@@ -0,0 +1,240 @@
+// test_streamer.cpp
+
+#include <iostream>
+#include <thread>
+#include <gtest/gtest.h>
+#include "Streamer.hpp"
+#include "Mesh.hpp"
+
+namespace {
+
+    using namespace seedengine;
+
+    /** A simulated disk with fixed latency and bandwidth, driven by a virtual clock. */
+    class SlowDiskSource : public StreamSource {
+
+    public:
+
+        SlowDiskSource(double latency_ms, double bytes_per_ms)
+            : latency_ms_(latency_ms), bytes_per_ms_(bytes_per_ms) {}
+
+        void begin(unsigned int id, const string& path, uint64_t bytes) override {
+            // Reads are serviced one after another
+            double start = std::max(now_, disk_free_);
+            disk_free_ = start + latency_ms_ + bytes / bytes_per_ms_;
+            reads_.push_back(std::make_pair(id, disk_free_));
+            started_.push_back(id);
+        }
+
+        void collect(std::vector<unsigned int>& completed) override {
+            for (auto it = reads_.begin(); it != reads_.end();) {
+                if (it->second <= now_) {
+                    completed.push_back(it->first);
+                    it = reads_.erase(it);
+                }
+                else ++it;
+            }
+        }
+
+        void advance(double ms) { now_ += ms; }
+
+        std::vector<unsigned int> started_;
+
+    private:
+
+        double latency_ms_;
+        double bytes_per_ms_;
+        double now_ = 0.0;
+        double disk_free_ = 0.0;
+        std::vector<std::pair<unsigned int, double>> reads_;
+
+    };
+
+}
+
+TEST(StreamerTest, BudgetTest) {
+    using namespace seedengine;
+
+    SlowDiskSource disk(5.0, 1024.0);
+    AssetStreamer streamer(&disk, 64 * 1024, 32 * 1024);
+
+    std::vector<string> uploaded;
+    auto upload = [&uploaded](const string& path, const std::vector<char>& data) { uploaded.push_back(path); };
+    for (int i = 0; i < 32; i++) {
+        streamer.request("asset_" + std::to_string(i), StreamPriority::PREFETCH,
+            glm::vec3(0.0f, 0.0f, 0.0f), upload, 16 * 1024);
+    }
+
+    int frames = 0;
+    while (streamer.activeRequests() > 0 && frames < 1000) {
+        streamer.update();
+        EXPECT_LE(streamer.outstandingBytes(), 64u * 1024u);
+        EXPECT_LE(streamer.uploadedBytes(), 32u * 1024u);
+        disk.advance(16.0);
+        frames++;
+    }
+
+    EXPECT_EQ(uploaded.size(), 32u);
+    EXPECT_EQ(streamer.outstandingBytes(), 0u);
+    std::cout << "Streamed 512 KB over a 1 MB/s simulated disk in " << frames << " frames." << std::endl;
+}
+
+TEST(StreamerTest, HandOffTest) {
+    using namespace seedengine;
+
+    SlowDiskSource disk(1.0, 1024.0);
+    AssetStreamer streamer(&disk, 64 * 1024, 64 * 1024);
+
+    std::vector<string> uploaded;
+    std::thread::id upload_thread;
+    auto upload = [&](const string& path, const std::vector<char>& data) {
+        uploaded.push_back(path);
+        upload_thread = std::this_thread::get_id();
+    };
+    unsigned int id = streamer.request("asset", StreamPriority::GAMEPLAY, glm::vec3(0.0f, 0.0f, 0.0f), upload, 1024);
+
+    // Scheduling hands the finished read over without uploading it
+    streamer.schedule();
+    disk.advance(16.0);
+    streamer.schedule();
+    EXPECT_EQ(streamer.state(id), StreamState::UPLOADING);
+    EXPECT_FALSE(streamer.cancel(id));
+    EXPECT_TRUE(uploaded.empty());
+
+    // The render thread uploads it between its frames, and the next schedule completes it
+    std::thread renderer([&streamer]() { EXPECT_EQ(streamer.upload(), 1u); });
+    std::thread::id render_thread = renderer.get_id();
+    renderer.join();
+    ASSERT_EQ(uploaded.size(), 1u);
+    EXPECT_EQ(upload_thread, render_thread);
+    EXPECT_EQ(streamer.state(id), StreamState::UPLOADING);
+    streamer.schedule();
+    EXPECT_EQ(streamer.state(id), StreamState::COMPLETE);
+    EXPECT_EQ(streamer.activeRequests(), 0u);
+    EXPECT_EQ(streamer.upload(), 0u);
+
+    // Uploads beyond the frame budget stay queued for the next frame
+    unsigned int first = streamer.request("first", StreamPriority::GAMEPLAY, glm::vec3(0.0f, 0.0f, 0.0f), upload, 16 * 1024);
+    unsigned int second = streamer.request("second", StreamPriority::GAMEPLAY, glm::vec3(0.0f, 0.0f, 0.0f), upload, 16 * 1024);
+    streamer.schedule();
+    disk.advance(64.0);
+    streamer.schedule();
+    EXPECT_EQ(streamer.state(second), StreamState::UPLOADING);
+    streamer.setUploadBudget(16 * 1024);
+    EXPECT_EQ(streamer.upload(), 1u);
+    EXPECT_EQ(streamer.uploadedBytes(), 16u * 1024u);
+    streamer.schedule();
+    EXPECT_EQ(streamer.state(first), StreamState::COMPLETE);
+    EXPECT_EQ(streamer.state(second), StreamState::UPLOADING);
+    EXPECT_EQ(streamer.upload(), 1u);
+    EXPECT_EQ(uploaded.back(), "second");
+}
+
+TEST(StreamerTest, PriorityTest) {
+    using namespace seedengine;
+
+    SlowDiskSource disk(10.0, 1024.0);
+    AssetStreamer streamer(&disk, 16 * 1024, 16 * 1024);
+
+    std::vector<string> uploaded;
+    auto upload = [&uploaded](const string& path, const std::vector<char>& data) { uploaded.push_back(path); };
+    for (int i = 0; i < 8; i++) {
+        streamer.request("prefetch", StreamPriority::PREFETCH, glm::vec3(0.0f, 0.0f, 0.0f), upload, 16 * 1024);
+    }
+    streamer.update();
+
+    // A critical request made after the prefetch backlog is read next
+    unsigned int critical = streamer.request("critical", StreamPriority::CRITICAL,
+        glm::vec3(0.0f, 0.0f, 0.0f), upload, 16 * 1024);
+
+    // Closer assets are read before distant ones of the same class
+    unsigned int far = streamer.request("far", StreamPriority::NEARBY, glm::vec3(100.0f, 0.0f, 0.0f), upload, 1024);
+    unsigned int near = streamer.request("near", StreamPriority::NEARBY, glm::vec3(10.0f, 0.0f, 0.0f), upload, 1024);
+
+    // Moving the viewer reprioritizes the waiting requests
+    streamer.setViewerPosition(glm::vec3(100.0f, 0.0f, 0.0f));
+
+    while (streamer.state(critical) != StreamState::COMPLETE) {
+        disk.advance(16.0);
+        streamer.update();
+    }
+    ASSERT_GE(uploaded.size(), 2u);
+    EXPECT_EQ(uploaded[0], "prefetch");
+    EXPECT_EQ(uploaded[1], "critical");
+
+    while (streamer.state(near) != StreamState::COMPLETE) {
+        disk.advance(16.0);
+        streamer.update();
+    }
+    EXPECT_EQ(streamer.state(far), StreamState::COMPLETE);
+    ASSERT_GE(uploaded.size(), 4u);
+    EXPECT_EQ(uploaded[2], "far");
+    EXPECT_EQ(uploaded[3], "near");
+}
+
+TEST(StreamerTest, CancelTest) {
+    using namespace seedengine;
+
+    SlowDiskSource disk(10.0, 1024.0);
+    AssetStreamer streamer(&disk, 4 * 1024, 4 * 1024);
+
+    int uploads = 0;
+    auto upload = [&uploads](const string& path, const std::vector<char>& data) { uploads++; };
+    unsigned int in_flight = streamer.request("a", StreamPriority::GAMEPLAY, glm::vec3(0.0f, 0.0f, 0.0f), upload, 4096);
+    unsigned int pending = streamer.request("b", StreamPriority::GAMEPLAY, glm::vec3(0.0f, 0.0f, 0.0f), upload, 4096);
+    streamer.update();
+    EXPECT_EQ(streamer.state(in_flight), StreamState::READING);
+    EXPECT_EQ(streamer.state(pending), StreamState::PENDING);
+
+    EXPECT_TRUE(streamer.cancel(pending));
+    EXPECT_TRUE(streamer.cancel(in_flight));
+    EXPECT_FALSE(streamer.cancel(in_flight));
+    EXPECT_EQ(streamer.state(in_flight), StreamState::CANCELLED);
+    EXPECT_EQ(streamer.state(in_flight), StreamState::CANCELLED);
+    EXPECT_EQ(streamer.state(pending), StreamState::CANCELLED);
+    EXPECT_EQ(streamer.activeRequests(), 0u);
+
+    // The abandoned read holds its I/O budget until the disk finishes it
+    EXPECT_EQ(streamer.outstandingBytes(), 4096u);
+    for (int i = 0; i < 4; i++) {
+        disk.advance(16.0);
+        streamer.update();
+    }
+    EXPECT_EQ(streamer.outstandingBytes(), 0u);
+    EXPECT_EQ(uploads, 0);
+    EXPECT_EQ(disk.started_.size(), 1u);
+    EXPECT_EQ(streamer.state(pending), StreamState::CANCELLED);
+
+    // Cancellations are forgotten after a while, and never read as completed
+    for (unsigned int i = 0; i < AssetStreamer::FINISHED_UPDATES; i++) streamer.update();
+    EXPECT_EQ(streamer.state(pending), StreamState::UNKNOWN);
+    EXPECT_EQ(streamer.state(pending + 1), StreamState::UNKNOWN);
+}
+
+TEST(StreamerTest, FileTest) {
+    using namespace seedengine;
+
+    FileStreamSource source;
+    AssetStreamer streamer(&source, 1024 * 1024, 1024 * 1024);
+
+    // The bytes read by the source are handed to the upload step
+    string path = CORE_PATH("data/assets/models/primatives/cube.mesh");
+    std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+    ASSERT_TRUE(file.good());
+    size_t size = static_cast<size_t>(file.tellg());
+    size_t uploaded = 0;
+    streamer.request(path, StreamPriority::GAMEPLAY, glm::vec3(0.0f, 0.0f, 0.0f),
+        [&uploaded](const string& p, const std::vector<char>& data) { uploaded = data.size(); }, size);
+
+    // Meshes are parsed from those bytes
+    unsigned int id = streamer.request<Mesh>(path, StreamPriority::GAMEPLAY);
+    for (int frames = 0; streamer.activeRequests() > 0 && frames < 1000; frames++) {
+        streamer.update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(streamer.state(id), StreamState::COMPLETE);
+    EXPECT_EQ(uploaded, size);
+    auto mesh = AssetLibrary<Mesh>::request(path);
+    ASSERT_NE(mesh, nullptr);
+    EXPECT_GT(mesh->indexCount(), 0u);
+}
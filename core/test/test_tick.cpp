@@ -0,0 +1,221 @@
+// test_tick.cpp
+
+#include <iostream>
+#include <gtest/gtest.h>
+#include "Tick.hpp"
+#include "Snapshot.hpp"
+
+namespace {
+
+    /** Counts updates across every test component, so updates can be ordered. */
+    std::atomic<int> clock_(0);
+
+    class WriterComponent : public seedengine::Component {
+    public:
+        WriterComponent(seedengine::Actor& actor) : Component(actor) {}
+        void update() override {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            stamp = ++clock_;
+        }
+        void declareAccess(seedengine::TickAccess& access) const override {
+            access.setName("Writer").writes("Transform").perActor();
+        }
+        int stamp = 0;
+    };
+
+    class ReaderComponent : public seedengine::Component {
+    public:
+        ReaderComponent(seedengine::Actor& actor) : Component(actor) {}
+        void update() override { stamp = ++clock_; }
+        void declareAccess(seedengine::TickAccess& access) const override {
+            access.setName("Reader").reads("Transform");
+        }
+        int stamp = 0;
+    };
+
+    class MoverComponent : public seedengine::Component {
+    public:
+        MoverComponent(seedengine::Actor& actor) : Component(actor) {}
+        void update() override {
+            seedengine::Transform& transform = actor_.transform();
+            transform.setPosition(transform.getPosition() + glm::vec3(1.0f, 0.0f, 0.0f));
+        }
+        void declareAccess(seedengine::TickAccess& access) const override {
+            access.setName("Mover").writes("Transform").perActor();
+        }
+    };
+
+    class AudioComponent : public seedengine::Component {
+    public:
+        AudioComponent(seedengine::Actor& actor) : Component(actor) {}
+        void update() override { stamp = ++clock_; }
+        void declareAccess(seedengine::TickAccess& access) const override {
+            access.setName("Audio").writes("Audio");
+        }
+        int stamp = 0;
+    };
+
+    class LegacyComponent : public seedengine::Component {
+    public:
+        LegacyComponent(seedengine::Actor& actor) : Component(actor) {}
+        void update() override { stamp = ++clock_; }
+        int stamp = 0;
+    };
+
+}
+
+TEST(TickTest, AccessTest) {
+    using namespace seedengine;
+
+    TickAccess writer, reader, other, undeclared;
+    writer.writes("Transform");
+    reader.reads("Transform").reads("Input");
+    other.reads("Input").writes("Audio");
+
+    EXPECT_TRUE(writer.conflictsWith(reader));
+    EXPECT_TRUE(reader.conflictsWith(writer));
+    EXPECT_TRUE(writer.conflictsWith(writer));
+    EXPECT_FALSE(reader.conflictsWith(other));
+    EXPECT_FALSE(reader.conflictsWith(reader));
+    EXPECT_FALSE(writer.conflictsWith(other));
+    EXPECT_TRUE(undeclared.conflictsWith(other));
+    EXPECT_FALSE(undeclared.isDeclared());
+}
+
+TEST(TickTest, ScheduleTest) {
+    using namespace seedengine;
+
+    jobs::start(2);
+
+    std::vector<std::unique_ptr<Actor>> actors;
+    std::vector<WriterComponent*> writers;
+    std::vector<ReaderComponent*> readers;
+    TickScheduler scheduler;
+    for (int i = 0; i < 3; i++) {
+        actors.emplace_back(new Actor());
+        writers.push_back(&actors.back()->addComponent<WriterComponent>());
+        readers.push_back(&actors.back()->addComponent<ReaderComponent>());
+        actors.back()->addComponent<AudioComponent>();
+        scheduler.add(*actors.back());
+    }
+    LegacyComponent& legacy = actors.back()->addComponent<LegacyComponent>();
+    scheduler.add(*actors.back());
+    EXPECT_EQ(scheduler.actorCount(), 3u);
+
+    for (int frame = 0; frame < 5; frame++) {
+        EXPECT_EQ(scheduler.tick(), 10u);
+
+        // Readers run after every writer, and the undeclared type after everything
+        int last_writer = 0, first_reader = 1 << 30;
+        for (WriterComponent* writer : writers) last_writer = std::max(last_writer, writer->stamp);
+        for (ReaderComponent* reader : readers) first_reader = std::min(first_reader, reader->stamp);
+        EXPECT_LT(last_writer, first_reader);
+        EXPECT_EQ(legacy.stamp, clock_.load());
+    }
+
+    // Groups are numbered in the order their type was seen
+    ASSERT_EQ(scheduler.groupCount(), 4u);
+    EXPECT_EQ(scheduler.groupName(0), "Writer");
+    EXPECT_EQ(scheduler.groupName(3), typeid(LegacyComponent).name());
+    EXPECT_TRUE(scheduler.dependenciesOf(0).empty());
+    EXPECT_EQ(scheduler.dependenciesOf(1), std::vector<size_t>({ 0 }));
+    EXPECT_TRUE(scheduler.dependenciesOf(2).empty());
+    EXPECT_EQ(scheduler.dependenciesOf(3), std::vector<size_t>({ 0, 1, 2 }));
+    EXPECT_EQ(scheduler.timesOf(0).count(), 5u);
+    EXPECT_EQ(scheduler.tickTimes().count(), 5u);
+
+    // The slow writers set the length of the tick
+    double length = 0.0;
+    EXPECT_EQ(scheduler.criticalPath(&length), std::vector<size_t>({ 0, 1, 3 }));
+    EXPECT_GT(length, 0.0);
+
+    std::ostringstream report;
+    scheduler.report(report);
+    EXPECT_NE(report.str().find("Critical path"), string::npos);
+    std::cout << report.str();
+
+    // Inactive actors and actors that pause with the game are skipped
+    actors[0]->active = false;
+    EXPECT_EQ(scheduler.tick(), 7u);
+    EXPECT_EQ(scheduler.tick(true), 0u);
+    scheduler.remove(*actors[1]);
+    EXPECT_EQ(scheduler.tick(), 4u);
+
+    jobs::stop();
+}
+
+TEST(TickTest, TimestepTest) {
+    using namespace seedengine;
+
+    FixedTimestep timestep;
+    timestep.setInterval(10.0);
+    timestep.setMaxSteps(5);
+
+    // Whole intervals are stepped, the rest sets the alpha
+    int steps = 0;
+    timestep.advance(25.0);
+    while (timestep.step()) steps++;
+    timestep.endFrame();
+    EXPECT_EQ(steps, 2);
+    EXPECT_NEAR(timestep.alpha(), 0.5, 1e-9);
+    EXPECT_FALSE(timestep.isBehind());
+
+    // Time past the most steps of a frame is dropped rather than carried forward
+    steps = 0;
+    timestep.advance(100.0);
+    while (timestep.step()) steps++;
+    timestep.endFrame();
+    EXPECT_EQ(steps, 5);
+    EXPECT_TRUE(timestep.isBehind());
+    EXPECT_EQ(timestep.dropped(), 5u);
+    EXPECT_EQ(timestep.droppedFrames(), 1u);
+    EXPECT_NEAR(timestep.alpha(), 0.5, 1e-9);
+    EXPECT_LT(timestep.accumulator(), timestep.interval());
+
+    // Once steps are measured slower than the interval, only one runs per frame, so frames do not grow
+    timestep.reset();
+    timestep.setInterval(1.0);
+    for (int frame = 0; frame < 4; frame++) {
+        timestep.advance(5.0);
+        while (timestep.step()) std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        timestep.endFrame();
+    }
+    EXPECT_GT(timestep.stepCost(), 1.0);
+    EXPECT_EQ(timestep.stepLimit(), 1);
+    EXPECT_EQ(timestep.steps(), 8u);
+    EXPECT_EQ(timestep.droppedFrames(), 3u);
+    std::cout << timestep.summary() << std::endl;
+}
+
+TEST(TickTest, InterpolationTest) {
+    using namespace seedengine;
+
+    Actor actor(Transform(glm::vec3(2.0f, 0.0f, 0.0f)));
+    actor.addComponent<MoverComponent>();
+    EXPECT_EQ(actor.transform().getPosition().x, 2.0f);
+    EXPECT_EQ(actor.previousTransform().getPosition().x, 2.0f);
+
+    TickScheduler scheduler;
+    scheduler.add(actor);
+    scheduler.tick();
+    EXPECT_EQ(actor.previousTransform().getPosition().x, 2.0f);
+    EXPECT_EQ(actor.transform().getPosition().x, 3.0f);
+    EXPECT_FLOAT_EQ(actor.interpolatedTransform(0.25f).getPosition().x, 2.25f);
+
+    // Snapshots place submitted transforms by the alpha of the frame
+    RenderSnapshot snapshot;
+    snapshot.setAlpha(0.5f);
+    snapshot.submit(nullptr, actor.previousTransform(), actor.transform());
+    EXPECT_FLOAT_EQ(snapshot.draws()[0].model[3][0], 2.5f);
+    snapshot.clear();
+    EXPECT_EQ(snapshot.alpha(), 1.0f);
+
+    // Rotations blend along the shortest arc
+    glm::vec3 up(0.0f, 1.0f, 0.0f);
+    Transform from(glm::vec3(0.0f), glm::angleAxis(0.0f, up));
+    Transform to(glm::vec3(0.0f), glm::angleAxis(glm::half_pi<float>(), up));
+    glm::quat half = Transform::interpolate(from, to, 0.5f).getRotation();
+    EXPECT_NEAR(std::abs(glm::dot(half, glm::angleAxis(glm::quarter_pi<float>(), up))), 1.0f, 1e-5f);
+
+    scheduler.remove(actor);
+}
@@ -7,4 +7,34 @@
 TEST(TimeTest, GeneralTest) {
     using namespace seedengine;
     
-}
\ No newline at end of file
+}
+
+TEST(TimeTest, ClockTest) {
+    using namespace seedengine;
+
+    // The clock never goes backwards
+    int64_t last = Time::nowNS();
+    for (int i = 0; i < 100000; i++) {
+        int64_t now = Time::nowNS();
+        ASSERT_GE(now, last);
+        last = now;
+    }
+
+    // Intervals well under a millisecond are measured, not rounded away
+    int64_t start = Time::nowNS();
+    int64_t start_us = Time::nowUS();
+    double start_s = Time::elapsedSeconds();
+    std::this_thread::sleep_for(std::chrono::microseconds(300));
+    int64_t ns = Time::nowNS() - start;
+    int64_t us = Time::nowUS() - start_us;
+    double s = Time::elapsedSeconds() - start_s;
+    EXPECT_GE(ns, 300000);
+    EXPECT_GE(us, 300);
+    EXPECT_GE(s, 0.0003);
+    EXPECT_NE(ns % 1000000, 0);
+    std::cout << "Slept 300 us, measured " << ns << " ns." << std::endl;
+
+    int64_t ms = Time::elapsedTimeMS().count();
+    EXPECT_LE(ms, Time::nowNS() / 1000000);
+    EXPECT_GE(ms + 1, Time::nowNS() / 1000000);
+}
@@ -0,0 +1,179 @@
+// test_timer.cpp
+
+#include <iostream>
+#include <thread>
+#include <gtest/gtest.h>
+#include "Timer.hpp"
+#include "Event.hpp"
+#include "Object.hpp"
+
+namespace {
+
+    using namespace seedengine;
+
+    /** An object that counts its destruction. */
+    class CountedObject : public Object {
+    public:
+        explicit CountedObject(int* destroyed) : Object("Counted"), destroyed_(destroyed) {}
+        ~CountedObject() { (*destroyed_)++; }
+    private:
+        int* destroyed_;
+    };
+
+}
+
+TEST(TimerTest, WheelTest) {
+    using namespace seedengine;
+
+    TimerWheel wheel;
+    std::vector<int> fired;
+    std::vector<uint64_t> ticks;
+    auto at = [&](int tag) {
+        return [&fired, &ticks, &wheel, tag]() {
+            fired.push_back(tag);
+            ticks.push_back(wheel.now());
+        };
+    };
+
+    // Delays that span several levels expire on their exact tick, in order of deadline
+    wheel.schedule(5000, at(4));
+    wheel.schedule(70, at(2));
+    wheel.schedule(3, at(1));
+    wheel.schedule(300000, at(5));
+    wheel.schedule(70, at(3));
+    TimerId cancelled = wheel.schedule(100, at(0));
+    EXPECT_EQ(wheel.pending(), 6u);
+    EXPECT_TRUE(wheel.cancel(cancelled));
+    EXPECT_FALSE(wheel.cancel(cancelled));
+    EXPECT_FALSE(wheel.active(cancelled));
+
+    EXPECT_EQ(wheel.advance(2), 0u);
+    EXPECT_EQ(wheel.advance(1), 1u);
+    EXPECT_EQ(wheel.advance(4996), 2u);
+    EXPECT_EQ(wheel.advance(1), 1u);
+    EXPECT_EQ(wheel.advance(1000000), 1u);
+    ASSERT_EQ(fired.size(), 5u);
+    EXPECT_EQ(fired, std::vector<int>({ 1, 2, 3, 4, 5 }));
+    EXPECT_EQ(ticks, std::vector<uint64_t>({ 3, 70, 70, 5000, 300000 }));
+    EXPECT_EQ(wheel.pending(), 0u);
+
+    // Freed nodes are reused without old handles matching them
+    TimerId reused = wheel.schedule(1, at(6));
+    EXPECT_NE(reused, cancelled);
+    EXPECT_FALSE(wheel.cancel(cancelled));
+    EXPECT_TRUE(wheel.active(reused));
+
+    // Timers scheduled while expiring wait for a later tick
+    int chain = 0;
+    std::function<void()> repeat = [&]() {
+        chain++;
+        if (chain < 10) wheel.schedule(0, repeat);
+    };
+    wheel.schedule(0, repeat);
+    wheel.advance(1);
+    EXPECT_EQ(chain, 1);
+    wheel.advance(100);
+    EXPECT_EQ(chain, 10);
+}
+
+TEST(TimerTest, EngineTimerTest) {
+    using namespace seedengine;
+
+    Timers::clear();
+    int seconds = 0;
+    int frames = 0;
+    Timers::after(0.5f, [&seconds]() { seconds++; });
+    TimerId frame = Timers::afterFrames(2, [&frames]() { frames++; });
+    TimerId cancelled = Timers::afterFrames(3, [&frames]() { frames += 100; });
+    EXPECT_TRUE(Timers::cancel(cancelled));
+
+    // Game time below a millisecond carries over to the next frame
+    for (int i = 0; i < 4; i++) Timers::advance(0.25f);
+    EXPECT_EQ(frames, 1);
+    EXPECT_FALSE(Timers::cancel(frame));
+    Timers::advance(498.0f);
+    EXPECT_EQ(seconds, 0);
+    Timers::advance(1.0f);
+    EXPECT_EQ(seconds, 1);
+
+    // Delayed pushes join the queue once they expire
+    EventDispatcher::run(0);
+    int pushed = 0;
+    EventSubscription subscription = EventDispatcher::subscribe(KeyboardEvent::EVENT_ID, [&pushed](Event& e) {
+        pushed += static_cast<KeyboardEvent&>(e).keycode();
+    });
+    EventDispatcher::pushAfter<KeyboardEvent>(0.1f, 7u, 0u, input::ButtonState::PRESSED, 0u);
+    EventDispatcher::pushAfterFrames<KeyboardEvent>(1, 5u, 0u, input::ButtonState::PRESSED, 0u);
+    EventDispatcher::run(0);
+    EXPECT_EQ(pushed, 0);
+    Timers::advance(16.0f);
+    EventDispatcher::run(0);
+    EXPECT_EQ(pushed, 5);
+    Timers::advance(100.0f);
+    EventDispatcher::run(0);
+    EXPECT_EQ(pushed, 12);
+
+    // Delayed destruction
+    int destroyed = 0;
+    EXPECT_EQ(Object::Destroy(new CountedObject(&destroyed)), 0u);
+    EXPECT_EQ(destroyed, 1);
+    Object::Destroy(new CountedObject(&destroyed), 1.0f);
+    TimerId kept = Object::Destroy(new CountedObject(&destroyed), 1.0f);
+    Timers::advance(999.0f);
+    EXPECT_EQ(destroyed, 1);
+    EXPECT_TRUE(Timers::cancel(kept));
+    Timers::advance(1.0f);
+    EXPECT_EQ(destroyed, 2);
+    EXPECT_EQ(Timers::pending(), 0u);
+
+    // Delayed destruction from another thread is scheduled once the events run
+    std::thread worker([&destroyed]() {
+        EXPECT_EQ(Object::Destroy(new CountedObject(&destroyed), 0.5f), 0u);
+    });
+    worker.join();
+    EXPECT_EQ(Timers::pending(), 0u);
+    EventDispatcher::run(0);
+    EXPECT_EQ(Timers::pending(), 1u);
+    Timers::advance(500.0f);
+    EXPECT_EQ(destroyed, 3);
+}
+
+TEST(TimerTest, WheelBenchmark) {
+    using namespace seedengine;
+
+    // Per-frame cost with few pending timers and with hundreds of thousands
+    const int frames = 600;
+    auto run = [frames](size_t count) {
+        TimerWheel wheel;
+        size_t expired = 0;
+        uint64_t seed = 12345;
+        for (size_t i = 0; i < count; i++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            // Delays from 1 ms to about 17 minutes
+            wheel.schedule(1 + (seed >> 44), [&expired]() { expired++; });
+        }
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int f = 0; f < frames; f++) wheel.advance(16);
+        auto end = std::chrono::high_resolution_clock::now();
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        return std::make_pair(ns / frames, expired);
+    };
+
+    std::pair<double, size_t> few = run(1000);
+    std::pair<double, size_t> many = run(200000);
+    std::cout << "1000 timers: " << few.first << " ns/frame, " << few.second << " expired" << std::endl;
+    std::cout << "200000 timers: " << many.first << " ns/frame, " << many.second << " expired" << std::endl;
+    std::cout << "Per expired timer: " << many.first * frames / std::max<size_t>(many.second, 1) << " ns" << std::endl;
+
+    // Scheduling and cancelling never scan the pending timers
+    TimerWheel wheel;
+    std::vector<TimerId> ids(200000);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < ids.size(); i++) ids[i] = wheel.schedule(1000 + i, []() {});
+    for (size_t i = 0; i < ids.size(); i++) wheel.cancel(ids[i]);
+    auto end = std::chrono::high_resolution_clock::now();
+    EXPECT_EQ(wheel.pending(), 0u);
+    std::cout << "Schedule and cancel: "
+        << std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / static_cast<double>(ids.size())
+        << " ns/timer" << std::endl;
+}
@@ -3,6 +3,7 @@
 import os
 import subprocess
 import re
+import struct
 import argparse
 
 print()
@@ -290,6 +291,122 @@ def fill_files(args):
 
                 test_file.close()
 
+def build_manifest(args):
+    # Asset type identifiers, matching seedengine::AssetType
+    asset_types = {
+        ".png": 1, ".jpg": 1, ".jpeg": 1, ".bmp": 1, ".tga": 1,
+        ".mesh": 2,
+        ".glsl": 3,
+        ".ini": 4,
+        ".tmp": 5
+    }
+    root = os.path.dirname(os.path.abspath(args.output))
+    print("Building asset manifest for " + root + "...")
+    entries = []
+    for subdir, dirs, files in os.walk(root):
+        for file in files:
+            path = os.path.join(subdir, file)
+            if os.path.abspath(path) == os.path.abspath(args.output):
+                continue
+            # 64 bit FNV-1a hash of the file contents
+            file_hash = 0xcbf29ce484222325
+            with open(path, "rb") as data:
+                for byte in bytearray(data.read()):
+                    file_hash ^= byte
+                    file_hash = (file_hash * 0x100000001b3) & 0xffffffffffffffff
+            asset_type = asset_types.get(os.path.splitext(file)[-1].lower(), 0)
+            relative = os.path.relpath(path, root).replace(os.sep, "/")
+            entries.append("%d %x %d %s" % (os.path.getsize(path), file_hash, asset_type, relative))
+    manifest = open(args.output, "w")
+    manifest.write("# Seed Engine asset manifest\n")
+    manifest.write("# <size> <fnv-1a hash> <type> <path>\n")
+    for entry in sorted(entries):
+        manifest.write(entry + "\n")
+    manifest.close()
+    print("Wrote " + str(len(entries)) + " assets to " + args.output)
+
+def parse_ini(path):
+    # Mirrors util::IniParser, returns a list of (section, key, type, value)
+    values = {}
+    section = None
+    with open(path, "r") as ini:
+        for line_num, line in enumerate(ini, 1):
+            # Remove comments outside of quotes
+            quote = None
+            end = len(line)
+            for i, c in enumerate(line):
+                if quote:
+                    if c == quote:
+                        quote = None
+                elif c in "\"'":
+                    quote = c
+                elif c in ";#":
+                    end = i
+                    break
+            line = line[:end].strip()
+            if not line:
+                continue
+            match = re.match(r"^\[\s*([a-zA-Z][\w.]*)\s*\]$", line)
+            if match:
+                section = match.group(1)
+                continue
+            match = re.match(r"^([a-zA-Z]\w*)\s*=\s*(.+)$", line)
+            if section is None or not match:
+                print("Error in ini file \"" + path + "\" at line " + str(line_num))
+                continue
+            key, value = match.group(1), match.group(2)
+            if len(value) >= 2 and value[0] in "\"'" and value[-1] == value[0]:
+                values[(section, key)] = (4, value[1:-1])
+            elif value in ("true", "True", "TRUE", "false", "False", "FALSE"):
+                values[(section, key)] = (3, value.lower() == "true")
+            elif re.match(r"^-?[0-9]+$", value):
+                values[(section, key)] = (1, int(value))
+            elif re.match(r"^-?[0-9]*\.[0-9]*$", value) and re.search(r"[0-9]", value):
+                values[(section, key)] = (2, float(value))
+            else:
+                print("Error in ini file \"" + path + "\" at line " + str(line_num))
+    return [(s, k, t, v) for (s, k), (t, v) in values.items()]
+
+def compile_config(args):
+    # Writes the binary format read by util::ConfigBlob
+    paths = args.files
+    if not paths:
+        paths = [os.path.join(subdir, file) for subdir, dirs, files in os.walk("core/data") for file in files if file.endswith(".ini")]
+    for path in paths:
+        entries = []
+        pool = bytearray()
+        for section, key, value_type, value in parse_ini(path):
+            names = section.encode("utf-8") + b"\0" + key.encode("utf-8")
+            # 64 bit FNV-1a hash of "section\0key"
+            name_hash = 0xcbf29ce484222325
+            for byte in bytearray(names):
+                name_hash ^= byte
+                name_hash = (name_hash * 0x100000001b3) & 0xffffffffffffffff
+            name_offset = len(pool)
+            pool += names + b"\0"
+            length = 0
+            if value_type == 1:
+                bits = struct.unpack("<I", struct.pack("<i", value))[0]
+            elif value_type == 2:
+                bits = struct.unpack("<I", struct.pack("<f", value))[0]
+            elif value_type == 3:
+                bits = 1 if value else 0
+            else:
+                data = value.encode("utf-8")
+                bits = len(pool)
+                length = len(data)
+                pool += data
+            entries.append(struct.pack("<QIIII", name_hash, name_offset, value_type, bits, length))
+        entries.sort(key=lambda entry: struct.unpack("<Q", entry[:8])[0])
+        output = path + ".bin"
+        blob = open(output, "wb")
+        blob.write(struct.pack("<IIII", 0x47464353, 1, len(entries), len(pool)))
+        for entry in entries:
+            blob.write(entry)
+        blob.write(pool)
+        blob.close()
+        print("Compiled " + str(len(entries)) + " values from " + path + " to " + output)
+
 argparser = argparse.ArgumentParser(description="Project CLI for file modification and housekeeping.")
 subparser = argparser.add_subparsers(help="The command to call")
 
@@ -316,5 +433,13 @@ build_parser.add_argument("-r", "--release", action="store_false", help="An opti
 fill_parser = subparser.add_parser("fill", description="Fills in empty files with template data.")
 fill_parser.set_defaults(func=fill_files)
 
+manifest_parser = subparser.add_parser("manifest", description="Generates the asset manifest used to skip filesystem probing at startup.")
+manifest_parser.set_defaults(func=build_manifest)
+manifest_parser.add_argument("-o", "--output", type=str, default="core/data/assets.manifest", help="the manifest file to write, indexing the folder containing it")
+
+config_parser = subparser.add_parser("config", description="Compiles .ini files into binary blobs that are loaded without parsing.")
+config_parser.set_defaults(func=compile_config)
+config_parser.add_argument("files", metavar="F", type=str, nargs="*", help="the .ini files to compile, defaults to all .ini files in core/data")
+
 args = argparser.parse_args()
 args.func(args)
\ No newline at end of file